@@ -0,0 +1,201 @@
+// --- Бенчмарк назначения огневых каналов ---
+// Цели летят к базе в (0,0) со всех сторон; вокруг базы стоят радары с огневыми каналами. Каждый цикл
+// (шаг 10 мс, как у TrackBench) цели сдвигаются, выигрыши пар (цель, радар) считаются так же, как
+// в SimulationState::assignEngagements(), и AuctionSolver решает назначение дважды: с теплым стартом
+// от прошлого цикла и с нуля. Дошедшая до базы цель заменяется новой (новый ID) на дальнем кольце.
+// Печатает время решения (среднее и наибольшее), ставки на решение и отклонение суммы выигрышей
+// от точного оптимума (венгерский алгоритм, каждый CHECK_EVERY-й цикл) - оно не должно превышать
+// число целей * epsilon.
+//
+// Использование: AssignBench [целей] [радаров] [каналов у радара] [циклов] [epsilon]
+#include "AuctionSolver.h"
+#include "Radar.h"
+#include "Point.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <vector>
+
+static const int CHECK_EVERY = 50;
+
+// Точный оптимум: венгерский алгоритм (минимум стоимости) на матрице целей x (каналы + "без канала").
+// Стоимость - минус выигрыш, недопустимая пара - запретно дорогая; столбцов "без канала" по одному на цель.
+static double exactOptimum(const std::vector<float>& benefit, size_t persons, const std::vector<int>& objectGroup, size_t groups) {
+    const size_t n = persons;
+    const size_t m = objectGroup.size() + persons;
+    const double FORBIDDEN = 1.0e9;
+    auto cost = [&](size_t i, size_t j) -> double {
+        if (j >= objectGroup.size()) return 0.0;
+        float b = benefit[i * groups + objectGroup[j]];
+        return b < 0.0f ? FORBIDDEN : -static_cast<double>(b);
+    };
+    // Потенциалы u (строки), v (столбцы); p[j] - строка столбца j (1..n, 0 - свободен), индексация с 1.
+    std::vector<double> u(n + 1, 0.0), v(m + 1, 0.0), minv(m + 1);
+    std::vector<size_t> p(m + 1, 0), way(m + 1, 0);
+    std::vector<char> used(m + 1);
+    for (size_t i = 1; i <= n; ++i) {
+        p[0] = i;
+        size_t j0 = 0;
+        std::fill(minv.begin(), minv.end(), std::numeric_limits<double>::infinity());
+        std::fill(used.begin(), used.end(), 0);
+        do {
+            used[j0] = 1;
+            size_t i0 = p[j0], j1 = 0;
+            double delta = std::numeric_limits<double>::infinity();
+            for (size_t j = 1; j <= m; ++j) {
+                if (used[j]) continue;
+                double cur = cost(i0 - 1, j - 1) - u[i0] - v[j];
+                if (cur < minv[j]) { minv[j] = cur; way[j] = j0; }
+                if (minv[j] < delta) { delta = minv[j]; j1 = j; }
+            }
+            for (size_t j = 0; j <= m; ++j) {
+                if (used[j]) { u[p[j]] += delta; v[j] -= delta; }
+                else minv[j] -= delta;
+            }
+            j0 = j1;
+        } while (p[j0] != 0);
+        do {
+            size_t j1 = way[j0];
+            p[j0] = p[j1];
+            j0 = j1;
+        } while (j0);
+    }
+    double total = 0.0;
+    for (size_t j = 1; j <= objectGroup.size(); ++j) {
+        if (p[j] != 0) total -= cost(p[j] - 1, j - 1);
+    }
+    return total;
+}
+
+struct SolverRun {
+    AuctionSolver solver;
+    double totalNs = 0.0;
+    double maxNs = 0.0;
+    int over1ms = 0;  // Решений дольше 1 мс (бюджет одного тика)
+};
+
+static double solveTimed(SolverRun& run, const std::vector<int>& ids, const std::vector<float>& benefit, float epsilon) {
+    auto t0 = std::chrono::steady_clock::now();
+    run.solver.solve(ids.data(), ids.size(), benefit.data(), epsilon);
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+    run.totalNs += ns;
+    run.maxNs = std::max(run.maxNs, ns);
+    if (ns > 1.0e6) ++run.over1ms;
+    return ns;
+}
+
+static double objectiveOf(const AuctionSolver& solver, const std::vector<float>& benefit, size_t persons, size_t groups) {
+    double total = 0.0;
+    for (size_t i = 0; i < persons; ++i) {
+        int g = solver.assignedGroup(i);
+        if (g >= 0) total += benefit[i * groups + static_cast<size_t>(g)];
+    }
+    return total;
+}
+
+int main(int argc, char* argv[]) {
+    size_t threats = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 300;
+    size_t radars = argc > 2 ? static_cast<size_t>(std::atol(argv[2])) : 4;
+    int channels = argc > 3 ? std::atoi(argv[3]) : 8;
+    int cycles = argc > 4 ? std::atoi(argv[4]) : 1000;
+    float epsilon = argc > 5 ? static_cast<float>(std::atof(argv[5])) : 1.0e-3f;
+    if (threats == 0 || radars == 0 || channels <= 0 || cycles <= 0 || !(epsilon > 0.0f)) {
+        std::fprintf(stderr, "usage: AssignBench [threats] [radars] [channels per radar] [cycles] [epsilon]\n");
+        return 2;
+    }
+
+    const float dt = 0.01f;
+    const float engagementRadius = 150.0f;
+    const float siteRing = 200.0f;                  // Радары - на кольце вокруг базы
+    const float minStart = 300.0f, maxStart = 900.0f;
+    const float maxSpeed = 80.0f;
+    const float horizon = 1.0f + maxStart / 20.0f;  // Наибольшее время полета до базы (как в SimulationState)
+    std::vector<Point> sites(radars);
+    for (size_t s = 0; s < radars; ++s) {
+        float a = 2.0f * M_PI_F * static_cast<float>(s) / static_cast<float>(radars);
+        sites[s] = { siteRing * std::cos(a), siteRing * std::sin(a) };
+    }
+
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * M_PI_F);
+    std::uniform_real_distribution<float> radiusDist(minStart, maxStart);
+    std::uniform_real_distribution<float> speedDist(20.0f, maxSpeed);
+    std::vector<int> ids(threats);
+    std::vector<Point> pos(threats), vel(threats);
+    int nextId = 0;
+    auto spawn = [&](size_t i) {
+        float a = angleDist(rng), r = radiusDist(rng), v = speedDist(rng);
+        ids[i] = nextId++;
+        pos[i] = { r * std::cos(a), r * std::sin(a) };
+        vel[i] = { -v * std::cos(a), -v * std::sin(a) };
+    };
+    for (size_t i = 0; i < threats; ++i) spawn(i);
+
+    std::vector<int> channelsPerGroup(radars, channels);
+    SolverRun warm, cold;
+    warm.solver.configure(channelsPerGroup);
+    cold.solver.configure(channelsPerGroup);
+    cold.solver.setWarmStart(false);
+    std::vector<int> objectGroup;
+    for (size_t s = 0; s < radars; ++s) objectGroup.insert(objectGroup.end(), static_cast<size_t>(channels), static_cast<int>(s));
+
+    std::vector<float> benefit(threats * radars);
+    double worstGapWarm = 0.0, worstGapCold = 0.0;
+    int checks = 0, failed = 0;
+    uint64_t assignedTotal = 0;
+
+    for (int cycle = 0; cycle < cycles; ++cycle) {
+        // Движение; дошедшие до базы цели заменяются новыми в конце (ID по возрастанию сохраняется).
+        size_t w = 0;
+        size_t arrived = 0;
+        for (size_t i = 0; i < threats; ++i) {
+            pos[i] = pos[i] + vel[i] * dt;
+            if (pos[i].length() <= 20.0f) { ++arrived; continue; }
+            ids[w] = ids[i];
+            pos[w] = pos[i];
+            vel[w] = vel[i];
+            ++w;
+        }
+        for (size_t i = w; i < threats; ++i) spawn(i);
+
+        for (size_t i = 0; i < threats; ++i) {
+            float urgency = horizon - pos[i].length() / maxSpeed;
+            for (size_t s = 0; s < radars; ++s) {
+                Point relative = pos[i] - sites[s];
+                float t = Radar::timeToEngage(relative.x, relative.y, vel[i].x, vel[i].y, engagementRadius);
+                benefit[i * radars + s] = t < std::numeric_limits<float>::infinity() ? std::max(urgency - t, 0.0f) : -1.0f;
+            }
+        }
+
+        solveTimed(warm, ids, benefit, epsilon);
+        solveTimed(cold, ids, benefit, epsilon);
+        for (size_t i = 0; i < threats; ++i) assignedTotal += warm.solver.assignedGroup(i) >= 0 ? 1 : 0;
+
+        if (cycle % CHECK_EVERY == 0) {
+            double exact = exactOptimum(benefit, threats, objectGroup, radars);
+            double gapWarm = exact - objectiveOf(warm.solver, benefit, threats, radars);
+            double gapCold = exact - objectiveOf(cold.solver, benefit, threats, radars);
+            worstGapWarm = std::max(worstGapWarm, gapWarm);
+            worstGapCold = std::max(worstGapCold, gapCold);
+            const double bound = threats * static_cast<double>(epsilon) + 1.0e-3 * exact; // Плюс округление float
+            if (gapWarm > bound || gapCold > bound) ++failed;
+            ++checks;
+        }
+    }
+
+    const AuctionStats& ws = warm.solver.stats();
+    const AuctionStats& cs = cold.solver.stats();
+    std::printf("threats=%zu radars=%zu channels_per_radar=%d cycles=%d epsilon=%g\n", threats, radars, channels, cycles, epsilon);
+    std::printf("assigned_per_cycle=%.1f\n", static_cast<double>(assignedTotal) / cycles);
+    std::printf("warm  us_mean=%.2f us_max=%.2f over_1ms=%d bids_per_solve=%.1f kept_per_solve=%.1f\n", warm.totalNs * 1e-3 / cycles,
+                warm.maxNs * 1e-3, warm.over1ms, static_cast<double>(ws.bids) / cycles, static_cast<double>(ws.kept) / cycles);
+    std::printf("cold  us_mean=%.2f us_max=%.2f over_1ms=%d bids_per_solve=%.1f\n", cold.totalNs * 1e-3 / cycles,
+                cold.maxNs * 1e-3, cold.over1ms, static_cast<double>(cs.bids) / cycles);
+    std::printf("exact_checks=%d gap_warm_max=%.4f gap_cold_max=%.4f gap_bound=%.4f failed=%d\n", checks, worstGapWarm,
+                worstGapCold, threats * static_cast<double>(epsilon), failed);
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,269 @@
+#include "AuctionSolver.h" // Включаем заголовок аукционного решателя
+#include <algorithm>
+#include <limits>
+
+AuctionSolver::AuctionSolver() :
+    m_groups(0),
+    m_warmStart(true)
+{
+}
+
+void AuctionSolver::configure(const std::vector<int>& channelsPerGroup) {
+    m_groups = channelsPerGroup.size();
+    m_objectGroup.clear();
+    m_groupBegin.assign(1, 0);
+    for (size_t g = 0; g < channelsPerGroup.size(); ++g) {
+        for (int c = 0; c < channelsPerGroup[g]; ++c) m_objectGroup.push_back(static_cast<int>(g));
+        m_groupBegin.push_back(m_objectGroup.size());
+    }
+    m_price.assign(m_objectGroup.size(), 0.0f);
+    m_owner.assign(m_objectGroup.size(), -1);
+    m_ownerId.assign(m_objectGroup.size(), -1);
+    m_heap.resize(m_objectGroup.size());
+    for (size_t j = 0; j < m_heap.size(); ++j) m_heap[j] = j;
+    m_cheapest.assign(m_groups, 0);
+    m_secondPrice.assign(m_groups, 0.0f);
+    for (size_t g = 0; g < m_groups; ++g) refreshGroup(g);
+    m_stats = AuctionStats();
+}
+
+void AuctionSolver::forgetSolution() {
+    std::fill(m_price.begin(), m_price.end(), 0.0f);
+    std::fill(m_ownerId.begin(), m_ownerId.end(), -1);
+    for (size_t g = 0; g < m_groups; ++g) refreshGroup(g);
+}
+
+// Порядок кучи каналов: дешевле - выше, при равной цене - меньший индекс (детерминированно).
+struct CheaperObject {
+    const float* price;
+    bool operator()(size_t a, size_t b) const { return price[a] > price[b] || (price[a] == price[b] && a > b); }
+};
+
+// Куча группы заново (цены менялись произвольно) и ее два дешевых канала.
+void AuctionSolver::refreshGroup(size_t g) {
+    auto first = m_heap.begin() + m_groupBegin[g];
+    auto last = m_heap.begin() + m_groupBegin[g + 1];
+    std::make_heap(first, last, CheaperObject{ m_price.data() });
+    updateCheapest(g);
+}
+
+void AuctionSolver::updateCheapest(size_t g) {
+    const size_t begin = m_groupBegin[g], count = m_groupBegin[g + 1] - begin;
+    if (count == 0) return;
+    m_cheapest[g] = m_heap[begin];
+    // Второй по дешевизне - один из двух потомков корня.
+    float second = std::numeric_limits<float>::infinity();
+    if (count > 1) second = m_price[m_heap[begin + 1]];
+    if (count > 2) second = std::min(second, m_price[m_heap[begin + 2]]);
+    m_secondPrice[g] = second;
+}
+
+// Прямая ставка всегда поднимает самый дешевый канал группы: корень кучи уходит вниз за O(log каналов).
+void AuctionSolver::raiseCheapest(size_t g, float price) {
+    auto first = m_heap.begin() + m_groupBegin[g];
+    auto last = m_heap.begin() + m_groupBegin[g + 1];
+    std::pop_heap(first, last, CheaperObject{ m_price.data() });
+    m_price[*(last - 1)] = price;
+    std::push_heap(first, last, CheaperObject{ m_price.data() });
+    updateCheapest(g);
+}
+
+bool AuctionSolver::bestObjects(size_t i, const float* benefit, size_t& best, float& bestProfit, float& secondProfit) const {
+    const float* row = benefit + i * m_groups;
+    bool found = false;
+    bestProfit = 0.0f;
+    secondProfit = 0.0f; // Фиктивный объект: остаться без канала
+    for (size_t g = 0; g < m_groups; ++g) {
+        float b = row[g];
+        if (b < 0.0f || m_groupBegin[g] == m_groupBegin[g + 1]) continue;
+        float profit = b - m_price[m_cheapest[g]];
+        float profit2 = b - m_secondPrice[g]; // Минус бесконечность, если канал в группе один
+        if (!found || profit > bestProfit) {
+            secondProfit = std::max(secondProfit, found ? std::max(bestProfit, profit2) : profit2);
+            best = m_cheapest[g];
+            bestProfit = profit;
+            found = true;
+        }
+        else {
+            secondProfit = std::max(secondProfit, profit);
+        }
+    }
+    return found;
+}
+
+
+// Выигрыш цели i на ее канале (0 - без канала).
+float AuctionSolver::profitOf(size_t i, const float* benefit) const {
+    int j = m_assigned[i];
+    return j < 0 ? 0.0f : benefit[i * m_groups + m_objectGroup[j]] - m_price[j];
+}
+
+// --- Фаза аукциона: роспуск пар без epsilon-дополнения и прямые торги ---
+size_t AuctionSolver::auctionPhase(size_t persons, const float* benefit, float epsilon) {
+    const size_t objects = m_objectGroup.size();
+    // Пары без epsilon-дополнения распускаем; канал остается свободным со своей ценой.
+    for (size_t j = 0; j < objects; ++j) {
+        if (m_owner[j] < 0) continue;
+        size_t i = static_cast<size_t>(m_owner[j]);
+        size_t best = j;
+        float bestProfit, secondProfit;
+        bestObjects(i, benefit, best, bestProfit, secondProfit);
+        if (profitOf(i, benefit) < std::max(bestProfit, 0.0f) - epsilon) {
+            m_owner[j] = -1;
+            m_assigned[i] = -1;
+        }
+    }
+
+    size_t kept = 0;
+    m_queue.clear();
+    for (size_t i = 0; i < persons; ++i) {
+        if (m_assigned[i] < 0) m_queue.push_back(static_cast<uint32_t>(i));
+        else ++kept;
+    }
+
+    // Прямые торги: очередь свободных целей, вытесненная цель встает в конец.
+    for (size_t head = 0; head < m_queue.size(); ++head) {
+        size_t i = m_queue[head];
+        size_t best = 0;
+        float bestProfit, secondProfit;
+        if (!bestObjects(i, benefit, best, bestProfit, secondProfit) || bestProfit <= 0.0f) continue; // Лучше без канала
+        raiseCheapest(static_cast<size_t>(m_objectGroup[best]), m_price[best] + bestProfit - secondProfit + epsilon);
+        int previous = m_owner[best];
+        if (previous >= 0) {
+            m_assigned[previous] = -1;
+            m_queue.push_back(static_cast<uint32_t>(previous));
+        }
+        m_owner[best] = static_cast<int>(i);
+        m_assigned[i] = static_cast<int>(best);
+        ++m_stats.bids;
+    }
+
+    return kept;
+}
+
+
+// --- Обратные торги по группам ---
+// Группа со свободным каналом с ненулевой ценой (распущенная пара, ставки грубых фаз) выбирает цели сама:
+// каналы группы одинаковы, поэтому торгуется вся группа сразу с одной ценой q. Чужие цели (без канала или
+// на канале другой группы) ранжируются по "выигрыш минус текущая прибыль" v; свободные каналы берут лучшие
+// из них с v >= epsilon, а q - следующая после взятых v минус epsilon (не ниже 0; если брать больше
+// некого - 0). Все каналы группы получают q: цены не выше q - epsilon-дополнение чужих целей соблюдено,
+// своим целям прибыль только растет. Взятая цель выигрывает не меньше epsilon, поэтому торги конечны;
+// освобожденные ею каналы других групп ставят свою группу в очередь. В конце у свободных каналов цена 0.
+void AuctionSolver::reverseAuction(size_t persons, const float* benefit, float epsilon) {
+    m_groupQueued.assign(m_groups, 0);
+    m_queue.clear();
+    for (size_t j = 0; j < m_objectGroup.size(); ++j) {
+        size_t g = static_cast<size_t>(m_objectGroup[j]);
+        if (m_owner[j] < 0 && m_price[j] > 0.0f && !m_groupQueued[g]) {
+            m_groupQueued[g] = 1;
+            m_queue.push_back(static_cast<uint32_t>(g));
+        }
+    }
+    // Лучшие первыми; при равенстве - меньший индекс цели (детерминированно).
+    auto better = [](const std::pair<float, uint32_t>& a, const std::pair<float, uint32_t>& b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    };
+    for (size_t head = 0; head < m_queue.size(); ++head) {
+        const size_t g = m_queue[head];
+        m_groupQueued[g] = 0;
+        m_freeObjects.clear();
+        bool priced = false;
+        for (size_t j = m_groupBegin[g]; j < m_groupBegin[g + 1]; ++j) {
+            if (m_owner[j] >= 0) continue;
+            m_freeObjects.push_back(j);
+            priced = priced || m_price[j] > 0.0f;
+        }
+        if (!priced) continue; // Каналы уже перепроданы или цена снята
+
+        m_candidates.clear();
+        for (size_t i = 0; i < persons; ++i) {
+            float b = benefit[i * m_groups + g];
+            int j = m_assigned[i];
+            if (b < 0.0f || (j >= 0 && static_cast<size_t>(m_objectGroup[j]) == g)) continue;
+            float value = b - profitOf(i, benefit);
+            if (value >= epsilon) m_candidates.push_back({ value, static_cast<uint32_t>(i) });
+        }
+        size_t take = std::min(m_freeObjects.size(), m_candidates.size());
+        float price = 0.0f;
+        if (m_candidates.size() > take) {
+            std::nth_element(m_candidates.begin(), m_candidates.begin() + take, m_candidates.end(), better);
+            price = std::max(0.0f, m_candidates[take].first - epsilon);
+        }
+        // Взятые цели - по возрастанию индекса на каналы группы по порядку.
+        std::sort(m_candidates.begin(), m_candidates.begin() + take,
+                  [](const std::pair<float, uint32_t>& a, const std::pair<float, uint32_t>& b) { return a.second < b.second; });
+        for (size_t j = m_groupBegin[g]; j < m_groupBegin[g + 1]; ++j) m_price[j] = std::min(m_price[j], price);
+        for (size_t t = 0; t < m_freeObjects.size(); ++t) {
+            size_t j = m_freeObjects[t];
+            if (t >= take) { // Брать больше некого - цена уже 0
+                m_price[j] = 0.0f;
+                continue;
+            }
+            m_price[j] = price;
+            size_t i = m_candidates[t].second;
+            int previous = m_assigned[i];
+            if (previous >= 0) {
+                m_owner[previous] = -1;
+                size_t pg = static_cast<size_t>(m_objectGroup[previous]);
+                if (m_price[previous] > 0.0f && !m_groupQueued[pg]) {
+                    m_groupQueued[pg] = 1;
+                    m_queue.push_back(static_cast<uint32_t>(pg));
+                }
+            }
+            m_owner[j] = static_cast<int>(i);
+            m_assigned[i] = static_cast<int>(j);
+            ++m_stats.bids;
+        }
+        refreshGroup(g);
+    }
+}
+
+
+// --- Решение ---
+size_t AuctionSolver::solve(const int* personIds, size_t persons, const float* benefit, float epsilon) {
+    const size_t objects = m_objectGroup.size();
+    m_assigned.assign(persons, -1);
+    std::fill(m_owner.begin(), m_owner.end(), -1);
+    ++m_stats.solves;
+
+    // Теплый старт: прежние пары, если цель жива и пара допустима; остальные каналы свободны со своими ценами.
+    if (!m_warmStart) forgetSolution();
+    size_t warmPairs = 0;
+    for (size_t j = 0; j < objects; ++j) {
+        int id = m_warmStart ? m_ownerId[j] : -1;
+        const int* it = id < 0 ? personIds + persons : std::lower_bound(personIds, personIds + persons, id);
+        if (it != personIds + persons && *it == id) {
+            size_t i = static_cast<size_t>(it - personIds);
+            if (benefit[i * m_groups + m_objectGroup[j]] >= 0.0f && m_assigned[i] < 0) {
+                m_owner[j] = static_cast<int>(i);
+                m_assigned[i] = static_cast<int>(j);
+                ++warmPairs;
+            }
+        }
+    }
+
+    // Масштабирование epsilon: от четверти наибольшего выигрыша до заданного. Цены теплого старта уже близки
+    // к равновесию - грубые фазы только сбили бы их, поэтому начинаем с WARM_PHASES последних фаз.
+    float top = 0.0f;
+    for (size_t k = 0; k < persons * m_groups; ++k) top = std::max(top, benefit[k]);
+    float phaseEpsilon = std::max(epsilon, top * 0.25f);
+    if (warmPairs > 0) {
+        float warmEpsilon = epsilon;
+        for (int k = 1; k < WARM_PHASES; ++k) warmEpsilon *= EPSILON_SCALE;
+        phaseEpsilon = std::min(phaseEpsilon, warmEpsilon);
+    }
+    m_stats.kept += auctionPhase(persons, benefit, phaseEpsilon);
+    while (phaseEpsilon > epsilon) {
+        phaseEpsilon = std::max(epsilon, phaseEpsilon / EPSILON_SCALE);
+        auctionPhase(persons, benefit, phaseEpsilon);
+    }
+    reverseAuction(persons, benefit, epsilon); // Один раз: промежуточные цены свободных каналов не важны
+
+    size_t assigned = 0;
+    for (size_t j = 0; j < objects; ++j) {
+        m_ownerId[j] = m_owner[j] >= 0 ? personIds[m_owner[j]] : -1;
+        if (m_owner[j] >= 0) ++assigned;
+    }
+    return assigned;
+}
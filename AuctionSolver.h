@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// --- Назначение огневых каналов целям: аукцион (Бертсекас) с теплым стартом ---
+// Персоны - цели (ID ракет по возрастанию), объекты - огневые каналы; каждый канал принадлежит группе
+// (радару), и выигрыш пары зависит только от группы: benefit[i * groups + g], отрицательный - пара
+// недопустима. Каждая цель получает не больше одного канала, каждый канал - не больше одной цели;
+// цель может остаться без канала (фиктивный объект с нулевым выигрышем). Ищется назначение с
+// максимальной суммой выигрышей с точностью до persons * epsilon.
+//
+// Аукцион Гаусса-Зейделя: свободная цель предлагает цену за лучший для себя канал (выигрыш минус цена)
+// с надбавкой "лучший - второй + epsilon" и вытесняет прежнего владельца; цены только растут.
+// Порядок торгов - по возрастанию ID, поэтому результат детерминирован.
+//
+// Каналы одного радара одинаковы, и при целях больше, чем каналов, цены растут ступенями по epsilon, пока
+// лишние цели не выйдут из торгов. Поэтому epsilon масштабируется: первая фаза - с грубым шагом (четверть
+// наибольшего выигрыша), каждая следующая - в EPSILON_SCALE раз мельче, до заданного; фаза начинает с цен
+// и пар предыдущей. Каналов может быть больше, чем целей: свободный канал должен остаться с нулевой ценой,
+// поэтому после последней фазы группы со свободными каналами с ценой торгуются в обратную сторону (сами
+// выбирают цели, одной ценой на группу - см. reverseAuction()).
+//
+// Теплый старт: цены и владельцы каналов сохраняются между вызовами solve(). Прежняя пара (по ID цели)
+// остается, если цель еще есть, пара допустима и выполнено epsilon-дополнение (канал не хуже лучшего
+// другого больше чем на epsilon); освободившиеся каналы сохраняют цену до обратных торгов. Соседние циклы
+// решения почти одинаковы, поэтому торги идут только за изменившиеся цели и их вытесненных соседей,
+// и масштабирование начинается не с грубого шага, а за WARM_PHASES фаз до заданного epsilon.
+struct AuctionStats {
+    uint64_t solves = 0;
+    uint64_t bids = 0;      // Ставок за все решения
+    uint64_t kept = 0;      // Пар, перенесенных теплым стартом
+};
+
+class AuctionSolver {
+private:
+    std::vector<int> m_objectGroup;   // Группа каждого канала (каналы группы идут подряд)
+    std::vector<size_t> m_groupBegin; // Первый канал группы g; m_groupBegin[groups] - число каналов
+    std::vector<float> m_price;
+    // Самый дешевый канал группы и цена второго по дешевизне (бесконечность, если канал один): каналы
+    // группы одинаковы, поэтому лучший и второй выбор цели - среди этих двух у каждой группы.
+    // Их дает куча каналов группы по цене (m_heap[m_groupBegin[g] .. m_groupBegin[g + 1]), корень - дешевый).
+    std::vector<size_t> m_heap;
+    std::vector<size_t> m_cheapest;
+    std::vector<float> m_secondPrice;
+    std::vector<int> m_owner;         // Индекс цели текущего решения или -1
+    std::vector<int> m_ownerId;       // ID цели-владельца (для теплого старта следующего решения)
+    std::vector<int> m_assigned;      // Канал каждой цели или -1
+    std::vector<uint32_t> m_queue;    // Свободные цели, ожидающие ставки (в обратных торгах - группы)
+    std::vector<char> m_groupQueued;  // Обратные торги: группа уже в очереди
+    std::vector<size_t> m_freeObjects;                     // Обратные торги: свободные каналы группы
+    std::vector<std::pair<float, uint32_t>> m_candidates;  // Обратные торги: (выигрыш минус прибыль, цель)
+    size_t m_groups;
+    bool m_warmStart;
+    AuctionStats m_stats;
+
+    // Лучший и второй по выигрышу каналы цели i (второй - не меньше фиктивного 0), за O(групп).
+    bool bestObjects(size_t i, const float* benefit, size_t& best, float& bestProfit, float& secondProfit) const;
+    float profitOf(size_t i, const float* benefit) const;
+    void raiseCheapest(size_t g, float price); // Новая цена самого дешевого канала группы
+    void refreshGroup(size_t g);               // Куча группы после произвольной смены цен
+    void updateCheapest(size_t g);
+    // Одна фаза: роспуск пар без epsilon-дополнения и прямые торги свободных целей. Возвращает число пар,
+    // переживших роспуск.
+    size_t auctionPhase(size_t persons, const float* benefit, float epsilon);
+    // После последней фазы: группы со свободными каналами с ненулевой ценой торгуют в обратную сторону.
+    void reverseAuction(size_t persons, const float* benefit, float epsilon);
+
+public:
+    enum { EPSILON_SCALE = 8, WARM_PHASES = 3 };
+
+    AuctionSolver();
+
+    // Каналы по группам: channelsPerGroup[g] каналов группы g. Сбрасывает теплый старт.
+    void configure(const std::vector<int>& channelsPerGroup);
+    void setWarmStart(bool enabled) { m_warmStart = enabled; }
+    void forgetSolution(); // Следующее решение - с нуля
+
+    // Решение для persons целей с ID personIds (по возрастанию). Возвращает число назначенных целей.
+    size_t solve(const int* personIds, size_t persons, const float* benefit, float epsilon);
+
+    size_t objectCount() const { return m_objectGroup.size(); }
+    int assignedObject(size_t person) const { return m_assigned[person]; }
+    int assignedGroup(size_t person) const { return m_assigned[person] < 0 ? -1 : m_objectGroup[m_assigned[person]]; }
+    const AuctionStats& stats() const { return m_stats; }
+};
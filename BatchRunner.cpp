@@ -0,0 +1,338 @@
+// --- Пакетный (безоконный) прогон симуляции ---
+// Загружает radar_config.txt, крутит SimulationState::update с фиксированным dt
+// так быстро, как позволяет процессор, и печатает скорость (тиков/с) и итог игры.
+// Не зависит от <windows.h>: собирается из Point/GameConfig/Missile/Launcher/MissileLog/Radar/Simulationstate
+// без GdiDraw.cpp и main.cpp.
+//
+// Использование: BatchRunner [radar_config.txt] [--dt сек] [--max-time сек] [--journal файл] [--seed N]
+//                            [--games N [--threads N]] [--record файл] [--engine tick|event] [--radar lockstep|pipelined]
+//        BatchRunner --replay файл [--journal файл] [--scenario файл]
+// --journal задает бинарный журнал событий (перекрывает event_journal из конфигурации), см. JournalTool.
+// --record пишет запись ввода игры (InputRecording.h), --replay повторяет такую запись (например, из оконной
+// версии с input_recording в конфигурации) с максимальной скоростью и сверяет события каждой игры с записанными.
+// --seed задает начальное значение генератора (без него - случайное, печатается как seed=).
+// --games N - прогон Монте-Карло: N независимых игр на пуле потоков (MonteCarlo.h), печатается сводка.
+// --engine event - событийный движок (EventEngine.h): те же события и итог, update() только на тиках событий.
+// --radar pipelined - стадия радара на втором ядре параллельно со следующим тиком (только --engine tick, одна игра):
+// события те же, что у lockstep, выигрыш - на большом числе ракет.
+// --scenario задает файл сценария (перекрывает scenario из конфигурации, см. ScenarioFile.h и ScenarioGen.cpp);
+// при повторе записи, сделанной со сценарием, он обязателен и сверяется по контрольной сумме.
+#include "GameConfig.h"
+#include "SimulationState.h"
+#include "MonteCarlo.h"
+#include "InputRecording.h"
+#include "EventEngine.h"
+#include "ScenarioFile.h"
+#include <chrono>
+#include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static void printDistribution(const char* name, const Distribution& d) {
+    std::printf("%s_count=%llu\n", name, static_cast<unsigned long long>(d.count));
+    if (d.count == 0) return;
+    std::printf("%s_mean=%.3f\n", name, d.mean);
+    std::printf("%s_min=%.3f\n", name, d.min);
+    std::printf("%s_p05=%.3f\n", name, d.p05);
+    std::printf("%s_p25=%.3f\n", name, d.p25);
+    std::printf("%s_p50=%.3f\n", name, d.p50);
+    std::printf("%s_p75=%.3f\n", name, d.p75);
+    std::printf("%s_p95=%.3f\n", name, d.p95);
+    std::printf("%s_max=%.3f\n", name, d.max);
+}
+
+static int runMonteCarloMode(const std::string& configPath, const GameConfig& config, const MonteCarloOptions& options) {
+    MonteCarloSummary s = runMonteCarlo(config, options);
+
+    std::printf("config=%s\n", configPath.c_str());
+    std::printf("dt=%.4f\n", options.dt);
+    std::printf("seed=%llu\n", static_cast<unsigned long long>(options.seed));
+    std::printf("games=%d\n", s.games);
+    std::printf("threads=%d\n", s.threads);
+    std::printf("wall_sec=%.6f\n", s.wallSec);
+    std::printf("games_per_sec=%.1f\n", s.wallSec > 0.0 ? s.games / s.wallSec : 0.0);
+    std::printf("engine=%s\n", options.eventDriven ? "event" : "tick");
+    std::printf("ticks=%lld\n", s.ticks);
+    std::printf("ticks_per_sec=%.1f\n", s.wallSec > 0.0 ? s.ticks / s.wallSec : 0.0);
+    std::printf("updates=%lld\n", s.updates);
+    std::printf("wins=%d\n", s.wins);
+    std::printf("losses=%d\n", s.losses);
+    std::printf("timeouts=%d\n", s.timeouts);
+    std::printf("win_rate=%.4f\n", s.winRate);
+    std::printf("win_rate_ci95=%.4f\n", s.winRateCi95);
+    std::printf("launched=%lld\n", s.launched);
+    std::printf("destroyed=%lld\n", s.destroyed);
+    std::printf("kill_ratio=%.4f\n", s.killRatio);
+    printDistribution("kill_ratio_game", s.killRatioPerGame);
+    printDistribution("time_to_loss", s.timeToLoss);
+    printDistribution("time_to_win", s.timeToWin);
+    if (config.radar_fire_channels > 0) {
+        std::printf("wta_solves=%lld\n", s.assignmentSolves);
+        std::printf("wta_solve_us_mean=%.3f\n", s.assignmentUsMean);
+        std::printf("wta_solve_us_max=%.3f\n", s.assignmentUsMax);
+    }
+
+    // Самое быстрое поражение - его можно повторить отдельно: BatchRunner --seed <значение>.
+    const GameOutcome* fastest = nullptr;
+    for (const GameOutcome& o : s.outcomes) {
+        if (o.finished && !o.won && (!fastest || o.gameTime < fastest->gameTime)) fastest = &o;
+    }
+    if (fastest) std::printf("fastest_loss_seed=%llu\n", static_cast<unsigned long long>(fastest->seed));
+    return 0;
+}
+
+// --- Повтор записи ввода ---
+// Те же вызовы, что сделала записанная симуляция: seed() + initialize() на каждую игру, update(dt) на каждый тик.
+// Радар - lockstep (при записи - lockstep или pipelined, события у них одинаковые), поэтому события совпадают побитно.
+static int runReplay(const char* replayPath, const char* journalPath, const char* scenarioPath) {
+    InputRecordingReader reader;
+    if (!reader.open(replayPath)) {
+        std::fprintf(stderr, "%s\n", reader.lastError().c_str());
+        return 1;
+    }
+
+    SimulationState state;
+    GameConfig config;
+    std::vector<RadarSite> sites; // REC_RADAR_SITE перед REC_GAME
+    std::vector<LauncherSite> launchers; // REC_LAUNCHER перед REC_GAME
+    bool scenarioGame = false;           // REC_SCENARIO перед REC_GAME
+    ScenarioReader scenario;
+    int games = 0, checked = 0, mismatches = 0;
+    long long ticks = 0;
+    bool exited = false;
+    auto wallStart = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < reader.recordCount() && !exited; ++i) {
+        const recording::RecordingRecord& r = reader.record(i);
+        switch (r.type) {
+        case recording::REC_RADAR_SITE: {
+            RadarSite site;
+            site.pos = Point{ r.config[0], r.config[1] };
+            site.sweepSpeed = r.config[2];
+            site.beamWidth = r.config[3];
+            site.range = r.config[4];
+            site.engagementRadius = r.config[5];
+            site.deadZoneRadius = r.config[6];
+            sites.push_back(site);
+            break;
+        }
+        case recording::REC_LAUNCHER: {
+            LauncherSite launcher;
+            launcher.pos = Point{ r.config[0], r.config[1] };
+            launcher.minInterval = r.config[2];
+            launcher.maxInterval = r.config[3];
+            launchers.push_back(launcher);
+            break;
+        }
+        case recording::REC_SCENARIO:
+            if (!scenarioPath || !scenario.open(scenarioPath)) {
+                std::fprintf(stderr, "recording was made with a scenario file: pass it with --scenario%s%s\n",
+                             scenarioPath ? "; " : "", scenarioPath ? scenario.lastError().c_str() : "");
+                return 1;
+            }
+            if (scenario.fingerprint() != r.value || scenario.launchCount() != r.eventCount) {
+                std::fprintf(stderr, "scenario '%s' differs from the recorded one (fingerprint %016llx, recorded %016llx)\n", scenarioPath,
+                             static_cast<unsigned long long>(scenario.fingerprint()), static_cast<unsigned long long>(r.value));
+                return 1;
+            }
+            scenarioGame = true;
+            break;
+        case recording::REC_GAME:
+            config = journal::unpackConfig(r.config);
+            config.radar_sites.swap(sites);
+            sites.clear();
+            config.launchers.swap(launchers);
+            launchers.clear();
+            if (scenarioGame) config.scenario = scenarioPath;
+            scenarioGame = false;
+            if (journalPath) config.event_journal = journalPath;
+            state.seed(r.value);
+            state.initialize(config, RadarMode::Lockstep);
+            ++games;
+            break;
+        case recording::REC_TICKS:
+            for (uint32_t t = 0; t < r.count; ++t) state.update(r.dt, config);
+            ticks += r.count;
+            break;
+        case recording::REC_GAME_END: {
+            bool match = state.getEventCount() == r.eventCount && state.getEventDigest() == r.value;
+            ++checked;
+            if (!match) ++mismatches;
+            const char* result = !state.isGameOver() ? "RUNNING" : (state.hasPlayerWon() ? "WIN" : "LOSS");
+            std::printf("game[%d]=seed:%llu time:%.2f result:%s events:%llu digest:%016llx match:%d\n", games - 1,
+                static_cast<unsigned long long>(state.getSeed()), state.getGameTime(), result,
+                static_cast<unsigned long long>(state.getEventCount()), static_cast<unsigned long long>(state.getEventDigest()), match ? 1 : 0);
+            break;
+        }
+        case recording::REC_EXIT:
+            exited = true;
+            break;
+        default:
+            std::fprintf(stderr, "unknown record type %u at %llu\n", r.type, static_cast<unsigned long long>(i));
+            return 1;
+        }
+    }
+    state.shutdown();
+    double wallSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    std::printf("replay=%s\n", replayPath);
+    std::printf("records=%llu\n", static_cast<unsigned long long>(reader.recordCount()));
+    std::printf("games=%d\n", games);
+    std::printf("ticks=%lld\n", ticks);
+    std::printf("wall_sec=%.6f\n", wallSec);
+    std::printf("ticks_per_sec=%.1f\n", wallSec > 0.0 ? ticks / wallSec : 0.0);
+    std::printf("exit_recorded=%d\n", exited ? 1 : 0);
+    std::printf("games_checked=%d\n", checked);
+    std::printf("mismatches=%d\n", mismatches);
+    return mismatches ? 3 : 0;
+}
+
+int main(int argc, char* argv[]) {
+    std::setlocale(LC_ALL, ""); // Для вывода русских сообщений об ошибках конфигурации.
+
+    std::string configPath = "radar_config.txt";
+    float dt = 0.03f;         // Тот же шаг, что у окна (SIMULATION_STEP в main.cpp).
+    float maxGameTime = 3600.0f; // Страховка от бесконечной игры.
+    const char* journalPath = nullptr;
+    bool hasSeed = false;
+    uint64_t seed = 0;
+    int games = 0;   // 0 - одна игра с подробным выводом
+    int threads = 0;
+    const char* recordPath = nullptr;
+    const char* replayPath = nullptr;
+    const char* scenarioPath = nullptr;
+    bool eventDriven = false;
+    RadarMode radarMode = RadarMode::Lockstep;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--dt") == 0 && i + 1 < argc) dt = static_cast<float>(std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--max-time") == 0 && i + 1 < argc) maxGameTime = static_cast<float>(std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--journal") == 0 && i + 1 < argc) journalPath = argv[++i];
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) { hasSeed = true; seed = std::strtoull(argv[++i], nullptr, 10); }
+        else if (std::strcmp(argv[i], "--games") == 0 && i + 1 < argc) games = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threads = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) recordPath = argv[++i];
+        else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) replayPath = argv[++i];
+        else if (std::strcmp(argv[i], "--scenario") == 0 && i + 1 < argc) scenarioPath = argv[++i];
+        else if (std::strcmp(argv[i], "--engine") == 0 && i + 1 < argc) {
+            const char* engine = argv[++i];
+            if (std::strcmp(engine, "event") == 0) eventDriven = true;
+            else if (std::strcmp(engine, "tick") == 0) eventDriven = false;
+            else {
+                std::fprintf(stderr, "unknown engine '%s' (tick|event)\n", engine);
+                return 2;
+            }
+        }
+        else if (std::strcmp(argv[i], "--radar") == 0 && i + 1 < argc) {
+            const char* mode = argv[++i];
+            if (!parseRadarMode(mode, radarMode) || radarMode == RadarMode::Threaded) {
+                std::fprintf(stderr, "unknown radar mode '%s' (lockstep|pipelined)\n", mode);
+                return 2;
+            }
+        }
+        else configPath = argv[i];
+    }
+    if (dt <= 0.0f) {
+        std::fprintf(stderr, "dt must be > 0\n");
+        return 2;
+    }
+    if (eventDriven && radarMode != RadarMode::Lockstep) {
+        std::fprintf(stderr, "--engine event needs --radar lockstep\n");
+        return 2;
+    }
+
+    if (replayPath) return runReplay(replayPath, journalPath, scenarioPath); // Конфигурация - из записи.
+
+    GameConfig config;
+    if (!config.loadFromFile(configPath)) {
+        std::fwprintf(stderr, L"%ls\n", config.lastError.c_str());
+        return 1;
+    }
+    if (journalPath) config.event_journal = journalPath;
+    if (recordPath) config.input_recording = recordPath;
+    if (scenarioPath) config.scenario = scenarioPath;
+    uint64_t scenarioLaunches = 0;
+    if (!config.scenario.empty()) {
+        // Файл проверяется здесь: SimulationState с неоткрывшимся сценарием молча перешел бы на расписание.
+        ScenarioReader probe;
+        if (!probe.open(config.scenario)) {
+            std::fprintf(stderr, "%s\n", probe.lastError().c_str());
+            return 1;
+        }
+        scenarioLaunches = probe.launchCount();
+    }
+    if (!hasSeed) seed = Xoshiro256::entropySeed();
+
+    if (games > 0) {
+        MonteCarloOptions options;
+        options.games = games;
+        options.threads = threads;
+        options.seed = seed;
+        options.dt = dt;
+        options.maxGameTime = maxGameTime;
+        options.eventDriven = eventDriven;
+        return runMonteCarloMode(configPath, config, options);
+    }
+
+    // Радар без собственного потока: луч поворачивается по игровому времени внутри update(),
+    // иначе при прогоне быстрее реального времени он не успевал бы сканировать.
+    SimulationState state;
+    state.seed(seed);
+    state.initialize(config, radarMode);
+
+    long long ticks = 0;
+    long long updates = 0;
+    auto wallStart = std::chrono::steady_clock::now();
+    if (eventDriven) {
+        EventEngine engine(state);
+        EventEngineStats stats = engine.run(config, dt, maxGameTime);
+        ticks = static_cast<long long>(stats.ticks);
+        updates = static_cast<long long>(stats.updates);
+    }
+    else {
+        while (!state.isGameOver() && state.getGameTime() < maxGameTime) {
+            state.update(dt, config);
+            ++ticks;
+        }
+        updates = ticks;
+    }
+    state.flushRadarStage(); // Стадия радара последнего тика (pipelined) - до замера и итогов
+    auto wallEnd = std::chrono::steady_clock::now();
+    double wallSec = std::chrono::duration<double>(wallEnd - wallStart).count();
+
+    const char* result = !state.isGameOver() ? "TIMEOUT" : (state.hasPlayerWon() ? "WIN" : "LOSS");
+
+    std::printf("config=%s\n", configPath.c_str());
+    std::printf("dt=%.4f\n", dt);
+    std::printf("seed=%llu\n", static_cast<unsigned long long>(state.getSeed()));
+    std::printf("engine=%s\n", eventDriven ? "event" : "tick");
+    std::printf("radar=%s\n", radarModeName(radarMode)); // Снимок ракет - того же тика (pipelined - тот же, на втором ядре)
+    std::printf("radars=%zu\n", state.getRadarCount()); // Позиции радаров (основной + radar_site); event - только с одной
+    if (state.hasScenario()) std::printf("scenario_launches=%llu\n", static_cast<unsigned long long>(scenarioLaunches));
+    std::printf("ticks=%lld\n", ticks);
+    std::printf("updates=%lld\n", updates);
+    std::printf("wall_sec=%.6f\n", wallSec);
+    std::printf("ticks_per_sec=%.1f\n", wallSec > 0.0 ? ticks / wallSec : 0.0);
+    std::printf("game_time=%.2f\n", state.getGameTime());
+    std::printf("launched=%d/%d\n", state.getMissilesLaunched(), state.getMaxMissiles());
+    std::printf("destroyed=%d\n", state.getMissilesDestroyed());
+    std::printf("result=%s\n", result);
+    std::printf("journal_events=%llu\n", static_cast<unsigned long long>(state.getJournalEventCount()));
+    std::printf("events=%llu\n", static_cast<unsigned long long>(state.getEventCount()));
+    std::printf("events_digest=%016llx\n", static_cast<unsigned long long>(state.getEventDigest()));
+    if (config.radar_fire_channels > 0) {
+        // Назначение огневых каналов: решения (по одному на тик), время, ставки аукциона и пары теплого старта.
+        const AuctionStats& wta = state.getAssignmentStats();
+        uint64_t solves = state.getAssignmentSolves();
+        std::printf("wta_solves=%llu\n", static_cast<unsigned long long>(solves));
+        std::printf("wta_solve_us_mean=%.3f\n", solves ? state.getAssignmentNsTotal() * 1e-3 / solves : 0.0);
+        std::printf("wta_solve_us_max=%.3f\n", state.getAssignmentNsMax() * 1e-3);
+        std::printf("wta_bids=%llu\n", static_cast<unsigned long long>(wta.bids));
+        std::printf("wta_kept=%llu\n", static_cast<unsigned long long>(wta.kept));
+    }
+
+    state.shutdown();
+    return 0;
+}
@@ -0,0 +1,87 @@
+// --- Бенчмарк проверки луча ---
+// Сравнивает эталонную Radar::isMissileInBeam (atan2 + fmod) с BeamSector (векторные произведения)
+// в скалярном и пакетном (beamMask / beamSelect) вариантах на случайных позициях ракет.
+// Печатает нс на ракету и число расхождений с эталоном (возможны только на самой границе луча).
+//
+// Использование: BeamBench [число ракет] [число углов луча]
+#include "Radar.h"
+#include "BeamKernel.h"
+#include "AlignedAllocator.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// Эталон: то же, что делал findTarget() до пакетного ядра - кольцо по sqrt и угол через atan2.
+static bool referenceHit(float x, float y, float angle, float width, float inner, float outer) {
+    float dist = std::sqrt(x * x + y * y);
+    return dist > inner && dist <= outer && Radar::isMissileInBeam({ x, y }, angle, width);
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 1000000;
+    int angles = argc > 2 ? std::atoi(argv[2]) : 36;
+    if (n == 0 || angles <= 0) {
+        std::fprintf(stderr, "usage: BeamBench [missiles] [beam angles]\n");
+        return 2;
+    }
+
+    const float width = DEG_TO_RAD(10.0f); // Ширина луча по умолчанию (GameConfig)
+    const float inner = 20.0f;             // danger_zone_radius
+    const float outer = 350.0f;            // radar_range
+
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<float> coord(-400.0f, 400.0f);
+    AlignedVector<float> x(n), y(n);
+    for (size_t i = 0; i < n; ++i) { x[i] = coord(rng); y[i] = coord(rng); }
+
+    std::vector<uint64_t> mask((n + 63) / 64);
+    std::vector<uint32_t> indices(n);
+    std::vector<uint8_t> reference(n);
+
+    double tRef = 0.0, tScalar = 0.0, tMask = 0.0, tSelect = 0.0;
+    size_t hitsRef = 0, hitsScalar = 0, hitsMask = 0, hitsSelect = 0;
+    size_t mismatches = 0;
+
+    using clock = std::chrono::steady_clock;
+    for (int a = 0; a < angles; ++a) {
+        float angle = 2.0f * M_PI_F * a / angles;
+        BeamSector beam = BeamSector::make(angle, width, inner, outer);
+
+        auto t0 = clock::now();
+        for (size_t i = 0; i < n; ++i) {
+            reference[i] = referenceHit(x[i], y[i], angle, width, inner, outer) ? 1 : 0;
+            hitsRef += reference[i];
+        }
+        auto t1 = clock::now();
+        for (size_t i = 0; i < n; ++i) {
+            hitsScalar += beam.contains(x[i], y[i]) ? 1 : 0;
+        }
+        auto t2 = clock::now();
+        hitsMask += beamMask(beam, x.data(), y.data(), n, mask.data());
+        auto t3 = clock::now();
+        size_t selected = beamSelect(beam, x.data(), y.data(), n, indices.data());
+        hitsSelect += selected;
+        auto t4 = clock::now();
+
+        tRef += std::chrono::duration<double>(t1 - t0).count();
+        tScalar += std::chrono::duration<double>(t2 - t1).count();
+        tMask += std::chrono::duration<double>(t3 - t2).count();
+        tSelect += std::chrono::duration<double>(t4 - t3).count();
+
+        for (size_t i = 0; i < n; ++i) {
+            bool inMask = (mask[i / 64] >> (i % 64)) & 1u;
+            if (inMask != (reference[i] != 0)) ++mismatches;
+        }
+    }
+
+    double total = static_cast<double>(n) * angles;
+    std::printf("missiles=%zu beam_angles=%d\n", n, angles);
+    std::printf("reference_atan2 ns_per_missile=%.3f hits=%zu\n", tRef * 1e9 / total, hitsRef);
+    std::printf("sector_scalar   ns_per_missile=%.3f hits=%zu\n", tScalar * 1e9 / total, hitsScalar);
+    std::printf("sector_mask     ns_per_missile=%.3f hits=%zu\n", tMask * 1e9 / total, hitsMask);
+    std::printf("sector_select   ns_per_missile=%.3f hits=%zu\n", tSelect * 1e9 / total, hitsSelect);
+    std::printf("mismatches_vs_reference=%zu\n", mismatches);
+    return 0;
+}
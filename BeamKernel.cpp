@@ -0,0 +1,179 @@
+#include "BeamKernel.h" // Включаем заголовок ядра проверки луча
+#include <cmath>        // Для cos, sin
+#include <limits>       // Для infinity
+
+// --- Выбор SIMD-набора на этапе компиляции (как в MissileStore.cpp) ---
+#if defined(__AVX__)
+#include <immintrin.h>
+#define BEAM_KERNEL_AVX 1
+#define BEAM_LANES 8
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BEAM_KERNEL_SSE2 1
+#define BEAM_LANES 4
+#endif
+
+// --- Построение сектора ---
+// cos/sin краев считаются один раз на луч, а не на каждую ракету.
+BeamSector BeamSector::make(float radarAngle, float beamWidth) {
+    BeamSector b;
+    float startAngle = radarAngle - beamWidth / 2.0f;
+    float endAngle = radarAngle + beamWidth / 2.0f;
+    b.startX = std::cos(startAngle);
+    b.startY = std::sin(startAngle);
+    b.endX = std::cos(endAngle);
+    b.endY = std::sin(endAngle);
+    b.minRangeSq = -1.0f; // d2 > -1 всегда истинно
+    b.maxRangeSq = std::numeric_limits<float>::infinity();
+    b.wide = beamWidth > M_PI_F;
+    b.full = beamWidth >= 2.0f * M_PI_F;
+    return b;
+}
+
+BeamSector BeamSector::make(float radarAngle, float beamWidth, float innerExclusive, float outerInclusive) {
+    BeamSector b = make(radarAngle, beamWidth);
+    b.minRangeSq = innerExclusive * innerExclusive;
+    b.maxRangeSq = outerInclusive * outerInclusive;
+    return b;
+}
+
+// --- Вспомогательное: число единичных бит ---
+static inline size_t countBits(uint64_t v) {
+    size_t c = 0;
+    while (v) { v &= v - 1; ++c; }
+    return c;
+}
+
+#if defined(BEAM_KERNEL_AVX)
+// Маска (8 бит) для 8 точек начиная с x, y.
+static inline unsigned laneBits(const BeamSector& b, const float* x, const float* y) {
+    __m256 px = _mm256_loadu_ps(x);
+    __m256 py = _mm256_loadu_ps(y);
+    __m256 d2 = _mm256_add_ps(_mm256_mul_ps(px, px), _mm256_mul_ps(py, py));
+    __m256 ring = _mm256_and_ps(_mm256_cmp_ps(d2, _mm256_set1_ps(b.minRangeSq), _CMP_GT_OQ),
+                                _mm256_cmp_ps(d2, _mm256_set1_ps(b.maxRangeSq), _CMP_LE_OQ));
+    if (b.full) return static_cast<unsigned>(_mm256_movemask_ps(ring));
+    __m256 c1 = _mm256_sub_ps(_mm256_mul_ps(_mm256_set1_ps(b.startX), py), _mm256_mul_ps(_mm256_set1_ps(b.startY), px));
+    __m256 c2 = _mm256_sub_ps(_mm256_mul_ps(px, _mm256_set1_ps(b.endY)), _mm256_mul_ps(py, _mm256_set1_ps(b.endX)));
+    __m256 zero = _mm256_setzero_ps();
+    __m256 e1 = _mm256_cmp_ps(c1, zero, _CMP_GE_OQ);
+    __m256 e2 = _mm256_cmp_ps(c2, zero, _CMP_GE_OQ);
+    __m256 sector = b.wide ? _mm256_or_ps(e1, e2) : _mm256_and_ps(e1, e2);
+    return static_cast<unsigned>(_mm256_movemask_ps(_mm256_and_ps(ring, sector)));
+}
+#elif defined(BEAM_KERNEL_SSE2)
+// Маска (4 бита) для 4 точек начиная с x, y.
+static inline unsigned laneBits(const BeamSector& b, const float* x, const float* y) {
+    __m128 px = _mm_loadu_ps(x);
+    __m128 py = _mm_loadu_ps(y);
+    __m128 d2 = _mm_add_ps(_mm_mul_ps(px, px), _mm_mul_ps(py, py));
+    __m128 ring = _mm_and_ps(_mm_cmpgt_ps(d2, _mm_set1_ps(b.minRangeSq)),
+                             _mm_cmple_ps(d2, _mm_set1_ps(b.maxRangeSq)));
+    if (b.full) return static_cast<unsigned>(_mm_movemask_ps(ring));
+    __m128 c1 = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(b.startX), py), _mm_mul_ps(_mm_set1_ps(b.startY), px));
+    __m128 c2 = _mm_sub_ps(_mm_mul_ps(px, _mm_set1_ps(b.endY)), _mm_mul_ps(py, _mm_set1_ps(b.endX)));
+    __m128 zero = _mm_setzero_ps();
+    __m128 e1 = _mm_cmpge_ps(c1, zero);
+    __m128 e2 = _mm_cmpge_ps(c2, zero);
+    __m128 sector = b.wide ? _mm_or_ps(e1, e2) : _mm_and_ps(e1, e2);
+    return static_cast<unsigned>(_mm_movemask_ps(_mm_and_ps(ring, sector)));
+}
+#endif
+
+// --- Битовая маска попаданий ---
+size_t beamMask(const BeamSector& beam, const float* x, const float* y, size_t n, uint64_t* mask) {
+    const size_t words = (n + 63) / 64;
+    for (size_t w = 0; w < words; ++w) mask[w] = 0;
+
+    size_t i = 0;
+#if defined(BEAM_LANES)
+    // BEAM_LANES делит 64, поэтому группа лежит целиком в одном слове маски.
+    for (; i + BEAM_LANES <= n; i += BEAM_LANES) {
+        uint64_t bits = laneBits(beam, x + i, y + i);
+        mask[i / 64] |= bits << (i % 64);
+    }
+#endif
+    for (; i < n; ++i) {
+        if (beam.contains(x[i], y[i])) {
+            mask[i / 64] |= uint64_t(1) << (i % 64);
+        }
+    }
+
+    size_t count = 0;
+    for (size_t w = 0; w < words; ++w) count += countBits(mask[w]);
+    return count;
+}
+
+// --- Уплотненный список индексов попаданий ---
+size_t beamSelect(const BeamSector& beam, const float* x, const float* y, size_t n, uint32_t* indices) {
+    size_t count = 0;
+    size_t i = 0;
+#if defined(BEAM_LANES)
+    for (; i + BEAM_LANES <= n; i += BEAM_LANES) {
+        unsigned bits = laneBits(beam, x + i, y + i);
+        // Почти всегда 0: луч покрывает малую долю азимута.
+        for (unsigned lane = 0; bits; ++lane, bits >>= 1) {
+            if (bits & 1u) indices[count++] = static_cast<uint32_t>(i + lane);
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        if (beam.contains(x[i], y[i])) {
+            indices[count++] = static_cast<uint32_t>(i);
+        }
+    }
+    return count;
+}
+
+
+// --- Проход луча через движущуюся точку ---
+// Относительный угол точки к началу луча u(f) = (пеленг(f) - угол луча(f) + width/2) mod 2*PI линеен по доле шага f;
+// точка под лучом, пока u в [0, width]. Для каждого такого окна [fa, fb] внутри шага проверяется кольцо:
+// квадрат дальности на отрезке - выпуклая парабола, ее значения на окне - [минимум, максимум по концам].
+bool sweptBeamHit(float x0, float y0, float x1, float y1, float startAngle, float sweep, float beamWidth,
+                  float innerExclusive, float outerInclusive) {
+    const double TWO_PI = 6.283185307179586476925286766559;
+    const double inner2 = static_cast<double>(innerExclusive) * innerExclusive;
+    const double outer2 = static_cast<double>(outerInclusive) * outerInclusive;
+    const double px = x0, py = y0;
+    const double dx = static_cast<double>(x1) - x0, dy = static_cast<double>(y1) - y0;
+
+    // Есть ли на доле шага [fa, fb] момент с дальностью в кольце.
+    auto ringHit = [&](double fa, double fb) {
+        auto dist2 = [&](double f) { double x = px + dx * f, y = py + dy * f; return x * x + y * y; };
+        double dd = dx * dx + dy * dy;
+        double fmin = dd > 0.0 ? -(px * dx + py * dy) / dd : fa;
+        fmin = fmin < fa ? fa : (fmin > fb ? fb : fmin);
+        double lo = dist2(fmin);
+        double hi = std::fmax(dist2(fa), dist2(fb));
+        return lo <= outer2 && hi > inner2;
+    };
+
+    const double w = beamWidth;
+    if (w >= TWO_PI) return ringHit(0.0, 1.0);
+
+    double bearing0 = std::atan2(py, px);
+    double turn = std::remainder(std::atan2(static_cast<double>(y1), static_cast<double>(x1)) - bearing0, TWO_PI);
+    double rate = turn - sweep;                  // Скорость u по доле шага
+    double u0 = std::fmod(bearing0 - startAngle + w / 2.0, TWO_PI);
+    if (u0 < 0.0) u0 += TWO_PI;
+
+    if (rate == 0.0) return u0 <= w && ringHit(0.0, 1.0);
+    const double speed = std::fabs(rate);
+    if (speed > 64.0 * TWO_PI) return ringHit(0.0, 1.0); // Десятки оборотов за шаг: луч везде
+
+    // Первое окно под лучом, затем следующие через полный оборот.
+    double fa, fb;
+    if (rate < 0.0) {
+        fa = u0 > w ? (u0 - w) / speed : 0.0;
+        fb = u0 / speed;
+    }
+    else {
+        fa = u0 <= w ? 0.0 : (TWO_PI - u0) / speed;
+        fb = u0 <= w ? (w - u0) / speed : (TWO_PI - u0 + w) / speed;
+    }
+    for (; fa <= 1.0; fa += TWO_PI / speed, fb += TWO_PI / speed) {
+        if (ringHit(fa, fb < 1.0 ? fb : 1.0)) return true;
+    }
+    return false;
+}
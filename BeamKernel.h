@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "Point.h"
+
+// --- Сектор луча радара для проверок без atan2/fmod ---
+// Луч [angle - width/2, angle + width/2] задается единичными векторами краев.
+// Точка p внутри сектора (ширина <= PI), если она не правее начального края и не левее конечного:
+//     cross(start, p) >= 0  и  cross(p, end) >= 0.
+// Для сектора шире PI достаточно одного из условий. Края включаются, как в isAngleBetween().
+// Дополнительно сектор может ограничиваться кольцом дальности (minRange, maxRange] - как в findTarget().
+// Координаты ракет передаются относительно позиции радара (радар - в (0,0) своей системы).
+struct BeamSector {
+    float startX, startY; // Единичный вектор начального края (angle - width/2)
+    float endX, endY;     // Единичный вектор конечного края (angle + width/2)
+    float minRangeSq;     // Квадрат внутреннего радиуса (строго больше); -1: без ограничения
+    float maxRangeSq;     // Квадрат внешнего радиуса (меньше или равно); +inf: без ограничения
+    bool wide;            // Ширина > PI: условия краев объединяются через ИЛИ
+    bool full;            // Ширина >= 2*PI: любой угол внутри
+
+    // Сектор без ограничения дальности.
+    static BeamSector make(float radarAngle, float beamWidth);
+    // Сектор, ограниченный кольцом (innerExclusive, outerInclusive].
+    static BeamSector make(float radarAngle, float beamWidth, float innerExclusive, float outerInclusive);
+    // Все, что луч накрыл, повернувшись против часовой стрелки от startAngle на sweep радиан:
+    // [startAngle - width/2, startAngle + sweep + width/2].
+    static BeamSector makeSwept(float startAngle, float sweep, float beamWidth) {
+        return make(startAngle + sweep / 2.0f, beamWidth + sweep);
+    }
+    static BeamSector makeSwept(float startAngle, float sweep, float beamWidth, float innerExclusive, float outerInclusive) {
+        return make(startAngle + sweep / 2.0f, beamWidth + sweep, innerExclusive, outerInclusive);
+    }
+
+    // Скалярная проверка одной точки.
+    bool contains(float x, float y) const {
+        float d2 = x * x + y * y;
+        if (!(d2 > minRangeSq && d2 <= maxRangeSq)) return false;
+        if (full) return true;
+        float c1 = startX * y - startY * x; // cross(start, p)
+        float c2 = x * endY - y * endX;     // cross(p, end)
+        return wide ? (c1 >= 0.0f || c2 >= 0.0f) : (c1 >= 0.0f && c2 >= 0.0f);
+    }
+    bool contains(const Point& p) const { return contains(p.x, p.y); }
+};
+
+// --- Пакетные проверки по массивам координат (AVX / SSE2 / скалярно) ---
+
+// Заполняет битовую маску: бит i слова i/64 = точка i внутри сектора.
+// mask должен вмещать (n + 63) / 64 слов. Возвращает число точек внутри.
+size_t beamMask(const BeamSector& beam, const float* x, const float* y, size_t n, uint64_t* mask);
+
+// Записывает индексы точек внутри сектора (по возрастанию) в indices (емкость >= n).
+// Возвращает их количество.
+size_t beamSelect(const BeamSector& beam, const float* x, const float* y, size_t n, uint32_t* indices);
+
+// --- Проход луча через движущуюся точку за шаг ---
+// Луч шириной beamWidth повернулся против часовой стрелки от startAngle на sweep радиан, а точка за то же
+// время прошла по прямой от (x0, y0) до (x1, y1). true, если в какой-то момент шага точка была под лучом
+// на дальности из кольца (innerExclusive, outerInclusive]. В отличие от проверки в один момент времени,
+// ракету не пропустить при любом шаге: луч, повернувшийся за шаг больше чем на свою ширину, не
+// "перепрыгивает" ее. Пеленг точки за шаг меняется линейно (для ракет, летящих к радару, он постоянен).
+bool sweptBeamHit(float x0, float y0, float x1, float y1, float startAngle, float sweep, float beamWidth,
+                  float innerExclusive, float outerInclusive);
@@ -0,0 +1,78 @@
+#include "BearingIndex.h" // Включаем заголовок азимутального индекса
+#include "MissileStore.h"
+
+BearingIndex::BearingIndex() {
+    m_grid.setRings(0.0f, 0.0f, 0.0f); // Настоящие радиусы задает configure()
+}
+
+void BearingIndex::configure(float deadZoneRadius, float engagementRadius, float range) {
+    m_grid.setRings(deadZoneRadius, engagementRadius, range);
+}
+
+void MissileFrame::assign(const MissileStore& missiles) {
+    const size_t n = missiles.size();
+    x.assign(missiles.xData(), missiles.xData() + n);
+    y.assign(missiles.yData(), missiles.yData() + n);
+    vx.assign(missiles.vxData(), missiles.vxData() + n);
+    vy.assign(missiles.vyData(), missiles.vyData() + n);
+    id.assign(missiles.idData(), missiles.idData() + n);
+    launcherId.assign(missiles.launcherIdData(), missiles.launcherIdData() + n);
+}
+
+void BearingIndex::build(const MissileStore& missiles, MissileSnapshot& out, const Point& origin) {
+    buildFrom(missiles.size(), missiles.xData(), missiles.yData(), missiles.vxData(), missiles.vyData(),
+              missiles.idData(), missiles.launcherIdData(), missiles.activeData(), origin, out);
+}
+
+void BearingIndex::build(const MissileFrame& frame, MissileSnapshot& out, const Point& origin) {
+    buildFrom(frame.size(), frame.x.data(), frame.y.data(), frame.vx.data(), frame.vy.data(),
+              frame.id.data(), frame.launcherId.data(), nullptr, origin, out);
+}
+
+// --- Построение снимка, отсортированного по корзинам ---
+void BearingIndex::buildFrom(size_t n, const float* xs, const float* ys, const float* vxs, const float* vys,
+                             const int* ids, const int* launcherIds, const uint8_t* active, const Point& origin, MissileSnapshot& out) {
+    const int bucketCount = BearingGrid::RINGS * BearingGrid::SECTORS;
+    const float ox = origin.x;
+    const float oy = origin.y;
+
+    out.grid = m_grid;
+    out.bucketStart.assign(bucketCount + 1, 0);
+    m_keys.resize(n);
+
+    // Проход 1: корзина каждой активной ракеты и размеры корзин (счетчики сдвинуты на 1 для префиксной суммы).
+    size_t activeCount = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (active && !active[i]) continue;
+        int key = m_grid.bucketOf(xs[i] - ox, ys[i] - oy);
+        m_keys[i] = static_cast<uint16_t>(key);
+        ++out.bucketStart[key + 1];
+        ++activeCount;
+    }
+    for (int k = 0; k < bucketCount; ++k) {
+        out.bucketStart[k + 1] += out.bucketStart[k];
+    }
+
+    // Проход 2: раскладываем ракеты по местам (стабильно: внутри корзины сохраняется порядок по ID).
+    out.x.resize(activeCount);
+    out.y.resize(activeCount);
+    out.vx.resize(activeCount);
+    out.vy.resize(activeCount);
+    out.id.resize(activeCount);
+    out.launcherId.resize(activeCount);
+    m_cursor.assign(out.bucketStart.begin(), out.bucketStart.end() - 1);
+    float maxSpeedSq = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+        if (active && !active[i]) continue;
+        uint32_t dst = m_cursor[m_keys[i]]++;
+        out.x[dst] = xs[i] - ox; // Для радара в (0,0) - те же значения побитно
+        out.y[dst] = ys[i] - oy;
+        out.vx[dst] = vxs[i];
+        out.vy[dst] = vys[i];
+        out.id[dst] = ids[i];
+        out.launcherId[dst] = launcherIds[i];
+        float speedSq = vxs[i] * vxs[i] + vys[i] * vys[i];
+        if (speedSq > maxSpeedSq) maxSpeedSq = speedSq;
+    }
+    out.maxSpeed = std::sqrt(maxSpeedSq);
+}
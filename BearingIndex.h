@@ -0,0 +1,144 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include "AlignedAllocator.h"
+#include "BeamKernel.h"
+#include "Point.h"
+
+class MissileStore; // Предварительное объявление
+
+// --- Сетка "азимутальный сектор x кольцо дальности" вокруг радара (0,0) ---
+// Кольца совпадают с зонами радара, поэтому запрос "ракеты под лучом в зоне обнаружения"
+// трогает только корзины колец RING_ENGAGE..RING_DETECT в секторах, которые перекрывает луч.
+// Сектор считается по псевдоуглу (монотонен по atan2, без тригонометрии), границы секторов
+// равномерны по псевдоуглу, а не по градусам - для запросов это неважно, они тоже идут через псевдоугол.
+struct BearingGrid {
+    enum {
+        SECTORS = 256,
+        RINGS = 4,
+        RING_DEAD = 0,    // d <= deadZoneRadius (Красный)
+        RING_ENGAGE = 1,  // deadZoneRadius < d <= engagementRadius (Желтый)
+        RING_DETECT = 2,  // engagementRadius < d <= radar_range (Зеленый)
+        RING_OUTSIDE = 3  // d > radar_range
+    };
+
+    float ringOuterSq[RINGS - 1]; // Квадраты внешних радиусов колец 0..2 (кольцо 3 не ограничено)
+
+    void setRings(float deadZoneRadius, float engagementRadius, float range) {
+        ringOuterSq[RING_DEAD] = deadZoneRadius * deadZoneRadius;
+        ringOuterSq[RING_ENGAGE] = engagementRadius * engagementRadius;
+        ringOuterSq[RING_DETECT] = range * range;
+    }
+
+    // Псевдоугол в [0, 4): 0 - ось +X, 1 - +Y, 2 - -X, 3 - -Y (возрастает вместе с atan2).
+    static float pseudoAngle(float x, float y) {
+        float s = std::fabs(x) + std::fabs(y);
+        if (s == 0.0f) return 0.0f;
+        float p = x / s;
+        return y >= 0.0f ? 1.0f - p : 3.0f + p;
+    }
+    static int sectorOf(float x, float y) {
+        int s = static_cast<int>(pseudoAngle(x, y) * (SECTORS / 4.0f));
+        return s < SECTORS ? s : SECTORS - 1;
+    }
+    int ringOf(float d2) const {
+        if (d2 <= ringOuterSq[RING_DEAD]) return RING_DEAD;
+        if (d2 <= ringOuterSq[RING_ENGAGE]) return RING_ENGAGE;
+        if (d2 <= ringOuterSq[RING_DETECT]) return RING_DETECT;
+        return RING_OUTSIDE;
+    }
+    int bucketOf(float x, float y) const {
+        return ringOf(x * x + y * y) * SECTORS + sectorOf(x, y);
+    }
+
+    // Вызывает f(begin, end) для непрерывных диапазонов снимка, покрывающих луч в кольцах [ringMin, ringMax].
+    // Корзины упорядочены "кольцо, затем сектор", поэтому на кольцо приходится 1-2 диапазона.
+    // Диапазон секторов расширен на 1 с каждой стороны: точка на краю луча не теряется из-за округления.
+    // Результат - кандидаты; точную проверку делает BeamSector.
+    template <typename F>
+    void forEachRangeInBeam(const BeamSector& beam, int ringMin, int ringMax, const uint32_t* bucketStart, F&& f) const {
+        int first = 0;
+        int count = SECTORS;
+        if (!beam.wide) {
+            int a = sectorOf(beam.startX, beam.startY);
+            int b = sectorOf(beam.endX, beam.endY);
+            int span = (b - a + SECTORS) % SECTORS; // Против часовой стрелки от начального края до конечного
+            if (span + 3 < SECTORS) {
+                first = (a - 1 + SECTORS) % SECTORS;
+                count = span + 3;
+            }
+        }
+        for (int r = ringMin; r <= ringMax; ++r) {
+            const uint32_t* ring = bucketStart + r * SECTORS;
+            int last = first + count - 1;
+            if (last < SECTORS) {
+                f(ring[first], ring[last + 1]);
+            }
+            else {
+                f(ring[first], ring[SECTORS]);        // До конца кольца...
+                f(ring[0], ring[last - SECTORS + 1]); // ...и с начала (переход через 0 рад)
+            }
+        }
+    }
+};
+
+// --- Снимок активных ракет для радара (SoA, отсортирован по корзинам BearingGrid) ---
+// Ракеты корзины k лежат в [bucketStart[k], bucketStart[k + 1]). Массивы x/y идут прямо в BeamKernel.
+// x/y - относительно радара (origin в build()), поэтому сетка и BeamSector по-прежнему считают радар в (0,0).
+struct MissileSnapshot {
+    AlignedVector<float> x;
+    AlignedVector<float> y;
+    std::vector<float> vx;   // Скорость: положение в начале шага радара (проход луча за шаг)
+    std::vector<float> vy;
+    std::vector<int> id;
+    std::vector<int> launcherId;
+    BearingGrid grid;
+    std::vector<uint32_t> bucketStart; // BearingGrid::RINGS * SECTORS + 1 элементов
+    float maxSpeed = 0.0f;             // Наибольшая скорость ракеты снимка: смещение за шаг не больше maxSpeed * dt
+
+    size_t size() const { return x.size(); }
+    void clear() { x.clear(); y.clear(); vx.clear(); vy.clear(); id.clear(); launcherId.clear(); bucketStart.clear(); maxSpeed = 0.0f; }
+};
+
+// --- Кадр ракет на конец тика (передача стадии радара конвейера, RadarMode::Pipelined) ---
+// Простая копия массивов MissileStore после cleanupInactiveMissiles(): все ракеты кадра активны.
+// Копирование - последовательный memcpy, дешевле построения индекса, поэтому индекс строит уже стадия радара.
+struct MissileFrame {
+    AlignedVector<float> x;
+    AlignedVector<float> y;
+    std::vector<float> vx;
+    std::vector<float> vy;
+    std::vector<int> id;
+    std::vector<int> launcherId;
+
+    size_t size() const { return x.size(); }
+    void assign(const MissileStore& missiles); // Хранилище без неактивных ракет (после removeInactive)
+};
+
+// --- Построитель азимутального индекса ---
+// Раскладывает активные ракеты MissileStore по корзинам (сортировка подсчетом, два прохода O(n)).
+// Вызывается из потока симуляции на каждом тике; рабочие буферы переиспользуются.
+class BearingIndex {
+private:
+    BearingGrid m_grid;
+    std::vector<uint16_t> m_keys;     // Корзина каждой ракеты хранилища (первый проход)
+    std::vector<uint32_t> m_cursor;   // Позиция записи по корзинам (второй проход)
+
+    // Общая часть build(): active == nullptr - активны все n ракет.
+    void buildFrom(size_t n, const float* xs, const float* ys, const float* vxs, const float* vys,
+                   const int* ids, const int* launcherIds, const uint8_t* active, const Point& origin, MissileSnapshot& out);
+
+public:
+    BearingIndex();
+
+    void configure(float deadZoneRadius, float engagementRadius, float range);
+    const BearingGrid& grid() const { return m_grid; }
+
+    // Перезаписывает out: активные ракеты в порядке корзин (внутри корзины - порядок хранилища, т.е. по ID),
+    // координаты - относительно origin (позиции радара).
+    void build(const MissileStore& missiles, MissileSnapshot& out, const Point& origin);
+    void build(const MissileFrame& frame, MissileSnapshot& out, const Point& origin); // То же из кадра конвейера
+};
@@ -0,0 +1,234 @@
+#include "EventEngine.h"
+#include "SimulationState.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace {
+const double TWO_PI = 6.283185307179586476925286766559;
+const double ANGLE_MARGIN = 1e-3;  // Запас к половине луча (рад): погрешность пеленга float-позиции и краев BeamSector
+}
+
+EventEngine::EventEngine(SimulationState& state) :
+    m_state(state),
+    m_queuedMissiles(0),
+    m_dt(0.0f),
+    m_dtNs(0),
+    m_sweepSpeed(0.0),
+    m_halfBeam(0.0),
+    m_range(0.0),
+    m_engagementRadius(0.0),
+    m_deadZoneRadius(0.0)
+{
+}
+
+// --- Параметры полета ракеты по индексу хранилища ---
+EventEngine::Flight EventEngine::flightOf(size_t index) const {
+    const MissileStore& missiles = m_state.m_missiles;
+    Point o = missiles.origin(index);
+    Point v = missiles.velocity(index);
+    Flight f;
+    f.range0 = std::hypot(static_cast<double>(o.x), static_cast<double>(o.y));
+    f.speed = std::hypot(static_cast<double>(v.x), static_cast<double>(v.y));
+    f.t0 = missiles.launchTime(index);
+    f.bearing = std::atan2(static_cast<double>(o.y), static_cast<double>(o.x));
+    double cross = static_cast<double>(o.x) * v.y - static_cast<double>(o.y) * v.x;
+    double dot = static_cast<double>(o.x) * v.x + static_cast<double>(o.y) * v.y;
+    f.radial = f.speed > 0.0 && (f.range0 < 1e-6 || (std::fabs(cross) <= 1e-5 * f.range0 * f.speed && dot < 0.0));
+    f.arrival = missiles.arrivalTime(index);
+    // Ближайшая к центру точка оставшегося пути: вершина параболы |o + v*s|^2 или текущая позиция, если она
+    // уже пройдена. Дальше кольца обнаружения (с запасом) - ни обнаружения, ни мертвой зоны до промаха.
+    f.outside = false;
+    if (!f.radial && f.speed > 0.0) {
+        double now = static_cast<double>(m_state.m_clockNs) * 1e-9;
+        double closest = -dot / (f.speed * f.speed) < now - f.t0
+            ? std::hypot(o.x + v.x * (now - f.t0), o.y + v.y * (now - f.t0))
+            : std::fabs(cross) / f.speed;
+        f.outside = closest > m_range + 1e-3 + m_range * 1e-5;
+    }
+    return f;
+}
+
+// Игровое время в update() - float от целых наносекунд, позиции и угол считаются от него:
+// отклонение от точного времени не больше нескольких ulp(t). Плюс тик на округление границы.
+double EventEngine::slackAt(double t) const {
+    return static_cast<double>(m_dt) + 1e-6 + std::fabs(t) * 1e-6;
+}
+
+// Первый тик после текущего, время которого не раньше t - slackAt(t).
+uint64_t EventEngine::tickAtOrAfter(double t) const {
+    if (!(t < 1e12)) return NEVER;
+    double target = (t - slackAt(t)) * 1e9 - static_cast<double>(m_state.m_clockNs);
+    double k = std::ceil(target / static_cast<double>(m_dtNs));
+    if (k < 1.0) k = 1.0;
+    if (k > 1e15) return NEVER;
+    return m_state.m_tick + static_cast<uint64_t>(k);
+}
+
+// Самый ранний момент >= t, когда пеленг bearing внутри луча (угол луча sweepSpeed * t, см. Radar::beamAngleAt).
+double EventEngine::beamTimeAfter(double t, double bearing) const {
+    if (2.0 * m_halfBeam >= TWO_PI) return t;
+    double u = std::fmod(m_sweepSpeed * t - (bearing - m_halfBeam), TWO_PI);
+    if (u < 0.0) u += TWO_PI;
+    if (u <= 2.0 * m_halfBeam) return t;
+    return t + (TWO_PI - u) / m_sweepSpeed;
+}
+
+// --- Прогнозы отдельных событий (номер тика или NEVER) ---
+
+// Момент, когда дистанция до центра станет не больше radius (с запасом на погрешность позиции).
+static double timeAtRadius(double range0, double speed, double t0, double radius) {
+    double margin = 1e-3 + range0 * 1e-5;
+    double path = range0 - (radius + margin);
+    return path <= 0.0 ? t0 : t0 + path / speed;
+}
+
+// Вход в мертвую зону или промах (проход точки цели) - что раньше.
+uint64_t EventEngine::deadZoneTick(size_t index) const {
+    Flight f = flightOf(index);
+    uint64_t missed = tickAtOrAfter(f.arrival);
+    if (f.outside) return missed;
+    if (!f.radial) return m_state.m_tick + 1;
+    return std::min(missed, tickAtOrAfter(timeAtRadius(f.range0, f.speed, f.t0, m_deadZoneRadius)));
+}
+
+// Обнаружение на тике n: луч прошел через пеленг ракеты за шаг [t(n-1), t(n)], когда она была в кольце
+// (Красный, Зеленый]. Момент прохода не раньше текущего времени и входа в кольцо, а тик n - первый после него.
+uint64_t EventEngine::detectionTick(size_t index) const {
+    Flight f = flightOf(index);
+    if (f.outside) return NEVER; // Кольцо обнаружения ракета уже не пересечет
+    if (!f.radial) return m_state.m_tick + 1;
+    double now = static_cast<double>(m_state.m_clockNs) * 1e-9;
+    double a = std::max(now, timeAtRadius(f.range0, f.speed, f.t0, m_range));
+    return tickAtOrAfter(beamTimeAfter(a - slackAt(a), f.bearing));
+}
+
+// Проход луча через цель на сопровождении на тике n: луч прошел через нее за ПРЕДЫДУЩИЙ шаг [t(n-2), t(n-1)]
+// (checkCollisionsAndIntercepts идет до шага радара). На этом тике трек обновляется или, если ракета уже в зоне
+// поражения, она сбивается. Момент прохода tb не раньше t(текущий) - dt, а t(n) >= tb + dt.
+uint64_t EventEngine::trackTick(size_t index) const {
+    Flight f = flightOf(index);
+    if (!f.radial) return m_state.m_tick + 1;
+    double now = static_cast<double>(m_state.m_clockNs) * 1e-9;
+    double a = now - m_dt;
+    double tb = beamTimeAfter(a - slackAt(a), f.bearing);
+    return tickAtOrAfter(tb + m_dt);
+}
+
+// Запуск: часы в целых наносекундах, поэтому тик вычисляется точно.
+uint64_t EventEngine::launchTick() const {
+    const SimulationState& s = m_state;
+    if (s.m_missilesLaunched >= s.m_maxMissiles || s.m_playerWon) return NEVER;
+    int64_t wait = s.nextLaunchAtNs() - s.m_clockNs;
+    int64_t k = wait > 0 ? (wait + m_dtNs - 1) / m_dtNs : 1;
+    return s.m_tick + static_cast<uint64_t>(k < 1 ? 1 : k);
+}
+
+// Первый тик, после которого getGameTime() >= maxGameTime (на нем цикл тикового движка останавливается).
+uint64_t EventEngine::timeLimitTick(float maxGameTime) const {
+    if (!(maxGameTime < 1e9f)) return NEVER;
+    const int64_t clock = m_state.m_clockNs;
+    auto timeAfter = [&](int64_t k) { return SimulationState::clockToSeconds(clock + k * m_dtNs); };
+    double wait = static_cast<double>(maxGameTime) * 1e9 - static_cast<double>(clock);
+    int64_t k = wait > 0.0 ? static_cast<int64_t>(std::ceil(wait / static_cast<double>(m_dtNs))) : 1;
+    if (k < 1) k = 1;
+    while (k > 1 && timeAfter(k - 1) >= maxGameTime) --k;
+    while (timeAfter(k) < maxGameTime) ++k;
+    return m_state.m_tick + static_cast<uint64_t>(k);
+}
+
+// --- Очереди ---
+
+void EventEngine::enqueueNewMissiles() {
+    const MissileStore& missiles = m_state.m_missiles;
+    for (; m_queuedMissiles < m_state.m_missilesLaunched; ++m_queuedMissiles) {
+        long index = missiles.findById(m_queuedMissiles);
+        if (index < 0 || !missiles.isActive(static_cast<size_t>(index))) continue;
+        size_t i = static_cast<size_t>(index);
+        m_deadZone.push_back({ deadZoneTick(i), m_queuedMissiles });
+        std::push_heap(m_deadZone.begin(), m_deadZone.end(), std::greater<Pending>());
+        m_detection.push_back({ detectionTick(i), m_queuedMissiles });
+        std::push_heap(m_detection.begin(), m_detection.end(), std::greater<Pending>());
+    }
+}
+
+// Снимает с вершины записи, чей тик уже наступил: сбитые ракеты выбрасываются, остальные пересчитываются
+// от текущего тика. Возвращает ближайший тик очереди.
+template <typename Compute>
+uint64_t EventEngine::refresh(std::vector<Pending>& heap, Compute compute) {
+    const MissileStore& missiles = m_state.m_missiles;
+    while (!heap.empty() && heap.front().tick <= m_state.m_tick) {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<Pending>());
+        Pending e = heap.back();
+        heap.pop_back();
+        long index = missiles.findById(e.missileId);
+        if (index < 0 || !missiles.isActive(static_cast<size_t>(index))) continue;
+        e.tick = compute(static_cast<size_t>(index));
+        if (e.tick == NEVER) continue;
+        heap.push_back(e);
+        std::push_heap(heap.begin(), heap.end(), std::greater<Pending>());
+    }
+    return heap.empty() ? NEVER : heap.front().tick;
+}
+
+// Ближайший тик, на котором что-то может произойти.
+uint64_t EventEngine::nextEventTick(float maxGameTime) {
+    const uint64_t now = m_state.m_tick;
+    uint64_t next = std::min(timeLimitTick(maxGameTime), launchTick());
+    next = std::min(next, refresh(m_deadZone, [this](size_t i) { return deadZoneTick(i); }));
+
+    // Треки - без очереди: каждый проход луча через цель на сопровождении - событие (обновление трека
+    // или поражение). Ракета трека уже неактивна - трек сбросится на следующем тике.
+    const TrackTable& tracks = m_state.m_radars.primary().tracks();
+    for (size_t k = 0; k < tracks.size(); ++k) {
+        long index = m_state.m_missiles.findById(tracks.missileId(k));
+        if (index < 0 || !m_state.m_missiles.isActive(static_cast<size_t>(index))) next = now + 1;
+        else next = std::min(next, trackTick(static_cast<size_t>(index)));
+    }
+    // Пока таблица треков полна, новых обнаружений нет: очередь обнаружения не трогаем,
+    // ее просроченные записи пересчитаются после сброса трека.
+    if (tracks.freeSlots() > 0) {
+        next = std::min(next, refresh(m_detection, [this](size_t i) { return detectionTick(i); }));
+    }
+    return std::max(next, now + 1);
+}
+
+// --- Основной цикл ---
+EventEngineStats EventEngine::run(const GameConfig& config, float dt, float maxGameTime) {
+    EventEngineStats stats;
+    SimulationState& s = m_state;
+    const uint64_t startTick = s.m_tick;
+
+    m_dt = dt;
+    m_dtNs = SimulationState::secondsToClock(dt);
+    m_sweepSpeed = config.radar_sweep_speed;
+    m_halfBeam = config.radar_beam_width / 2.0 + ANGLE_MARGIN;
+    m_range = config.radar_range;
+    m_engagementRadius = config.radar_engagement_radius;
+    m_deadZoneRadius = config.danger_zone_radius;
+    m_deadZone.clear();
+    m_detection.clear();
+    m_queuedMissiles = 0;
+
+    // Радар в своем потоке или нулевой шаг часов: прогнозировать нечего, обычный тиковый цикл.
+    // Прогноз построен для одного радара в центре; с несколькими позициями (radar_site) - тоже обычный цикл.
+    // Огневые каналы (radar_fire_channels) решаются каждый тик с теплым стартом от прошлого решения: пропуск
+    // тиков изменил бы цены аукциона, поэтому тоже обычный цикл.
+    const bool predictable = s.m_radarMode == RadarMode::Lockstep && s.m_radars.size() == 1 && s.m_fireChannels == 0 &&
+                             m_dtNs > 0 && m_sweepSpeed > 0.0;
+
+    while (!s.isGameOver() && s.getGameTime() < maxGameTime) {
+        if (predictable) {
+            enqueueNewMissiles();
+            uint64_t skip = nextEventTick(maxGameTime) - s.m_tick - 1;
+            if (skip > 0) {
+                s.skipTicks(skip, dt);
+                stats.skipped += skip;
+            }
+        }
+        s.update(dt, config);
+        ++stats.updates;
+    }
+    stats.ticks = s.m_tick - startTick;
+    return stats;
+}
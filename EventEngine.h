@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "GameConfig.h"
+
+class SimulationState; // Предварительное объявление
+
+// --- Событийный движок: тики без событий пропускаются ---
+// Ракета летит по прямой к (0,0) с постоянной скоростью, луч вращается с постоянной угловой скоростью,
+// момент следующего запуска известен заранее. Поэтому вход ракеты в кольцо обнаружения и в зону поражения,
+// проход луча через ее пеленг (за шаг, см. sweptBeamHit) и удар в мертвую зону вычисляются наперед.
+// Движок держит очереди с приоритетом (min-куча по номеру тика) этих будущих событий и вызывает
+// SimulationState::update() только на тиках, где событие возможно; остальные тики проходит одним
+// SimulationState::skipTicks().
+//
+// Итог совпадает с тиковым движком побитно (те же события MissileLog, та же контрольная сумма), а не
+// приближенно: update() на тике события - тот же код, а состояние на пропущенных тиках - функция игрового
+// времени (MissileStore::update, Radar::beamAngleAt). Прогноз консервативен: момент события считается в
+// double с запасом в пару тиков и на погрешность float, поэтому тик может быть выполнен зря, но не пропущен.
+// Стоимость игры пропорциональна числу событий (проходов луча через ракеты), а не числу тиков:
+// шаг dt можно уменьшать до предела точности float-времени почти без замедления.
+//
+// Очереди:
+//   m_deadZone  - тик, не позже которого ракета может войти в мертвую зону (поражение или потеря цели)
+//                 или пройти точку цели (промах);
+//   m_detection - ближайший тик, на котором ракета может оказаться под лучом в кольце обнаружения
+//                 (пока в таблице треков есть место);
+// плюс без очереди: следующий запуск, проход луча через каждую цель на сопровождении (обновление трека
+// или поражение) и предел времени.
+// Записи пересчитываются лениво: снятая с вершины запись либо стала событием (тик выполнен), либо
+// пересчитывается от текущего тика и возвращается в кучу.
+//
+// Ограничения: постоянный dt (не меньше 1 нс - шага часов симуляции), один радар без потока (без radar_site).
+// Ракета, летящая не к центру, отключает пропуск тиков, пока она активна (прогноз для нее не строится),
+// кроме ракеты, которая до прохода точки цели уже не войдет в кольцо обнаружения: для нее известен только тик промаха.
+
+struct EventEngineStats {
+    uint64_t ticks = 0;        // Тиков игры (столько же сделал бы тиковый движок)
+    uint64_t updates = 0;      // Из них выполнено через update()
+    uint64_t skipped = 0;      // Пропущено через skipTicks()
+};
+
+class EventEngine {
+private:
+    struct Pending {
+        uint64_t tick;  // Абсолютный номер тика (SimulationState::getTick())
+        int missileId;
+        bool operator>(const Pending& other) const {
+            return tick != other.tick ? tick > other.tick : missileId > other.missileId;
+        }
+    };
+
+    // Прямолинейный полет к центру: r(t) = range0 - speed * (t - t0), пеленг постоянен.
+    struct Flight {
+        double range0;
+        double speed;
+        double t0;
+        double bearing;
+        bool radial;    // false - прогноз невозможен, событие возможно на каждом тике
+        bool outside;   // Не к центру и до конца полета не ближе radar_range: событие - только промах
+        double arrival; // Время прохода точки цели ("Промах", SimulationState::expireMissiles)
+    };
+
+    SimulationState& m_state;
+    std::vector<Pending> m_deadZone;   // min-кучи (std::push_heap с greater)
+    std::vector<Pending> m_detection;
+    int m_queuedMissiles;              // Ракеты с ID < этого уже поставлены в очереди
+
+    float m_dt;
+    int64_t m_dtNs;
+    double m_sweepSpeed;               // Параметры радара текущей игры
+    double m_halfBeam;                 // Половина ширины луча с запасом
+    double m_range;
+    double m_engagementRadius;
+    double m_deadZoneRadius;
+
+    Flight flightOf(size_t index) const;
+    double slackAt(double t) const;    // Запас по времени на погрешность float и дискретность тиков
+    uint64_t tickAtOrAfter(double t) const;
+    double beamTimeAfter(double t, double bearing) const;
+
+    uint64_t deadZoneTick(size_t index) const;
+    uint64_t detectionTick(size_t index) const;
+    uint64_t trackTick(size_t index) const;
+    uint64_t launchTick() const;
+    uint64_t timeLimitTick(float maxGameTime) const;
+
+    void enqueueNewMissiles();
+    template <typename Compute>
+    uint64_t refresh(std::vector<Pending>& heap, Compute compute);
+    uint64_t nextEventTick(float maxGameTime);
+
+public:
+    static const uint64_t NEVER = UINT64_MAX;
+
+    explicit EventEngine(SimulationState& state);
+
+    // Доигрывает игру, начатую state.initialize(config, RadarMode::Lockstep), шагом dt до конца или до maxGameTime -
+    // ровно там же, где остановился бы цикл "while (!isGameOver() && getGameTime() < maxGameTime) update(dt)".
+    EventEngineStats run(const GameConfig& config, float dt, float maxGameTime);
+};
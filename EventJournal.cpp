@@ -0,0 +1,290 @@
+#include "EventJournal.h" // Включаем заголовок журнала событий
+#include <cstring>
+#include <ctime>
+#include <limits>
+
+namespace journal {
+
+uint32_t launcherBit(int launcherId) {
+    if (launcherId < 0) return 0;
+    return launcherId < 31 ? (1u << launcherId) : (1u << 31);
+}
+
+void packConfig(const GameConfig& config, float* out) {
+    out[CFG_MISSILE_SPEED] = config.missile_speed;
+    out[CFG_DISTANCE_CORNER_CENTER] = config.distance_corner_center;
+    out[CFG_RADAR_SWEEP_SPEED] = config.radar_sweep_speed;
+    out[CFG_RADAR_TURNING_SPEED] = config.radar_turning_speed;
+    out[CFG_RADAR_BEAM_WIDTH] = config.radar_beam_width;
+    out[CFG_RADAR_RANGE] = config.radar_range;
+    out[CFG_RADAR_ENGAGEMENT_RADIUS] = config.radar_engagement_radius;
+    out[CFG_DANGER_ZONE_RADIUS] = config.danger_zone_radius;
+    out[CFG_RADAR_ACQUIRE_TIME] = config.radar_acquire_time;
+    out[CFG_RADAR_TRACK_CAPACITY] = static_cast<float>(config.radar_track_capacity);
+    out[CFG_TRACK_MEASUREMENT_SIGMA] = config.track_measurement_sigma;
+    out[CFG_TRACK_PROCESS_NOISE] = config.track_process_noise;
+    out[CFG_RADAR_FIRE_CHANNELS] = static_cast<float>(config.radar_fire_channels);
+    out[CFG_MAX_MISSILES] = static_cast<float>(config.max_missiles);
+}
+
+GameConfig unpackConfig(const float* in) {
+    GameConfig config;
+    config.missile_speed = in[CFG_MISSILE_SPEED];
+    config.distance_corner_center = in[CFG_DISTANCE_CORNER_CENTER];
+    config.radar_sweep_speed = in[CFG_RADAR_SWEEP_SPEED];
+    config.radar_turning_speed = in[CFG_RADAR_TURNING_SPEED];
+    config.radar_beam_width = in[CFG_RADAR_BEAM_WIDTH];
+    config.radar_range = in[CFG_RADAR_RANGE];
+    config.radar_engagement_radius = in[CFG_RADAR_ENGAGEMENT_RADIUS];
+    config.danger_zone_radius = in[CFG_DANGER_ZONE_RADIUS];
+    config.radar_acquire_time = in[CFG_RADAR_ACQUIRE_TIME];
+    config.radar_track_capacity = static_cast<int>(in[CFG_RADAR_TRACK_CAPACITY]);
+    config.track_measurement_sigma = in[CFG_TRACK_MEASUREMENT_SIGMA];
+    config.track_process_noise = in[CFG_TRACK_PROCESS_NOISE];
+    config.radar_fire_channels = static_cast<int>(in[CFG_RADAR_FIRE_CHANNELS]);
+    config.max_missiles = static_cast<int>(in[CFG_MAX_MISSILES]);
+    return config;
+}
+
+MissileLogEntry toLogEntry(const JournalEventRecord& record) {
+    MissileLogEntry entry = {};
+    entry.missileId = record.missileId;
+    entry.launcherId = record.launcherId;
+    entry.timestamp = record.timestamp;
+    entry.event = static_cast<MissileEvent>(record.event);
+    for (int i = 0; i < MissileLogEntry::DATA_LEN; ++i) entry.data[i] = record.data[i];
+    return entry;
+}
+
+static const char* const EVENT_KEYS[] = { "none", "launched", "detected", "destroyed", "lost_dead_zone", "radar_hit", "victory", "missed" };
+static_assert(sizeof(EVENT_KEYS) / sizeof(EVENT_KEYS[0]) == static_cast<size_t>(MissileEvent::Count), "EVENT_KEYS must cover MissileEvent");
+
+const char* eventKey(MissileEvent event) {
+    size_t i = static_cast<size_t>(event);
+    return i < static_cast<size_t>(MissileEvent::Count) ? EVENT_KEYS[i] : "unknown";
+}
+
+MissileEvent eventFromKey(const std::string& key) {
+    for (size_t i = 1; i < static_cast<size_t>(MissileEvent::Count); ++i) {
+        if (key == EVENT_KEYS[i]) return static_cast<MissileEvent>(i);
+    }
+    return MissileEvent::None;
+}
+
+// wchar_t (UTF-16 на Windows, UTF-32 на Linux) -> UTF-8.
+std::string toUtf8(const std::wstring& text) {
+    std::string out;
+    for (size_t i = 0; i < text.size(); ++i) {
+        uint32_t c = static_cast<uint32_t>(text[i]);
+        if (sizeof(wchar_t) == 2 && c >= 0xD800 && c <= 0xDBFF && i + 1 < text.size()) {
+            uint32_t low = static_cast<uint32_t>(text[i + 1]);
+            if (low >= 0xDC00 && low <= 0xDFFF) {
+                c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+                ++i;
+            }
+        }
+        if (c < 0x80) {
+            out += static_cast<char>(c);
+        }
+        else if (c < 0x800) {
+            out += static_cast<char>(0xC0 | (c >> 6));
+            out += static_cast<char>(0x80 | (c & 0x3F));
+        }
+        else if (c < 0x10000) {
+            out += static_cast<char>(0xE0 | (c >> 12));
+            out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (c & 0x3F));
+        }
+        else {
+            out += static_cast<char>(0xF0 | (c >> 18));
+            out += static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (c & 0x3F));
+        }
+    }
+    return out;
+}
+
+} // namespace journal
+
+using namespace journal;
+
+
+// --- Писатель ---
+
+JournalWriter::JournalWriter() :
+    m_file(nullptr), m_batchSlots(0), m_batchUsed(0), m_indexInterval(DEFAULT_INDEX_INTERVAL),
+    m_eventCount(0), m_blockEvents(0)
+{
+    std::memset(&m_block, 0, sizeof(m_block));
+}
+
+JournalWriter::~JournalWriter() {
+    close();
+}
+
+bool JournalWriter::open(const std::string& path, const GameConfig& config, uint32_t indexInterval, size_t batchSlots) {
+    close();
+    m_lastError.clear();
+
+    m_file = std::fopen(path.c_str(), "wb");
+    if (!m_file) {
+        m_lastError = "cannot create '" + path + "'";
+        return false;
+    }
+    std::setvbuf(m_file, nullptr, _IONBF, 0); // Буферизацию делаем сами пакетами слотов.
+
+    m_indexInterval = indexInterval ? indexInterval : DEFAULT_INDEX_INTERVAL;
+    m_batchSlots = batchSlots ? batchSlots : static_cast<size_t>(DEFAULT_BATCH_SLOTS);
+    m_batch.assign(m_batchSlots * SLOT_SIZE, 0); // Единственное выделение памяти писателя.
+    m_batchUsed = 0;
+    m_eventCount = 0;
+    m_blockEvents = 0;
+
+    JournalHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "RGJRNL\0\0", 8);
+    header.version = VERSION;
+    header.headerSize = HEADER_SIZE;
+    header.slotSize = SLOT_SIZE;
+    header.indexInterval = m_indexInterval;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.configCount = CFG_COUNT;
+    header.createdUnix = static_cast<int64_t>(std::time(nullptr));
+    packConfig(config, header.config);
+
+    if (std::fwrite(&header, sizeof(header), 1, m_file) != 1) {
+        m_lastError = "cannot write header to '" + path + "'";
+        std::fclose(m_file);
+        m_file = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void JournalWriter::putSlot(const void* slot) {
+    std::memcpy(m_batch.data() + m_batchUsed * SLOT_SIZE, slot, SLOT_SIZE);
+    if (++m_batchUsed == m_batchSlots) flush();
+}
+
+void JournalWriter::append(const MissileLogEntry& entry) {
+    if (!m_file) return;
+
+    JournalEventRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.type = SLOT_EVENT;
+    record.seq = m_eventCount;
+    record.timestamp = entry.timestamp;
+    record.missileId = entry.missileId;
+    record.launcherId = entry.launcherId;
+    record.event = static_cast<uint8_t>(entry.event);
+    for (int i = 0; i < MissileLogEntry::DATA_LEN; ++i) record.data[i] = entry.data[i];
+    putSlot(&record);
+
+    // Сводка блока для индекса.
+    if (m_blockEvents == 0) {
+        std::memset(&m_block, 0, sizeof(m_block));
+        m_block.type = SLOT_INDEX;
+        m_block.firstSeq = m_eventCount;
+        m_block.firstTimestamp = entry.timestamp;
+        m_block.minMissileId = std::numeric_limits<int32_t>::max();
+        m_block.maxMissileId = std::numeric_limits<int32_t>::min();
+    }
+    m_block.lastTimestamp = entry.timestamp;
+    if (entry.missileId < m_block.minMissileId) m_block.minMissileId = entry.missileId;
+    if (entry.missileId > m_block.maxMissileId) m_block.maxMissileId = entry.missileId;
+    m_block.launcherMask |= launcherBit(entry.launcherId);
+    m_block.eventMask |= 1u << (static_cast<uint32_t>(entry.event) & 31u);
+    ++m_eventCount;
+
+    if (++m_blockEvents == m_indexInterval) finishBlock();
+}
+
+void JournalWriter::finishBlock() {
+    m_block.eventCount = m_blockEvents;
+    putSlot(&m_block);
+    m_blockEvents = 0;
+}
+
+bool JournalWriter::flush() {
+    if (!m_file) return false;
+    if (m_batchUsed > 0) {
+        size_t written = std::fwrite(m_batch.data(), SLOT_SIZE, m_batchUsed, m_file);
+        if (written != m_batchUsed) {
+            m_lastError = "journal write failed";
+            m_batchUsed = 0;
+            return false;
+        }
+        m_batchUsed = 0;
+    }
+    return true;
+}
+
+void JournalWriter::close() {
+    if (!m_file) return;
+    flush(); // Незавершенный блок остается без индекса - читатель прочтет его подряд.
+    std::fclose(m_file);
+    m_file = nullptr;
+}
+
+
+// --- Читатель ---
+
+JournalReader::JournalReader() : m_header(nullptr), m_slotCount(0) {}
+
+bool JournalReader::open(const std::string& path) {
+    m_header = nullptr;
+    m_slotCount = 0;
+    m_lastError.clear();
+    if (!m_file.open(path, true)) {
+        m_lastError = m_file.lastError();
+        return false;
+    }
+    if (m_file.size() < HEADER_SIZE) {
+        m_lastError = "'" + path + "' is too small for a journal header";
+        return false;
+    }
+    const JournalHeader* header = reinterpret_cast<const JournalHeader*>(m_file.data());
+    if (std::memcmp(header->magic, "RGJRNL\0\0", 8) != 0) {
+        m_lastError = "'" + path + "' is not a RadarGame journal";
+        return false;
+    }
+    if (header->byteOrder != BYTE_ORDER_MARK) {
+        m_lastError = "'" + path + "' was written with a different byte order";
+        return false;
+    }
+    if (header->version != VERSION || header->headerSize != HEADER_SIZE || header->slotSize != SLOT_SIZE || header->indexInterval == 0) {
+        m_lastError = "'" + path + "' has an unsupported journal version";
+        return false;
+    }
+    m_header = header;
+    m_slotCount = (m_file.size() - HEADER_SIZE) / SLOT_SIZE; // Оборванный последний слот игнорируется.
+    return true;
+}
+
+uint32_t JournalReader::slotType(uint64_t i) const {
+    uint32_t type;
+    std::memcpy(&type, slot(i), sizeof(type));
+    return type;
+}
+
+// Журнал старой версии записал меньше параметров: недостающие - значения по умолчанию.
+GameConfig JournalReader::config() const {
+    GameConfig defaults;
+    defaults.setDefaults();
+    float values[CFG_COUNT];
+    packConfig(defaults, values);
+    uint32_t count = m_header->configCount < CFG_COUNT ? m_header->configCount : CFG_COUNT;
+    for (uint32_t i = 0; i < count; ++i) values[i] = m_header->config[i];
+    return unpackConfig(values);
+}
+
+
+std::string journalPathForGame(const std::string& basePath, int gameIndex) {
+    if (gameIndex <= 0) return basePath;
+    std::string suffix = "." + std::to_string(gameIndex);
+    size_t slash = basePath.find_last_of("/\\");
+    size_t dot = basePath.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return basePath + suffix;
+    return basePath.substr(0, dot) + suffix + basePath.substr(dot);
+}
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "GameConfig.h"
+#include "MissileLog.h"
+#include "MappedFile.h"
+
+// --- Бинарный журнал событий MissileLog (только дописывание) ---
+//
+// Формат файла (little-endian, все поля фиксированной ширины):
+//   JournalHeader (256 байт): сигнатура, версия, размер слота, интервал индекса, GameConfig игры.
+//   Далее слоты по 48 байт. Слот - либо событие (JournalEventRecord), либо запись индекса (JournalIndexRecord).
+//   После каждых indexInterval событий идет одна запись индекса, описывающая этот блок событий.
+//   Поэтому блок k занимает слоты [k * (indexInterval + 1), (k + 1) * (indexInterval + 1)), индекс - последний
+//   слот блока: читатель может пропустить весь блок по индексу, не читая событий. Последний неполный блок
+//   (или файл, оборванный аварийным завершением) индекса не имеет и читается подряд.
+//
+// Событие хранится кодом MissileEvent и числовыми параметрами; текст строится при чтении (formatMissileLogEntry).
+
+namespace journal {
+
+enum : uint32_t {
+    VERSION = 2,           // 2: коды событий вместо текста статуса
+    HEADER_SIZE = 256,
+    SLOT_SIZE = 48,
+    DEFAULT_INDEX_INTERVAL = 4096,
+    CONFIG_FLOATS = 32,    // Место под параметры GameConfig в заголовке
+    BYTE_ORDER_MARK = 0x01020304u
+};
+
+enum SlotType : uint32_t {
+    SLOT_EVENT = 1,
+    SLOT_INDEX = 2
+};
+
+// Порядок параметров GameConfig в JournalHeader::config.
+enum ConfigField : uint32_t {
+    CFG_MISSILE_SPEED,
+    CFG_DISTANCE_CORNER_CENTER,
+    CFG_RADAR_SWEEP_SPEED,        // рад/с
+    CFG_RADAR_TURNING_SPEED,      // рад/с
+    CFG_RADAR_BEAM_WIDTH,         // рад
+    CFG_RADAR_RANGE,
+    CFG_RADAR_ENGAGEMENT_RADIUS,
+    CFG_DANGER_ZONE_RADIUS,
+    CFG_RADAR_ACQUIRE_TIME,
+    CFG_RADAR_TRACK_CAPACITY,     // Целое (точно в float до 2^24)
+    CFG_TRACK_MEASUREMENT_SIGMA,
+    CFG_TRACK_PROCESS_NOISE,
+    CFG_RADAR_FIRE_CHANNELS,      // Целое
+    CFG_MAX_MISSILES,             // Целое (0 - по distance_corner_center)
+    CFG_COUNT
+};
+
+#pragma pack(push, 1)
+struct JournalHeader {
+    char magic[8];            // "RGJRNL\0\0"
+    uint32_t version;
+    uint32_t headerSize;      // HEADER_SIZE
+    uint32_t slotSize;        // SLOT_SIZE
+    uint32_t indexInterval;   // Событий в блоке
+    uint32_t byteOrder;       // BYTE_ORDER_MARK в порядке байт писателя
+    uint32_t configCount;     // Сколько элементов config заполнено (CFG_COUNT)
+    int64_t createdUnix;      // Время создания (секунды Unix)
+    float config[CONFIG_FLOATS];
+    uint8_t reserved[HEADER_SIZE - 40 - CONFIG_FLOATS * 4];
+};
+
+struct JournalEventRecord {
+    uint32_t type;            // SLOT_EVENT
+    uint8_t event;            // MissileEvent
+    uint8_t reserved[3];
+    uint64_t seq;             // Сквозной номер события в журнале
+    float timestamp;          // Игровое время
+    int32_t missileId;
+    int32_t launcherId;
+    float data[MissileLogEntry::DATA_LEN]; // Параметры события (см. MissileEvent)
+};
+
+struct JournalIndexRecord {
+    uint32_t type;            // SLOT_INDEX
+    uint32_t eventCount;      // Событий в блоке (всегда indexInterval)
+    uint64_t firstSeq;        // Номер первого события блока
+    float firstTimestamp;
+    float lastTimestamp;
+    int32_t minMissileId;     // Диапазон ID ракет в блоке (-1 учитывается: события без ракеты)
+    int32_t maxMissileId;
+    uint32_t launcherMask;    // Бит n - в блоке есть события пусковой n (n < 31), бит 31 - пусковые >= 31
+    uint32_t eventMask;       // Бит n - в блоке есть события с кодом n
+    uint8_t reserved[SLOT_SIZE - 40];
+};
+#pragma pack(pop)
+
+static_assert(sizeof(JournalHeader) == HEADER_SIZE, "JournalHeader size");
+static_assert(sizeof(JournalEventRecord) == SLOT_SIZE, "JournalEventRecord size");
+static_assert(sizeof(JournalIndexRecord) == SLOT_SIZE, "JournalIndexRecord size");
+
+uint32_t launcherBit(int launcherId);
+
+// Параметры GameConfig <-> массив из CFG_COUNT чисел (порядок ConfigField). Используется и записью ввода (InputRecording.h).
+void packConfig(const GameConfig& config, float* out);
+GameConfig unpackConfig(const float* in);
+
+// Запись журнала -> запись лога (для форматирования текста).
+MissileLogEntry toLogEntry(const JournalEventRecord& record);
+
+// Короткий ASCII-ключ кода события ("launched", "detected", ...) и обратно (MissileEvent::None, если неизвестен).
+const char* eventKey(MissileEvent event);
+MissileEvent eventFromKey(const std::string& key);
+
+// wchar_t-строка -> UTF-8 (для вывода в консоль).
+std::string toUtf8(const std::wstring& text);
+
+} // namespace journal
+
+
+// --- Писатель журнала ---
+// append() копирует событие в буфер пакета; в файл пакет уходит одним fwrite, когда заполнится,
+// и при flush()/close(). Индекс блока пишется сам после каждых indexInterval событий.
+// Не потокобезопасен: вызывается одним потоком (SimulationState, поток симуляции).
+class JournalWriter {
+private:
+    std::FILE* m_file;
+    std::vector<uint8_t> m_batch;   // Пакет слотов для одной записи в файл
+    size_t m_batchSlots;            // Емкость пакета в слотах
+    size_t m_batchUsed;             // Занято слотов
+    uint32_t m_indexInterval;
+    uint64_t m_eventCount;          // Всего событий записано
+    journal::JournalIndexRecord m_block; // Сводка текущего блока
+    uint32_t m_blockEvents;
+    std::string m_lastError;
+
+    void putSlot(const void* slot);
+    void finishBlock();
+
+public:
+    enum { DEFAULT_BATCH_SLOTS = 1024 };
+
+    JournalWriter();
+    ~JournalWriter();
+
+    JournalWriter(const JournalWriter&) = delete;
+    JournalWriter& operator=(const JournalWriter&) = delete;
+
+    // Создает (перезаписывает) файл и пишет заголовок с параметрами config.
+    bool open(const std::string& path, const GameConfig& config,
+              uint32_t indexInterval = journal::DEFAULT_INDEX_INTERVAL, size_t batchSlots = DEFAULT_BATCH_SLOTS);
+    void append(const MissileLogEntry& entry);
+    bool flush();
+    void close();
+
+    bool isOpen() const { return m_file != nullptr; }
+    uint64_t eventCount() const { return m_eventCount; }
+    const std::string& lastError() const { return m_lastError; }
+};
+
+
+// --- Читатель журнала (через MappedFile) ---
+class JournalReader {
+private:
+    MappedFile m_file;
+    const journal::JournalHeader* m_header;
+    uint64_t m_slotCount;
+    std::string m_lastError;
+
+public:
+    JournalReader();
+
+    bool open(const std::string& path);
+    const journal::JournalHeader& header() const { return *m_header; }
+    const std::string& lastError() const { return m_lastError; }
+
+    uint64_t slotCount() const { return m_slotCount; }
+    const uint8_t* slot(uint64_t i) const { return m_file.data() + journal::HEADER_SIZE + i * journal::SLOT_SIZE; }
+    uint32_t slotType(uint64_t i) const;
+
+    // Параметры игры из заголовка.
+    GameConfig config() const;
+
+    // Обход событий по порядку. skipBlock(const JournalIndexRecord&) решает по индексу, можно ли пропустить блок целиком;
+    // onEvent(const JournalEventRecord&) получает каждое непропущенное событие. Возвращает число пропущенных блоков.
+    template <typename SkipBlock, typename OnEvent>
+    uint64_t forEachEvent(SkipBlock&& skipBlock, OnEvent&& onEvent) const {
+        const uint64_t blockSlots = static_cast<uint64_t>(m_header->indexInterval) + 1;
+        uint64_t skipped = 0;
+        uint64_t i = 0;
+        while (i < m_slotCount) {
+            // Полный блок с индексом в последнем слоте?
+            uint64_t indexSlot = i + blockSlots - 1;
+            if (i % blockSlots == 0 && indexSlot < m_slotCount && slotType(indexSlot) == journal::SLOT_INDEX) {
+                const journal::JournalIndexRecord& index = *reinterpret_cast<const journal::JournalIndexRecord*>(slot(indexSlot));
+                if (skipBlock(index)) {
+                    ++skipped;
+                    i = indexSlot + 1;
+                    continue;
+                }
+            }
+            if (slotType(i) == journal::SLOT_EVENT) {
+                onEvent(*reinterpret_cast<const journal::JournalEventRecord*>(slot(i)));
+            }
+            ++i;
+        }
+        return skipped;
+    }
+};
+
+// Имя файла журнала для игры номер gameIndex: "events.rgj" -> "events.rgj" (0), "events.1.rgj" (1), ...
+std::string journalPathForGame(const std::string& basePath, int gameIndex);
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+// --- Кольцо событий фиксированной емкости: много писателей, чтение без блокировок ---
+// Каждая запись получает сквозной номер (ticket) через fetch_add и кладется в слот ticket % capacity.
+// Когда кольцо заполнено, новая запись затирает самую старую. Память выделяется один раз в конструкторе,
+// push() не берет блокировок и не выделяет память.
+//
+// У каждого слота свой счетчик-seqlock: 2*ticket + 1 - идет запись, 2*ticket + 2 - запись ticket готова.
+// Читатель копирует слот и проверяет счетчик до и после, поэтому видит либо целую запись, либо узнает,
+// что она еще пишется или уже затерта. Данные лежат в атомарных словах (relaxed), как в Seqlock.h.
+//
+// Два писателя сталкиваются на одном слоте, только если их номера отличаются на capacity,
+// т.е. кольцо обернулось целиком за время одной записи. Тогда младший ждет старшего (yield),
+// а запись, которую уже опередил следующий круг, отбрасывается (счетчик dropped()).
+template <typename T>
+class EventRing {
+    static_assert(std::is_trivially_copyable<T>::value, "EventRing<T> requires a trivially copyable T");
+
+private:
+    enum { WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t) };
+
+    struct Slot {
+        std::atomic<uint64_t> seq;
+        std::atomic<uint64_t> words[WORDS];
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    uint64_t m_mask;
+    std::atomic<uint64_t> m_head;    // Номер следующей записи
+    std::atomic<uint64_t> m_base;    // Первый видимый номер (clear() сдвигает его к m_head)
+    std::atomic<uint64_t> m_dropped; // Записи, отброшенные при столкновении писателей
+
+    static uint64_t roundUpPow2(uint64_t n) {
+        uint64_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+public:
+    // Результат чтения записи по номеру.
+    enum ReadResult { READY, PENDING, OVERWRITTEN };
+
+    // capacity округляется вверх до степени двойки.
+    explicit EventRing(size_t capacity)
+        : m_slots(new Slot[roundUpPow2(capacity ? capacity : 1)]),
+          m_mask(roundUpPow2(capacity ? capacity : 1) - 1),
+          m_head(0), m_base(0), m_dropped(0) {
+        for (uint64_t i = 0; i <= m_mask; ++i) {
+            m_slots[i].seq.store(0, std::memory_order_relaxed);
+            for (int w = 0; w < WORDS; ++w) m_slots[i].words[w].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    EventRing(const EventRing&) = delete;
+    EventRing& operator=(const EventRing&) = delete;
+
+    size_t capacity() const { return static_cast<size_t>(m_mask + 1); }
+    uint64_t head() const { return m_head.load(std::memory_order_acquire); }
+    uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    // Самый старый номер, который еще может быть в кольце.
+    uint64_t oldest() const {
+        uint64_t h = head();
+        uint64_t b = m_base.load(std::memory_order_acquire);
+        uint64_t lap = h > m_mask + 1 ? h - (m_mask + 1) : 0;
+        return b > lap ? b : lap;
+    }
+
+    // Делает все записанные до сих пор события невидимыми. Безопасно при работающих писателях.
+    void clear() { m_base.store(m_head.load(std::memory_order_acquire), std::memory_order_release); }
+
+    // --- Запись (любой поток) ---
+    void push(const T& value) {
+        uint64_t ticket = m_head.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = m_slots[ticket & m_mask];
+        const uint64_t writing = 2 * ticket + 1;
+
+        uint64_t cur = slot.seq.load(std::memory_order_relaxed);
+        for (;;) {
+            if (cur >= writing) { // Слот уже занял следующий круг - наша запись устарела.
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            if (cur & 1u) { // Предыдущий круг еще пишет этот слот.
+                std::this_thread::yield();
+                cur = slot.seq.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (slot.seq.compare_exchange_weak(cur, writing, std::memory_order_acquire, std::memory_order_relaxed)) break;
+        }
+        std::atomic_thread_fence(std::memory_order_release); // Нечетный счетчик виден раньше новых данных.
+
+        uint64_t buf[WORDS] = {};
+        std::memcpy(buf, &value, sizeof(T));
+        for (int w = 0; w < WORDS; ++w) slot.words[w].store(buf[w], std::memory_order_relaxed);
+
+        slot.seq.store(writing + 1, std::memory_order_release);
+    }
+
+    // --- Чтение (любой поток, кольцо не меняется) ---
+    ReadResult read(uint64_t ticket, T& out) const {
+        if (ticket < m_base.load(std::memory_order_acquire)) return OVERWRITTEN;
+        const Slot& slot = m_slots[ticket & m_mask];
+        const uint64_t ready = 2 * ticket + 2;
+        uint64_t before = slot.seq.load(std::memory_order_acquire);
+        if (before < ready) return PENDING;
+        if (before > ready) return OVERWRITTEN;
+
+        uint64_t buf[WORDS];
+        for (int w = 0; w < WORDS; ++w) buf[w] = slot.words[w].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != ready) return OVERWRITTEN;
+        std::memcpy(&out, buf, sizeof(T));
+        return READY;
+    }
+
+    // Последовательный потребитель: отдает f(const T&) записи начиная с cursor, пока они готовы,
+    // и сдвигает cursor. Затертые записи пропускаются; возвращает их число.
+    template <typename F>
+    uint64_t consume(uint64_t& cursor, F&& f) const {
+        uint64_t lost = 0;
+        uint64_t first = oldest();
+        if (cursor < first) { lost += first - cursor; cursor = first; }
+        uint64_t h = head();
+        T value;
+        while (cursor < h) {
+            ReadResult r = read(cursor, value);
+            if (r == PENDING) break; // Писатель еще не закончил - продолжим в следующий раз.
+            if (r == READY) f(value);
+            else ++lost;
+            ++cursor;
+        }
+        return lost;
+    }
+
+    // Обход от новых записей к старым; f(const T&) возвращает false, чтобы остановиться.
+    // Недописанные и затертые записи пропускаются.
+    template <typename F>
+    void forEachNewest(F&& f) const {
+        uint64_t first = oldest();
+        T value;
+        for (uint64_t t = head(); t > first; --t) {
+            if (read(t - 1, value) == READY && !f(value)) return;
+        }
+    }
+};
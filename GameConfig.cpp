@@ -5,18 +5,34 @@
 #include <fstream>      // Для std::ifstream
 #include <algorithm>    // Для erase, remove_if
 #include <stdexcept>    // Для std::stof
-
-GameConfig g_config; // Определение глобальной переменной конфигурации.
-
-// --- Метод для загрузки конфигурации из файла ---
-bool GameConfig::loadFromFile(const std::string& filename) {
-    std::ifstream infile(filename);
-    if (!infile.is_open()) {
-        MessageBox(NULL, L"Ошибка: файл конфигурации 'radar_config.txt' не найден или не открывается!", L"Ошибка конфигурации", MB_OK | MB_ICONERROR);
-        return false;
+#include <cstdlib>      // Для std::atoi
+#include <cmath>        // Для std::lround, std::isfinite
+
+const char* const GameConfig::NUMERIC_KEYS[] = {
+    "missile_speed", "distance_corner_center", "radar_sweep_speed", "radar_turning_speed", "radar_beam_width",
+    "radar_range", "radar_engagement_radius", "danger_zone_radius", "radar_acquire_time",
+    "track_measurement_sigma", "track_process_noise", "radar_track_capacity", "radar_fire_channels", "max_missiles"
+};
+const int GameConfig::NUMERIC_KEY_COUNT = static_cast<int>(sizeof(NUMERIC_KEYS) / sizeof(NUMERIC_KEYS[0]));
+
+const char* radarModeName(RadarMode mode) {
+    switch (mode) {
+    case RadarMode::Threaded: return "threaded";
+    case RadarMode::Pipelined: return "pipelined";
+    default: return "lockstep";
     }
+}
+
+bool parseRadarMode(const std::string& text, RadarMode& mode) {
+    if (text == "lockstep") mode = RadarMode::Lockstep;
+    else if (text == "threaded") mode = RadarMode::Threaded;
+    else if (text == "pipelined") mode = RadarMode::Pipelined;
+    else return false;
+    return true;
+}
 
-    // --- Значения по умолчанию ---
+// --- Значения по умолчанию ---
+void GameConfig::setDefaults() {
     missile_speed = 75.0f;
     distance_corner_center = 400.0f;
 
@@ -29,8 +45,94 @@ bool GameConfig::loadFromFile(const std::string& filename) {
 
     radar_turning_speed = DEG_TO_RAD(180.0f); // Углы в градусах в файле, храним в радианах (не используется)
     radar_acquire_time = 0.2f;             // (не используется)
+    event_journal.clear();                 // Журнал выключен
+    input_recording.clear();               // Запись ввода выключена
+    radar_mode = RadarMode::Lockstep;      // Радар - стадия шага симуляции
+    radar_sites.clear();                   // Только основной радар
+    scenario.clear();                      // Запуски по расписанию
+    launchers.clear();                     // Четыре пусковые по углам
+    max_missiles = 0;                      // Число ракет - по distance_corner_center
+    radar_scan_threads = 0;                // По числу ядер
+    radar_track_capacity = 1;              // Одна цель на радар
+    radar_fire_channels = 0;               // Каждый радар сбивает свои цели без ограничения
+    track_measurement_sigma = 0.5f;        // Позиция из снимка точная: фильтр почти не сглаживает
+    track_process_noise = 1.0f;            // Ракеты летят прямо: маневров почти нет
+}
+
+RadarSite GameConfig::primarySite() const {
+    RadarSite site;
+    site.pos = { 0.0f, 0.0f };
+    site.sweepSpeed = radar_sweep_speed;
+    site.beamWidth = radar_beam_width;
+    site.range = radar_range;
+    site.engagementRadius = radar_engagement_radius;
+    site.deadZoneRadius = danger_zone_radius;
+    return site;
+}
+
+int GameConfig::missileBudget() const {
+    if (max_missiles > 0) return max_missiles;
+    int budget = static_cast<int>(distance_corner_center / 10.0f);
+    if (budget < 5) budget = 5;    // Гарантируем минимум 5 ракет.
+    if (budget > 50) budget = 50;  // Ограничиваем максимум, чтобы не перегружать симуляцию.
+    return budget;
+}
+
+TrackFilterParams GameConfig::trackFilter() const {
+    TrackFilterParams filter;
+    filter.measurementVar = track_measurement_sigma * track_measurement_sigma;
+    filter.processNoise = track_process_noise;
+    float speed = 2.0f * missile_speed;
+    filter.initialVelocityVar = speed * speed;
+    return filter;
+}
+
+// --- Установка числового параметра по ключу файла ---
+// Целый параметр из числа перебора: округление до ближайшего, вне [minValue, maxValue] - отказ.
+static bool setIntValue(int& field, float value, int minValue, int maxValue) {
+    if (!std::isfinite(value)) return false;
+    long rounded = std::lround(value);
+    if (rounded < minValue || rounded > maxValue) return false;
+    field = static_cast<int>(rounded);
+    return true;
+}
+
+bool GameConfig::setValue(const std::string& key, float value) {
+    if (key == "missile_speed") missile_speed = value;
+    else if (key == "distance_corner_center") distance_corner_center = value;
+    // --- <<< ИСПРАВЛЕНИЕ: Чтение угловых параметров в радианах >>> ---
+    else if (key == "radar_sweep_speed") radar_sweep_speed = DEG_TO_RAD(value);
+    else if (key == "radar_turning_speed") radar_turning_speed = DEG_TO_RAD(value);
+    else if (key == "radar_beam_width") radar_beam_width = DEG_TO_RAD(value);
+    // --- <<< Конец исправления >>> ---
+    else if (key == "radar_acquire_time") radar_acquire_time = value;
+    else if (key == "danger_zone_radius") danger_zone_radius = value;
+    else if (key == "radar_range") radar_range = value;
+    else if (key == "radar_engagement_radius") radar_engagement_radius = value;
+    else if (key == "track_measurement_sigma") track_measurement_sigma = value;
+    else if (key == "track_process_noise") track_process_noise = value;
+    else if (key == "radar_track_capacity") return setIntValue(radar_track_capacity, value, 1, MAX_TRACK_CAPACITY);
+    else if (key == "radar_fire_channels") return setIntValue(radar_fire_channels, value, 0, MAX_FIRE_CHANNELS);
+    else if (key == "max_missiles") return setIntValue(max_missiles, value, 0, MAX_MISSILES);
+    else return false;
+    return true;
+}
+
+// --- Метод для загрузки конфигурации из файла ---
+bool GameConfig::loadFromFile(const std::string& filename) {
+    lastError.clear();
+    std::ifstream infile(filename);
+    if (!infile.is_open()) {
+        lastError = L"Ошибка: файл конфигурации '" + std::wstring(filename.begin(), filename.end()) + L"' не найден или не открывается!";
+        return false;
+    }
 
+    setDefaults();
 
+    // Строки radar_site разбираются после всего файла: пропущенные параметры берутся у основного радара,
+    // а его ключи могут стоять ниже.
+    std::vector<std::vector<float>> siteValues;
+    std::vector<std::vector<float>> launcherValues;
     std::string line;
 
     while (std::getline(infile, line)) {
@@ -46,21 +148,29 @@ bool GameConfig::loadFromFile(const std::string& filename) {
             value_str.erase(0, value_str.find_first_not_of(" \t"));
             value_str.erase(value_str.find_last_not_of(" \t") + 1);
 
-            try {
-                float value = std::stof(value_str);
-
-                if (key == "missile_speed") missile_speed = value;
-                else if (key == "distance_corner_center") distance_corner_center = value;
-                // --- <<< ИСПРАВЛЕНИЕ: Чтение угловых параметров в радианах >>> ---
-                else if (key == "radar_sweep_speed") radar_sweep_speed = DEG_TO_RAD(value);
-                else if (key == "radar_turning_speed") radar_turning_speed = DEG_TO_RAD(value);
-                else if (key == "radar_beam_width") radar_beam_width = DEG_TO_RAD(value);
-                // --- <<< Конец исправления >>> ---
-                else if (key == "radar_acquire_time") radar_acquire_time = value;
-                else if (key == "danger_zone_radius") danger_zone_radius = value;
-                else if (key == "radar_range") radar_range = value;
-                else if (key == "radar_engagement_radius") radar_engagement_radius = value;
+            // Строковые параметры
+            if (key == "event_journal") { event_journal = value_str; continue; }
+            if (key == "input_recording") { input_recording = value_str; continue; }
+            if (key == "scenario") { scenario = value_str; continue; }
+            if (key == "radar_mode") { parseRadarMode(value_str, radar_mode); continue; } // Неизвестное значение игнорируется
+            if (key == "radar_scan_threads") { radar_scan_threads = std::atoi(value_str.c_str()); continue; }
+            if (key == "radar_track_capacity") { radar_track_capacity = std::atoi(value_str.c_str()); continue; }
+            if (key == "radar_fire_channels") { radar_fire_channels = std::atoi(value_str.c_str()); continue; }
+            if (key == "max_missiles") { max_missiles = std::atoi(value_str.c_str()); continue; }
+            if (key == "radar_site" || key == "launcher") {
+                std::vector<float> values;
+                std::istringstream fields(value_str);
+                std::string field;
+                while (std::getline(fields, field, ',')) {
+                    try { values.push_back(std::stof(field)); }
+                    catch (const std::exception&) { values.clear(); break; } // Некорректная строка игнорируется
+                }
+                if (values.size() >= 2) (key == "launcher" ? launcherValues : siteValues).push_back(values);
+                continue;
+            }
 
+            try {
+                setValue(key, std::stof(value_str));
             }
             catch (const std::exception&) {
                 // Игнорируем некорректные строки.
@@ -69,7 +179,30 @@ bool GameConfig::loadFromFile(const std::string& filename) {
     }
     infile.close();
 
-    // --- Валидация ---
+    for (const std::vector<float>& v : siteValues) {
+        RadarSite site = primarySite();
+        site.pos = { v[0], v[1] };
+        if (v.size() > 2) site.sweepSpeed = DEG_TO_RAD(v[2]);
+        if (v.size() > 3) site.beamWidth = DEG_TO_RAD(v[3]);
+        if (v.size() > 4) site.range = v[4];
+        if (v.size() > 5) site.engagementRadius = v[5];
+        if (v.size() > 6) site.deadZoneRadius = v[6];
+        radar_sites.push_back(site);
+    }
+    for (const std::vector<float>& v : launcherValues) {
+        LauncherSite launcher;
+        launcher.pos = { v[0], v[1] };
+        launcher.minInterval = v.size() > 2 ? v[2] : 2.0f;
+        launcher.maxInterval = v.size() > 3 ? v[3] : (v.size() > 2 ? v[2] : 6.0f); // Один интервал - постоянный темп
+        launchers.push_back(launcher);
+    }
+
+    return validate();
+}
+
+// --- Валидация ---
+bool GameConfig::validate() {
+    lastError.clear();
     bool validation_failed = false;
     std::wstring error_msg = L"Ошибка: Некорректные значения в файле конфигурации или дефолтах!\n";
 
@@ -83,9 +216,32 @@ bool GameConfig::loadFromFile(const std::string& filename) {
     if (radar_engagement_radius <= danger_zone_radius) { error_msg += L"- Радиус поражения должен быть строго больше радиуса мертвой зоны.\n"; validation_failed = true; }
     if (radar_range <= radar_engagement_radius) { error_msg += L"- Радиус внешнего (зеленого) круга должен быть строго больше радиуса поражения.\n"; validation_failed = true; }
 
+    if (!(track_measurement_sigma >= 0.0f)) { error_msg += L"- track_measurement_sigma не может быть отрицательным.\n"; validation_failed = true; }
+    if (!(track_process_noise >= 0.0f)) { error_msg += L"- track_process_noise не может быть отрицательным.\n"; validation_failed = true; }
+    if (radar_track_capacity < 1 || radar_track_capacity > MAX_TRACK_CAPACITY) { error_msg += L"- radar_track_capacity должен быть от 1 до " + std::to_wstring(MAX_TRACK_CAPACITY) + L".\n"; validation_failed = true; }
+    if (radar_fire_channels < 0 || radar_fire_channels > MAX_FIRE_CHANNELS) { error_msg += L"- radar_fire_channels должен быть от 0 до " + std::to_wstring(MAX_FIRE_CHANNELS) + L".\n"; validation_failed = true; }
+
+    if (max_missiles < 0 || max_missiles > MAX_MISSILES) { error_msg += L"- max_missiles должен быть от 0 до " + std::to_wstring(MAX_MISSILES) + L".\n"; validation_failed = true; }
+    for (size_t i = 0; i < launchers.size(); ++i) {
+        if (!(launchers[i].minInterval > 0.0f) || !(launchers[i].maxInterval >= launchers[i].minInterval)) {
+            error_msg += L"- launcher " + std::to_wstring(i + 1) + L": интервал запусков - 0 < min_interval <= max_interval.\n";
+            validation_failed = true;
+        }
+    }
+
+    // Дополнительные радары - те же правила.
+    for (size_t i = 0; i < radar_sites.size(); ++i) {
+        const RadarSite& site = radar_sites[i];
+        if (site.sweepSpeed <= 0.0f || site.beamWidth <= 0.0f || site.deadZoneRadius < 0.0f ||
+            site.engagementRadius <= site.deadZoneRadius || site.range <= site.engagementRadius) {
+            error_msg += L"- radar_site " + std::to_wstring(i + 1) + L": скорость и ширина луча должны быть > 0, радиусы - 0 <= мертвая зона < поражение < дальность.\n";
+            validation_failed = true;
+        }
+    }
+
 
     if (validation_failed) {
-        MessageBox(NULL, error_msg.c_str(), L"Ошибка конфигурации", MB_OK | MB_ICONERROR);
+        lastError = error_msg;
         return false;
     }
 
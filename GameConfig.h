@@ -1,10 +1,43 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <fstream>
 #include <sstream>
-#include <windows.h>
 #include "Point.h" // Для DEG_TO_RAD
+#include "TrackFilter.h"
+
+// Где сканирует радар (ключ radar_mode).
+enum class RadarMode {
+    Lockstep,   // "lockstep": шаг радара - стадия update() по игровому времени; результат воспроизводим
+    Threaded,   // "threaded": свой поток по настенным часам (прежний режим, для сравнения)
+    Pipelined   // "pipelined": как lockstep, но стадия радара тика N идет на втором ядре вместе с тиком N+1
+};
+
+const char* radarModeName(RadarMode mode);
+bool parseRadarMode(const std::string& text, RadarMode& mode); // false - неизвестное значение
+
+// --- Позиция и параметры одного радара (углы - в радианах) ---
+// Основной радар стоит на базе (0,0) и задается прежними ключами radar_*; дополнительные - строками
+// radar_site = x, y[, скорость, ширина луча, дальность, радиус поражения, радиус мертвой зоны]
+// (единицы как у ключей radar_*; пропущенные параметры берутся у основного радара).
+struct RadarSite {
+    Point pos;
+    float sweepSpeed;
+    float beamWidth;
+    float range;
+    float engagementRadius;
+    float deadZoneRadius;
+};
+
+// --- Пусковая установка (ключ launcher) ---
+// launcher = x, y[, min_interval, max_interval]: позиция и интервал между запусками этой пусковой, с
+// (равномерно в [min_interval, max_interval]; по умолчанию 2 - 6 с, как у общего расписания).
+struct LauncherSite {
+    Point pos;
+    float minInterval;
+    float maxInterval;
+};
 
 // --- Конфигурация игры ---
 struct GameConfig {
@@ -17,8 +50,43 @@ struct GameConfig {
     float radar_engagement_radius;  // Радиус среднего ЖЕЛТОГО круга (поражения)
     float danger_zone_radius;       // Радиус внутреннего КРАСНОГО круга (мертвая зона)
     float radar_acquire_time;       // Пока не используется
+    std::string event_journal;      // Путь бинарного журнала событий (пусто - журнал не пишется)
+    std::string input_recording;    // Путь записи ввода для точного повтора (пусто - не пишется), см. InputRecording.h
+    RadarMode radar_mode;           // Режим радара окна (пакетные прогоны - Lockstep, BatchRunner --radar)
+    std::vector<RadarSite> radar_sites; // Дополнительные радары (ключ radar_site, может повторяться)
+    std::string scenario;           // Файл сценария (ScenarioFile.h): пусковые и все запуски; пусто - запуски по расписанию
+    std::vector<LauncherSite> launchers; // Пусковые (ключ launcher, может повторяться); пусто - четыре угла с общим расписанием
+    int max_missiles;               // Ракет за игру (0 - по distance_corner_center, см. missileBudget())
+    int radar_scan_threads;         // Потоков сканирования при нескольких радарах (0 - по числу ядер)
+    int radar_track_capacity;       // Целей, сопровождаемых одним радаром одновременно (TrackTable.h)
+    int radar_fire_channels;        // Огневых каналов у каждого радара (0 - без ограничения, AuctionSolver.h)
+    float track_measurement_sigma;  // СКО измерения позиции фильтром сопровождения, px (TrackFilter.h)
+    float track_process_noise;      // Спектральная плотность шума ускорения цели, px^2/s^3
+
+    std::wstring lastError;         // Текст ошибки последней загрузки (показывает вызывающий код)
 
     bool loadFromFile(const std::string& filename);
+    void setDefaults();
+    // Числовой параметр по имени ключа файла, в единицах файла (углы - в градусах). Целые ключи округляются.
+    // false - ключ неизвестен или целое значение вне допустимых пределов (поле не меняется).
+    bool setValue(const std::string& key, float value);
+    // Проверка значений и взаимного расположения зон; текст ошибок - в lastError.
+    bool validate();
+
+    // Основной радар (база) по ключам radar_*.
+    RadarSite primarySite() const;
+    size_t radarCount() const { return radar_sites.size() + 1; }
+    // Ракет за игру: max_missiles или, если 0, distance_corner_center / 10 в пределах 5 - 50.
+    int missileBudget() const;
+    // Параметры фильтра сопровождения; априорная скорость цели - до удвоенной missile_speed.
+    TrackFilterParams trackFilter() const;
+
+    // Имена числовых ключей файла (для перебора параметров, см. SweepRunner.cpp).
+    static const char* const NUMERIC_KEYS[];
+    static const int NUMERIC_KEY_COUNT;
+    enum { MAX_TRACK_CAPACITY = 1 << 20 }; // Предел radar_track_capacity (таблица выделяется целиком)
+    enum { MAX_FIRE_CHANNELS = 1 << 16 };  // Предел radar_fire_channels
+    enum { MAX_MISSILES = 1 << 24 };       // Предел max_missiles (ID ракет и запись ввода - точно в float)
 };
 
-extern GameConfig g_config;
+extern GameConfig g_config; // Конфигурация оконной версии, определяется в main.cpp (логика симуляции ее не использует)
@@ -0,0 +1,374 @@
+// --- GDI-отрисовка объектов симуляции (только Windows) ---
+// Логика симуляции (Missile, Launcher, Radar, SimulationState) не зависит от <windows.h>
+// и собирается без окна (см. BatchRunner.cpp). Здесь собраны все методы draw(),
+// которые нужны только оконному приложению main.cpp.
+// Рисуется только RenderFrame - копия состояния, опубликованная потоком симуляции (SimulationThread.h):
+// к SimulationState и Radar отрисовка не обращается, блокировки не нужны.
+#define NOMINMAX
+#include <windows.h>
+#include "Missile.h"
+#include "Launcher.h"
+#include "Radar.h"
+#include "RenderFrame.h"
+#include "BeamKernel.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <sstream>
+#include <iomanip>
+
+
+// --- Метод отрисовки пусковой установки (Синий квадрат) ---
+// Сигнатура должна соответствовать объявлению в Launcher.h
+void Launcher::draw(HDC hdc, int winCenterX, int winCenterY) const { // <<< ИСПРАВЛЕНИЕ ОЧЕПЯТКИ в сигнатуре draw
+
+    // Определяем цвет и размер квадратика (Синий, как на скриншоте)
+    COLORREF launcherColor = RGB(0, 0, 255); // Ярко-синий
+    int size_px = 15; // Размер стороны квадрата в пикселях. Подберите.
+
+    // Рассчитываем экранные координаты центра пусковой установки
+    int screenX = static_cast<int>(pos.x + winCenterX);
+    int screenY = static_cast<int>(-pos.y + winCenterY); // Инверсия Y
+
+    // Рассчитываем координаты углов квадрата
+    int left = screenX - size_px / 2;
+    int top = screenY - size_px / 2;
+    int right = screenX + size_px - size_px / 2;
+    int bottom = screenY + size_px - size_px / 2;
+
+    // --- Создаем GDI объекты ---
+    HBRUSH hBrush = CreateSolidBrush(launcherColor); // Кисть для заливки
+    HPEN hPen = CreatePen(PS_SOLID, 1, RGB(0, 0, 0)); // Перо для контура (черный)
+
+    // --- Сохраняем текущие и выбираем наши ---
+    HBRUSH hOldBrush = (HBRUSH)SelectObject(hdc, hBrush);
+    HPEN hOldPen = (HPEN)SelectObject(hdc, hPen);
+
+    // --- Рисуем квадрат ---
+    Rectangle(hdc, left, top, right, bottom);
+
+    // --- Восстанавливаем старые ---
+    SelectObject(hdc, hOldBrush);
+    SelectObject(hdc, hOldPen);
+
+    // --- Удаляем созданные ---
+    DeleteObject(hBrush);
+    DeleteObject(hPen);
+}
+
+
+// --- Метод draw: отрисовывает ракету (Цветной кружок) ---
+void Missile::draw(HDC hdc, int winCenterX, int winCenterY) const {
+    if (isActive) {
+        int screenX = static_cast<int>(pos.x + winCenterX);
+        int screenY = static_cast<int>(-pos.y + winCenterY); // Инверсия Y для экрана
+
+        COLORREF missileColor = RGB(0, 255, 255); // Ярко-голубой
+
+        // Создаем кисть и перо для отрисовки.
+        HBRUSH hBrush = CreateSolidBrush(missileColor); // Кисть для заливки
+        HPEN hPen = CreatePen(PS_SOLID, 1, missileColor); // Перо для контура
+
+        // Сохраняем текущие объекты и выбираем наши
+        HBRUSH hOldBrush = (HBRUSH)SelectObject(hdc, hBrush);
+        HPEN hOldPen = (HPEN)SelectObject(hdc, hPen);
+
+        // Рисуем эллипс (ракету) размером 3x3 пикселя.
+        int size_px = 3;
+        Ellipse(hdc, screenX - size_px, screenY - size_px, screenX + size_px + 1, screenY + size_px + 1);
+
+        // Восстанавливаем старые объекты HDC
+        SelectObject(hdc, hOldBrush);
+        SelectObject(hdc, hOldPen);
+
+        // Удаляем созданные объекты GDI
+        DeleteObject(hBrush);
+        DeleteObject(hPen);
+
+    }
+} // Конец draw()
+
+
+// --- Отрисовка радара по кадру ---
+// beamAngle - интерполированный угол луча, missiles - ракеты кадра с интерполированными позициями.
+static void drawRadar(HDC hdc, int winCenterX, int winCenterY, const RenderRadar& radar, float beamAngle,
+                      const std::vector<Missile>& missiles) {
+    // Состояние радара в кадре - одна согласованная копия (seqlock при публикации кадра):
+    // угол луча и отслеживаемая цель относятся к одному и тому же моменту.
+    const RadarState& state = radar.state;
+    const Point pos = radar.pos;
+    bool isOperationalStatus = state.isOperational;   // Работает ли радар?
+    float currentAngle = beamAngle;                   // Угол сканирования для луча (между шагами симуляции).
+    float beamWidth = state.beamWidth;                // Ширина луча сканирования.
+
+    // --- Радиусы трех зон ---
+    float outerGreenRadius = state.radar_range;          // Радиус внешнего ЗЕЛЕНОГО круга.
+    float middleYellowRadius = state.engagementRadius;   // Радиус среднего ЖЕЛТОГО круга (Зона Поражения).
+    float deadZoneRedRadius = state.deadZoneRadius;      // Радиус внутреннего КРАСНОГО круга (Мертвая зона).
+
+
+
+    // Вычисляем экранные координаты центра радара (основной - в мировых (0,0)).
+    int screenX = static_cast<int>(pos.x + winCenterX);
+    int screenY = static_cast<int>(-pos.y + winCenterY);
+
+
+    // --- Управление GDI объектами (карандаши для контуров/линий, кисти для заливки) ---
+    // Сохраняем текущие выбранные GDI объекты в HDC, чтобы восстановить их В САМОМ КОНЦЕ draw().
+    // Выбираем стандартные NULL объекты как базу для SelectObject().
+    HPEN hOldPen = (HPEN)SelectObject(hdc, GetStockObject(NULL_PEN));     // Сохраняем и выбираем NULL перо.
+    HBRUSH hOldBrush = (HBRUSH)SelectObject(hdc, GetStockObject(NULL_BRUSH)); // Сохраняем и выбираем NULL кисть.
+
+
+    // --- Определяем цвета для рисования ---
+    COLORREF greenColor = RGB(0, 200, 0);         // Зеленый: Внешний круг, Луч.
+    COLORREF yellowColor = RGB(255, 255, 0);        // Желтый: Средний круг (Зона Поражения), Маркеры обнаружения лучом.
+    COLORREF redColor = RGB(255, 0, 0);           // Красный: Внутренний круг (Мертвая зона), База радара.
+    COLORREF baseOutlineColor = RGB(0, 0, 0);     // Черный: Контур базы.
+    COLORREF targetLineColor = RGB(255, 255, 255); // Белый: Линия к отслеживаемой цели (пунктир).
+    COLORREF baseColorNonOperational = RGB(100, 0, 0); // Темно-красный: База нерабочего радара.
+
+
+    // --- Создаем GDI Перья (карандаши) и Кисти ---
+    // Кисть для заливки базы.
+    HBRUSH hBrushBase = CreateSolidBrush(isOperationalStatus ? redColor : baseColorNonOperational); // Кисть для заливки базы.
+    // Перья для контуров зон и линий.
+    HPEN hPenGreen = CreatePen(PS_SOLID, 1, greenColor);         // Для внешнего ЗЕЛЕНОГО круга.
+    HPEN hPenYellow = CreatePen(PS_SOLID, 1, yellowColor);       // Для среднего ЖЕЛТОГО круга.
+    HPEN hPenRed = CreatePen(PS_SOLID, 1, redColor);             // Для внутреннего КРАСНОГО круга.
+    HPEN hPenBeam = CreatePen(PS_SOLID, 2, greenColor);          // Для ЗЕЛЕНОГО луча (толщина 2).
+    HPEN hPenTargetLine = CreatePen(PS_DOT, 1, targetLineColor); // Для БЕЛОЙ ПУНКТИРНОЙ линии к цели.
+    HPEN hPenBaseOutline = CreatePen(PS_SOLID, 1, baseOutlineColor); // Для черного контура базы.
+    // Временные объекты для маркеров обнаружения лучом (создаются/удаляются ВНУТРИ if(isOperationalStatus)).
+
+
+    // --- 1. Отрисовка Базы Радара (Красная заливка с черным контуром) ---
+    SelectObject(hdc, hPenBaseOutline); // Выбираем черное перо контура базы.
+    SelectObject(hdc, hBrushBase);      // Выбираем кисть заливки базы.
+    Ellipse(hdc, screenX - 10, screenY - 10, screenX + 10, screenY + 10); // Рисуем круг базы (радиус 10px).
+    // !!! ВАЖНО !!!: Удаляем созданные GDI объекты базы СРАЗУ.
+    DeleteObject(hBrushBase);      // Удаляем созданную кисть.
+    DeleteObject(hPenBaseOutline); // Удаляем созданное перо контура.
+
+
+    // --- 2. Отрисовка Зон (кругов), Луча и Маркеров ОБНАРУЖЕНИЯ (только если радар работает) ---
+    if (isOperationalStatus) { // Рисуем эти элементы только если радар включен.
+
+        SelectObject(hdc, GetStockObject(NULL_BRUSH)); // Круги зон без заливки.
+
+        // 2.1. Отрисовка ВНЕШНЕГО ЗЕЛЕНОГО круга (Радиус = radar_range).
+        SelectObject(hdc, hPenGreen); // Выбираем зеленое перо.
+        Ellipse(hdc, screenX - (int)outerGreenRadius, screenY - (int)outerGreenRadius,
+            screenX + (int)outerGreenRadius, screenY + (int)outerGreenRadius);
+
+        // 2.2. Отрисовка СРЕДНЕГО ЖЕЛТОГО круга (Радиус = engagementRadius, Зона Поражения).
+        SelectObject(hdc, hPenYellow); // Выбираем желтое перо.
+        Ellipse(hdc, screenX - (int)middleYellowRadius, screenY - (int)middleYellowRadius,
+            screenX + (int)middleYellowRadius, screenY + (int)middleYellowRadius);
+
+        // 2.3. Отрисовка ВНУТРЕННЕГО КРАСНОГО круга (Мертвая зона, Радиус = deadZoneRadius).
+        SelectObject(hdc, hPenRed); // Выбираем красное перо.
+        Ellipse(hdc, screenX - (int)deadZoneRedRadius, screenY - (int)deadZoneRedRadius,
+            screenX + (int)deadZoneRedRadius, screenY + (int)deadZoneRedRadius);
+
+
+        // 2.4. Отрисовка ЛУЧА СКАНИРОВАНИЯ (Зеленый, толщина 2, из центра до внешнего Зеленого круга).
+        SelectObject(hdc, hPenBeam); // Выбираем Зеленое перо для луча.
+        float beamStartAngle = normalizeAngle(currentAngle - beamWidth / 2.0f);
+        float beamEndAngle = normalizeAngle(currentAngle + beamWidth / 2.0f);
+        Point p1_outer_world = { pos.x + outerGreenRadius * std::cos(beamStartAngle), pos.y + outerGreenRadius * std::sin(beamStartAngle) };
+        Point p2_outer_world = { pos.x + outerGreenRadius * std::cos(beamEndAngle), pos.y + outerGreenRadius * std::sin(beamEndAngle) };
+        int p1_outer_screenX = static_cast<int>(p1_outer_world.x + winCenterX);
+        int p1_outer_screenY = static_cast<int>(-p1_outer_world.y + winCenterY); // Инверсия Y
+        int p2_outer_screenX = static_cast<int>(p2_outer_world.x + winCenterX);
+        int p2_outer_screenY = static_cast<int>(-p2_outer_world.y + winCenterY); // Инверсия Y
+        MoveToEx(hdc, screenX, screenY, NULL); LineTo(hdc, p1_outer_screenX, p1_outer_screenY);
+        MoveToEx(hdc, screenX, screenY, NULL); LineTo(hdc, p2_outer_screenX, p2_outer_screenY);
+
+
+        // --- <<< НОВОЕ: Отрисовка маркеров на ВСЕХ ракетах, попадающих под ТЕКУЩИЙ ЛУЧ В ЗОНЕ ОБНАРУЖЕНИЯ >>> ---
+        // Это визуальное отображение, какие ракеты "видит" сканирующий луч прямо сейчас.
+        const std::vector<Missile>& activeMissilesRef = missiles; // Ракеты кадра (своя копия, блокировка не нужна).
+
+        // Создаем временные GDI объекты для отрисовки маркеров (Желтый цвет, соответствующий средней зоне).
+        HBRUSH hBrushMarker = CreateSolidBrush(yellowColor); // Желтая кисть.
+        HPEN hPenMarker = CreatePen(PS_SOLID, 1, yellowColor);   // Желтое перо.
+        // Сохраняем текущие объекты и выбираем наши временные маркеры.
+        HBRUSH hOldBrushMarker = (HBRUSH)SelectObject(hdc, hBrushMarker);
+        HPEN hOldPenMarker = (HPEN)SelectObject(hdc, hPenMarker);
+
+        // Сектор луча в кольце (Красный, Зеленый] - один раз на кадр; проверка ракеты без atan2/fmod/sqrt.
+        BeamSector beamSector = BeamSector::make(currentAngle, beamWidth, deadZoneRedRadius, outerGreenRadius);
+
+        // Итерируем по КАЖДОЙ активной ракете.
+        for (const auto& missile : activeMissilesRef) {
+            if (missile.isActive) {
+                if (beamSector.contains(missile.pos - pos)) { // Сектор - относительно радара
+                    int missileScreenX = static_cast<int>(missile.pos.x + winCenterX);
+                    int missileScreenY = static_cast<int>(-missile.pos.y + winCenterY);
+                    int markerSize = 3;
+                    Ellipse(hdc, missileScreenX - markerSize, missileScreenY - markerSize, missileScreenX + markerSize + 1, missileScreenY + markerSize + 1);
+                }
+            }
+        } // Конец цикла по активным ракетам для отрисовки маркеров.
+
+
+        // !!! ВАЖНО !!!: Удаляем временные GDI объекты маркеров ПОСЛЕ их использования. !!!
+        SelectObject(hdc, hOldBrushMarker); // Восстанавливаем кисть.
+        SelectObject(hdc, hOldPenMarker);   // Восстанавливаем перо.
+        DeleteObject(hBrushMarker);         // Удаляем кисть.
+        DeleteObject(hPenMarker);           // Удаляем перо.
+
+
+        // --- Рисуем линии к целям на сопровождении (таблица треков радара) ---
+        // Ракеты кадра идут по возрастанию ID - ищем каждую цель бинарным поиском.
+        SelectObject(hdc, hPenTargetLine); // Белый пунктир.
+        for (int trackedId : radar.trackIds) {
+            auto itTracked = std::lower_bound(activeMissilesRef.begin(), activeMissilesRef.end(), trackedId,
+                [](const Missile& m, int id) { return m.id < id; });
+            if (itTracked == activeMissilesRef.end() || itTracked->id != trackedId || !itTracked->isActive) continue;
+            MoveToEx(hdc, screenX, screenY, NULL); // Начинаем линию из центра радара.
+            LineTo(hdc, static_cast<int>(itTracked->pos.x + winCenterX), static_cast<int>(-itTracked->pos.y + winCenterY));
+        }
+
+       // ... (Остальной код draw в блоке if (isOperationalStatus) - если есть что-то после отрисовки линии) ...
+
+
+    } // Конец if (isOperationalStatus). Рисует зоны, луч, маркеры/линии.
+
+
+    // --- Удаление всех созданных GDI объектов (перьев и кистей) ---
+    // Удаляем перья и кисти, созданные Create...().
+    // Делается после того, как они использованы И после восстановления старых объектов в HDC.
+    DeleteObject(hPenGreen);       // Удаляем зеленое перо.
+    DeleteObject(hPenYellow);      // Удаляем желтое перо.
+    DeleteObject(hPenRed);         // Удаляем красное перо.
+    DeleteObject(hPenBeam);        // Удаляем перо луча.
+    DeleteObject(hPenTargetLine);  // Удаляем перо линии к цели.
+    // hPenBaseOutline и hBrushBase уже были удалены после отрисовки базы.
+
+
+    // --- Восстановление исходных GDI объектов контекста устройства ---
+    // Восстанавливаем в HDC те перо и кисть, которые были активны ДО ВХОДА в этот метод draw().
+    SelectObject(hdc, hOldPen);   // Восстанавливаем оригинальное перо.
+    SelectObject(hdc, hOldBrush); // Восстанавливаем оригинальную кисть.
+    // Объекты GetStockObject() не удаляются.
+
+}
+
+
+// --- Кадр целиком: alpha - доля между предыдущим и текущим шагом симуляции (RenderFrame::interpolationAlpha) ---
+void RenderFrame::draw(HDC hdc, const RECT* clientRect, float alpha) const {
+    int width = clientRect->right - clientRect->left;
+    int height = clientRect->bottom - clientRect->top;
+    int centerX = width / 2;
+    int centerY = height / 2;
+
+    // Для вывода (стаистики можно менять)
+    int detailStatsX = 10;
+    int detailStatsY = 300; 
+    int lineHeight = 18;    
+
+    SetTextColor(hdc, RGB(255, 255, 255)); 
+    SetBkMode(hdc, TRANSPARENT);
+    for (const auto& launcher : launchers) {
+        launcher.draw(hdc, centerX, centerY);
+    }
+
+    // Ракеты и луч - на момент между шагами: движение плавное при любой частоте кадров окна.
+    float t = gameTimeAt(alpha);
+    std::vector<Missile> interpolated(missiles);
+    for (auto& missile : interpolated) {
+        missile.pos = missilePosAt(missile, t);
+    }
+    for (const auto& missile : interpolated) {
+        if (missile.isActive) {
+            missile.draw(hdc, centerX, centerY);
+        }
+    }
+
+    for (const RenderRadar& radar : radars) {
+        drawRadar(hdc, centerX, centerY, radar, radar.beamAngleAt(alpha), interpolated);
+    }
+    SetTextColor(hdc, RGB(255, 255, 255)); // Белый цвет текста.
+    SetBkMode(hdc, TRANSPARENT); // Прозрачный фон.
+
+    // Форматируем и выводим строку статистики
+    std::wstringstream ss_stats;
+    ss_stats << L"Время: " << std::fixed << std::setprecision(1) << gameTime << L" c | ";
+    size_t activeMissileCount = missiles.size();
+    ss_stats << L"Активно: " << activeMissileCount << L" | ";
+    ss_stats << L"Запущено: " << missilesLaunched << L"/" << maxMissiles << L" | ";
+    ss_stats << L"Уничтожено: " << missilesDestroyed;
+    TextOut(hdc, 10, 10, ss_stats.str().c_str(), static_cast<int>(ss_stats.str().length()));
+
+
+    size_t countToDisplay = recentEvents.size(); // Не больше RECENT_MISSILES и не больше, чем запущено.
+
+    // Итерируем с конца по количеству последних ракет, которые хотим отобразить.
+    // Ракеты нумеруются от 0 до missilesLaunched - 1. ID = порядку запуска.
+    for (size_t i = 0; i < countToDisplay; ++i) {
+        // ID текущей ракеты в этой итерации: missilesLaunched - 1 - i
+        int currentMissileId = missilesLaunched - 1 - static_cast<int>(i);
+
+        // Последняя запись лога для этой ракеты (скопирована в кадр потоком симуляции).
+        const MissileLogEntry& lastEntry = recentEvents[i];
+
+
+        // Форматируем строку статистики для текущей ракеты.
+        std::wstringstream ss_detail;
+        ss_detail << L"Ракета " << currentMissileId; // ID ракеты.
+        if (lastEntry.missileId != -1) { // Проверяем, что запись в логе была найдена для этого ID.
+            ss_detail << L" (П" << lastEntry.launcherId << L"): "; // ID пусковой.
+            ss_detail << missileEventName(lastEntry.event); // Статус ("Запущена", "Уничтожена", "Потеряна", etc.) - текст по коду.
+            // Можно добавить время последнего события:
+            ss_detail << L" [" << std::fixed << std::setprecision(1) << lastEntry.timestamp << L"с]";
+        }
+        else {
+            ss_detail << L": Лог пуст или не найден."; 
+        }
+        std::wstring detailString = ss_detail.str(); // Получаем std::wstring.
+
+
+        // Выводим строку статистики для текущей ракеты.
+        TextOut(hdc, detailStatsX, detailStatsY, detailString.c_str(), static_cast<int>(detailString.length()));
+
+        detailStatsY += lineHeight; // Увеличиваем координату Y для следующей строки детализации.
+    }
+
+
+    if (isGameOver) {
+        HFONT hFont = CreateFont(48, 0, 0, 0, FW_BOLD, FALSE, FALSE, FALSE, DEFAULT_CHARSET, OUT_OUTLINE_PRECIS, CLIP_DEFAULT_PRECIS, CLEARTYPE_QUALITY, VARIABLE_PITCH, TEXT("Arial"));
+        
+        HFONT hOldFont_main; // Для восстановления после основного сообщения
+        HFONT hOldFont_restart;
+        std::wstring endMessage = playerWon ? L"ПОБЕДА!" : L"ПОРАЖЕНИЕ!";
+        std::wstring restartMsg = L"Нажмите 'Начать заново'";
+        SIZE textSize;
+        int textX; // Будут переиспользоваться для обоих сообщений
+        int textY;
+
+        hOldFont_main = (HFONT)SelectObject(hdc, hFont);
+
+        GetTextExtentPoint32(hdc, endMessage.c_str(), static_cast<int>(endMessage.length()), &textSize);
+        textX = centerX - textSize.cx / 2; 
+        textY = centerY - textSize.cy / 2 - 50; 
+
+        SetTextColor(hdc, playerWon ? RGB(0, 255, 0) : RGB(255, 0, 0));
+        TextOut(hdc, textX, textY, endMessage.c_str(), static_cast<int>(endMessage.length()));
+        SelectObject(hdc, hOldFont_main); // Восстанавливаем
+        DeleteObject(hFont);
+        HFONT hFontSmall = CreateFont(24, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE, DEFAULT_CHARSET, OUT_OUTLINE_PRECIS, CLIP_DEFAULT_PRECIS, CLEARTYPE_QUALITY, VARIABLE_PITCH, TEXT("Arial"));
+
+        hOldFont_restart = (HFONT)SelectObject(hdc, hFontSmall);
+        GetTextExtentPoint32(hdc, restartMsg.c_str(), static_cast<int>(restartMsg.length()), &textSize);
+        textX = centerX - textSize.cx / 2; 
+        textY = centerY + textSize.cy / 2; 
+
+        SetTextColor(hdc, RGB(200, 200, 200)); // Серый цвет.
+        TextOut(hdc, textX, textY, restartMsg.c_str(), static_cast<int>(restartMsg.length()));
+        SelectObject(hdc, hOldFont_restart); // Восстанавливаем шрифт, который был активен ДО выбора hFontSmall.
+        DeleteObject(hFontSmall);  
+    }
+
+}
@@ -0,0 +1,182 @@
+#include "InputRecording.h" // Включаем заголовок записи ввода
+#include <cstring>
+#include <ctime>
+
+using namespace recording;
+
+
+// --- Запись ---
+
+InputRecorder::InputRecorder() : m_file(nullptr), m_runDt(0.0f), m_runCount(0), m_ticks(0) {}
+
+InputRecorder::~InputRecorder() {
+    close();
+}
+
+bool InputRecorder::open(const std::string& path) {
+    close();
+    m_lastError.clear();
+    m_file = std::fopen(path.c_str(), "wb");
+    if (!m_file) {
+        m_lastError = "cannot create '" + path + "'";
+        return false;
+    }
+    m_runDt = 0.0f;
+    m_runCount = 0;
+    m_ticks = 0;
+
+    RecordingHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "RGREC\0\0\0", 8);
+    header.version = VERSION;
+    header.headerSize = HEADER_SIZE;
+    header.recordSize = RECORD_SIZE;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.configCount = journal::CFG_COUNT;
+    header.createdUnix = static_cast<int64_t>(std::time(nullptr));
+    if (std::fwrite(&header, sizeof(header), 1, m_file) != 1) {
+        m_lastError = "cannot write header to '" + path + "'";
+        std::fclose(m_file);
+        m_file = nullptr;
+        return false;
+    }
+    std::fflush(m_file);
+    return true;
+}
+
+void InputRecorder::put(const RecordingRecord& record) {
+    if (std::fwrite(&record, sizeof(record), 1, m_file) != 1) m_lastError = "recording write failed";
+}
+
+// Незаписанная серия тиков -> одна запись REC_TICKS.
+void InputRecorder::flushRun() {
+    if (!m_file || m_runCount == 0) return;
+    RecordingRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.type = REC_TICKS;
+    record.count = m_runCount;
+    record.dt = m_runDt;
+    put(record);
+    m_runCount = 0;
+}
+
+void InputRecorder::game(uint64_t seed, const GameConfig& config, uint64_t scenarioFingerprint, uint64_t scenarioLaunches) {
+    if (!m_file) return;
+    flushRun();
+    RecordingRecord record;
+    for (const RadarSite& site : config.radar_sites) {
+        std::memset(&record, 0, sizeof(record));
+        record.type = REC_RADAR_SITE;
+        record.config[0] = site.pos.x;
+        record.config[1] = site.pos.y;
+        record.config[2] = site.sweepSpeed;
+        record.config[3] = site.beamWidth;
+        record.config[4] = site.range;
+        record.config[5] = site.engagementRadius;
+        record.config[6] = site.deadZoneRadius;
+        put(record);
+    }
+    for (const LauncherSite& launcher : config.launchers) {
+        std::memset(&record, 0, sizeof(record));
+        record.type = REC_LAUNCHER;
+        record.config[0] = launcher.pos.x;
+        record.config[1] = launcher.pos.y;
+        record.config[2] = launcher.minInterval;
+        record.config[3] = launcher.maxInterval;
+        put(record);
+    }
+    if (scenarioFingerprint != 0) {
+        std::memset(&record, 0, sizeof(record));
+        record.type = REC_SCENARIO;
+        record.value = scenarioFingerprint;
+        record.eventCount = scenarioLaunches;
+        put(record);
+    }
+    std::memset(&record, 0, sizeof(record));
+    record.type = REC_GAME;
+    record.value = seed;
+    journal::packConfig(config, record.config);
+    put(record);
+    std::fflush(m_file);
+}
+
+void InputRecorder::tick(float dt, uint64_t count) {
+    if (!m_file || count == 0) return;
+    // Серия продолжается, пока шаг побитно тот же.
+    if (m_runCount > 0 && std::memcmp(&dt, &m_runDt, sizeof(dt)) != 0) flushRun();
+    m_runDt = dt;
+    m_ticks += count;
+    while (count > 0) {
+        uint64_t room = TICK_FLUSH_INTERVAL - m_runCount;
+        uint64_t take = count < room ? count : room;
+        m_runCount += static_cast<uint32_t>(take);
+        count -= take;
+        if (m_runCount == TICK_FLUSH_INTERVAL) {
+            flushRun();
+            std::fflush(m_file);
+        }
+    }
+}
+
+void InputRecorder::gameEnd(uint64_t eventCount, uint64_t digest) {
+    if (!m_file) return;
+    flushRun();
+    RecordingRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.type = REC_GAME_END;
+    record.value = digest;
+    record.eventCount = eventCount;
+    put(record);
+    std::fflush(m_file);
+}
+
+void InputRecorder::exit() {
+    if (!m_file) return;
+    flushRun();
+    RecordingRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.type = REC_EXIT;
+    put(record);
+    close();
+}
+
+void InputRecorder::close() {
+    if (!m_file) return;
+    flushRun();
+    std::fclose(m_file);
+    m_file = nullptr;
+}
+
+
+// --- Чтение ---
+
+InputRecordingReader::InputRecordingReader() : m_recordCount(0) {}
+
+bool InputRecordingReader::open(const std::string& path) {
+    m_recordCount = 0;
+    m_lastError.clear();
+    if (!m_file.open(path, true)) {
+        m_lastError = m_file.lastError();
+        return false;
+    }
+    if (m_file.size() < HEADER_SIZE) {
+        m_lastError = "'" + path + "' is too small for a recording header";
+        return false;
+    }
+    const RecordingHeader* header = reinterpret_cast<const RecordingHeader*>(m_file.data());
+    if (std::memcmp(header->magic, "RGREC\0\0\0", 8) != 0) {
+        m_lastError = "'" + path + "' is not a RadarGame input recording";
+        return false;
+    }
+    if (header->byteOrder != BYTE_ORDER_MARK) {
+        m_lastError = "'" + path + "' was written with a different byte order";
+        return false;
+    }
+    if (header->version != VERSION || header->headerSize != HEADER_SIZE || header->recordSize != RECORD_SIZE ||
+        header->configCount != journal::CFG_COUNT) {
+        m_lastError = "'" + path + "' has an unsupported recording version";
+        return false;
+    }
+    m_recordCount = (m_file.size() - HEADER_SIZE) / RECORD_SIZE; // Оборванная последняя запись игнорируется.
+    return true;
+}
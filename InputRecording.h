@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include "GameConfig.h"
+#include "EventJournal.h"
+#include "MappedFile.h"
+
+// --- Запись ввода симуляции для точного повтора ---
+// Игра полностью определяется начальным значением генератора, конфигурацией и последовательностью
+// вызовов update(dt) / reset() / shutdown(). Запись хранит ровно это, поэтому повтор (BatchRunner --replay)
+// без окна и с максимальной скоростью воспроизводит побитно те же события MissileLog.
+// Для проверки в конце каждой игры пишется число событий и их контрольная сумма (missileLogDigest).
+//
+// Пока идет запись, радар сканирует внутри update() по игровому времени (без своего потока):
+// шаги потока радара по настенным часам зависят от планировщика и не повторяются.
+//
+// Формат (little-endian): RecordingHeader (64 байта), затем записи по 96 байт:
+//   REC_RADAR_SITE - дополнительная позиция радара (radar_site) следующей игры: config[0..6] = x, y, скорость
+//                  луча, ширина луча, дальность, радиус поражения, мертвая зона (единицы GameConfig: радианы);
+//   REC_LAUNCHER - пусковая из конфигурации (launcher) следующей игры: config[0..3] = x, y, интервалы запусков;
+//   REC_SCENARIO - следующая игра идет по файлу сценария (scenario, ScenarioFile.h): value = контрольная сумма
+//                  сценария, eventCount = число запусков; сам файл при повторе задается BatchRunner --scenario;
+//   REC_GAME     - начало игры: начальное значение генератора и параметры GameConfig;
+//   REC_TICKS    - count вызовов update(dt) подряд с одинаковым dt (при постоянном шаге - одна запись на серию);
+//   REC_GAME_END - итог игры для сверки: число событий и контрольная сумма;
+//   REC_EXIT     - завершение (shutdown) симуляции.
+// Серия тиков дописывается каждые TICK_FLUSH_INTERVAL тиков, поэтому при аварийном завершении
+// теряется не больше этого числа последних тиков.
+
+namespace recording {
+
+enum : uint32_t {
+    VERSION = 2,
+    HEADER_SIZE = 64,
+    RECORD_SIZE = 96,
+    TICK_FLUSH_INTERVAL = 1024,
+    BYTE_ORDER_MARK = 0x01020304u
+};
+
+enum RecordType : uint32_t {
+    REC_GAME = 1,
+    REC_TICKS = 2,
+    REC_GAME_END = 3,
+    REC_EXIT = 4,
+    REC_RADAR_SITE = 5,
+    REC_LAUNCHER = 6,
+    REC_SCENARIO = 7
+};
+
+#pragma pack(push, 1)
+struct RecordingHeader {
+    char magic[8];            // "RGREC\0\0\0"
+    uint32_t version;
+    uint32_t headerSize;      // HEADER_SIZE
+    uint32_t recordSize;      // RECORD_SIZE
+    uint32_t byteOrder;       // BYTE_ORDER_MARK
+    uint32_t configCount;     // journal::CFG_COUNT
+    uint32_t reserved0;
+    int64_t createdUnix;
+    uint8_t reserved[HEADER_SIZE - 40];
+};
+
+struct RecordingRecord {
+    uint32_t type;            // RecordType
+    uint32_t count;           // REC_TICKS: число тиков
+    float dt;                 // REC_TICKS: шаг
+    uint32_t reserved0;
+    uint64_t value;           // REC_GAME: начальное значение генератора; REC_GAME_END: контрольная сумма событий
+    uint64_t eventCount;      // REC_GAME_END: число событий игры
+    float config[journal::CFG_COUNT]; // REC_GAME: параметры (порядок journal::ConfigField); REC_RADAR_SITE, REC_LAUNCHER: позиция
+    uint8_t reserved[RECORD_SIZE - 32 - journal::CFG_COUNT * 4];
+};
+#pragma pack(pop)
+
+static_assert(sizeof(RecordingHeader) == HEADER_SIZE, "RecordingHeader size");
+static_assert(sizeof(RecordingRecord) == RECORD_SIZE, "RecordingRecord size");
+static_assert(journal::CFG_COUNT >= 7, "REC_RADAR_SITE needs 7 values");
+
+} // namespace recording
+
+
+// --- Запись (поток симуляции, вызывается из SimulationState) ---
+class InputRecorder {
+private:
+    std::FILE* m_file;
+    float m_runDt;        // Текущая серия тиков
+    uint32_t m_runCount;
+    uint64_t m_ticks;     // Всего тиков записано
+    std::string m_lastError;
+
+    void put(const recording::RecordingRecord& record);
+    void flushRun();
+
+public:
+    InputRecorder();
+    ~InputRecorder();
+
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    bool open(const std::string& path);
+    // scenarioFingerprint != 0 - игра идет по файлу сценария (запись REC_SCENARIO перед REC_GAME).
+    void game(uint64_t seed, const GameConfig& config, uint64_t scenarioFingerprint = 0, uint64_t scenarioLaunches = 0);
+    void tick(float dt, uint64_t count = 1); // count тиков подряд с шагом dt (пропущенные тики EventEngine)
+    void gameEnd(uint64_t eventCount, uint64_t digest);
+    void exit();          // REC_EXIT и закрытие файла
+    void close();         // Закрытие без REC_EXIT (запись продолжится в другом файле)
+
+    bool isOpen() const { return m_file != nullptr; }
+    uint64_t tickCount() const { return m_ticks; }
+    const std::string& lastError() const { return m_lastError; }
+};
+
+
+// --- Чтение записи (через MappedFile) ---
+class InputRecordingReader {
+private:
+    MappedFile m_file;
+    uint64_t m_recordCount;
+    std::string m_lastError;
+
+public:
+    InputRecordingReader();
+
+    bool open(const std::string& path);
+    const std::string& lastError() const { return m_lastError; }
+
+    uint64_t recordCount() const { return m_recordCount; }
+    const recording::RecordingRecord& record(uint64_t i) const {
+        return *reinterpret_cast<const recording::RecordingRecord*>(m_file.data() + recording::HEADER_SIZE + i * recording::RECORD_SIZE);
+    }
+};
@@ -0,0 +1,174 @@
+// --- Просмотр бинарного журнала событий (EventJournal.h) ---
+// Файл читается через mmap: страницы подгружаются по мере обхода, поэтому журналы в несколько гигабайт
+// не загружаются в память целиком. Фильтры по ракете/пусковой/событию/времени сначала проверяются по записям
+// индекса, и блоки, где нужных событий быть не может, пропускаются без чтения.
+//
+// Использование:
+//   JournalTool header <журнал>
+//   JournalTool dump   <журнал> [--missile ID] [--launcher ID] [--event КОД] [--from сек] [--to сек] [--limit N]
+//   JournalTool stats  <журнал> [--missile ID] [--launcher ID] [--event КОД] [--from сек] [--to сек]
+// КОД события: launched, detected, destroyed, lost_dead_zone, radar_hit, victory, missed.
+#include "EventJournal.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace journal;
+
+struct Filter {
+    bool byMissile = false;
+    int missileId = 0;
+    bool byLauncher = false;
+    int launcherId = 0;
+    bool byEvent = false;
+    MissileEvent event = MissileEvent::None;
+    float from = -std::numeric_limits<float>::infinity();
+    float to = std::numeric_limits<float>::infinity();
+    unsigned long long limit = 0; // 0 - без ограничения
+
+    // Блок можно пропустить, если по его индексу нужных событий в нем нет.
+    bool skipBlock(const JournalIndexRecord& index) const {
+        if (byMissile && (missileId < index.minMissileId || missileId > index.maxMissileId)) return true;
+        if (byLauncher && (index.launcherMask & launcherBit(launcherId)) == 0) return true;
+        if (byEvent && (index.eventMask & (1u << static_cast<uint32_t>(event))) == 0) return true;
+        if (index.lastTimestamp < from || index.firstTimestamp > to) return true;
+        return false;
+    }
+    bool accept(const JournalEventRecord& e) const {
+        if (byMissile && e.missileId != missileId) return false;
+        if (byLauncher && e.launcherId != launcherId) return false;
+        if (byEvent && e.event != static_cast<uint8_t>(event)) return false;
+        return e.timestamp >= from && e.timestamp <= to;
+    }
+};
+
+static void usage() {
+    std::fprintf(stderr,
+        "usage: JournalTool header <journal>\n"
+        "       JournalTool dump   <journal> [--missile ID] [--launcher ID] [--event CODE] [--from sec] [--to sec] [--limit N]\n"
+        "       JournalTool stats  <journal> [--missile ID] [--launcher ID] [--event CODE] [--from sec] [--to sec]\n"
+        "event codes: launched, detected, destroyed, lost_dead_zone, radar_hit, victory, missed\n");
+}
+
+static int printHeader(const JournalReader& reader) {
+    const JournalHeader& h = reader.header();
+    GameConfig config = reader.config();
+    std::time_t created = static_cast<std::time_t>(h.createdUnix);
+    char when[64] = "?";
+    if (std::tm* tm = std::gmtime(&created)) std::strftime(when, sizeof(when), "%Y-%m-%dT%H:%M:%SZ", tm);
+
+    std::printf("version=%u\n", h.version);
+    std::printf("created=%s\n", when);
+    std::printf("slot_size=%u\n", h.slotSize);
+    std::printf("index_interval=%u\n", h.indexInterval);
+    std::printf("slots=%llu\n", static_cast<unsigned long long>(reader.slotCount()));
+    std::printf("missile_speed=%g\n", config.missile_speed);
+    std::printf("distance_corner_center=%g\n", config.distance_corner_center);
+    std::printf("radar_sweep_speed=%g\n", RAD_TO_DEG(config.radar_sweep_speed));
+    std::printf("radar_turning_speed=%g\n", RAD_TO_DEG(config.radar_turning_speed));
+    std::printf("radar_beam_width=%g\n", RAD_TO_DEG(config.radar_beam_width));
+    std::printf("radar_range=%g\n", config.radar_range);
+    std::printf("radar_engagement_radius=%g\n", config.radar_engagement_radius);
+    std::printf("danger_zone_radius=%g\n", config.danger_zone_radius);
+    std::printf("radar_acquire_time=%g\n", config.radar_acquire_time);
+    std::printf("radar_track_capacity=%d\n", config.radar_track_capacity);
+    std::printf("track_measurement_sigma=%g\n", config.track_measurement_sigma);
+    std::printf("track_process_noise=%g\n", config.track_process_noise);
+    std::printf("radar_fire_channels=%d\n", config.radar_fire_channels);
+    std::printf("max_missiles=%d\n", config.max_missiles);
+    return 0;
+}
+
+static int dump(const JournalReader& reader, const Filter& filter) {
+    unsigned long long printed = 0;
+    reader.forEachEvent(
+        [&](const JournalIndexRecord& index) { return (filter.limit && printed >= filter.limit) || filter.skipBlock(index); },
+        [&](const JournalEventRecord& e) {
+            if (filter.limit && printed >= filter.limit) return;
+            if (!filter.accept(e)) return;
+            // Текст события строится только здесь, при выводе.
+            std::printf("%llu\t%.3f\tmissile=%d\tlauncher=%d\t%s\t%s\n",
+                static_cast<unsigned long long>(e.seq), e.timestamp, e.missileId, e.launcherId,
+                eventKey(static_cast<MissileEvent>(e.event)), toUtf8(formatMissileLogEntry(toLogEntry(e))).c_str());
+            ++printed;
+        });
+    return 0;
+}
+
+static int stats(const JournalReader& reader, const Filter& filter) {
+    unsigned long long events = 0;
+    float firstTime = 0.0f, lastTime = 0.0f;
+    std::vector<uint8_t> seenMissile; // Индекс - ID ракеты (ID идут подряд с 0)
+    unsigned long long distinctMissiles = 0;
+    std::map<int, unsigned long long> perLauncher;
+    unsigned long long perEvent[256] = {}; // По коду события
+
+    uint64_t skippedBlocks = reader.forEachEvent(
+        [&](const JournalIndexRecord& index) { return filter.skipBlock(index); },
+        [&](const JournalEventRecord& e) {
+            if (!filter.accept(e)) return;
+            if (events == 0) firstTime = e.timestamp;
+            lastTime = e.timestamp;
+            ++events;
+            if (e.missileId >= 0) {
+                size_t id = static_cast<size_t>(e.missileId);
+                if (id >= seenMissile.size()) seenMissile.resize(id + 1, 0);
+                if (!seenMissile[id]) { seenMissile[id] = 1; ++distinctMissiles; }
+            }
+            ++perLauncher[e.launcherId];
+            ++perEvent[e.event];
+        });
+
+    std::printf("slots=%llu\n", static_cast<unsigned long long>(reader.slotCount()));
+    std::printf("skipped_blocks=%llu\n", static_cast<unsigned long long>(skippedBlocks));
+    std::printf("events=%llu\n", events);
+    std::printf("first_time=%.3f\n", firstTime);
+    std::printf("last_time=%.3f\n", lastTime);
+    std::printf("missiles=%llu\n", distinctMissiles);
+    for (const auto& kv : perLauncher) std::printf("launcher[%d]=%llu\n", kv.first, kv.second);
+    for (int code = 0; code < 256; ++code) {
+        if (perEvent[code]) std::printf("event[%s]=%llu\n", eventKey(static_cast<MissileEvent>(code)), perEvent[code]);
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        usage();
+        return 2;
+    }
+    std::string command = argv[1];
+    std::string path = argv[2];
+
+    Filter filter;
+    for (int i = 3; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--missile") == 0 && i + 1 < argc) { filter.byMissile = true; filter.missileId = std::atoi(argv[++i]); }
+        else if (std::strcmp(argv[i], "--launcher") == 0 && i + 1 < argc) { filter.byLauncher = true; filter.launcherId = std::atoi(argv[++i]); }
+        else if (std::strcmp(argv[i], "--event") == 0 && i + 1 < argc) {
+            filter.byEvent = true;
+            filter.event = eventFromKey(argv[++i]);
+            if (filter.event == MissileEvent::None) { usage(); return 2; }
+        }
+        else if (std::strcmp(argv[i], "--from") == 0 && i + 1 < argc) filter.from = static_cast<float>(std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--to") == 0 && i + 1 < argc) filter.to = static_cast<float>(std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--limit") == 0 && i + 1 < argc) filter.limit = std::strtoull(argv[++i], nullptr, 10);
+        else { usage(); return 2; }
+    }
+
+    JournalReader reader;
+    if (!reader.open(path)) {
+        std::fprintf(stderr, "%s\n", reader.lastError().c_str());
+        return 1;
+    }
+
+    if (command == "header") return printHeader(reader);
+    if (command == "dump") return dump(reader, filter);
+    if (command == "stats") return stats(reader, filter);
+    usage();
+    return 2;
+}
@@ -1,7 +1,13 @@
 #pragma once
 
 #include "Point.h"
-#include <windows.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h> // Только для HDC в draw()
+#endif
 
 class Launcher {
 public:
@@ -10,5 +16,7 @@ public:
 
     Launcher();
     Launcher(Point p, int id);
-    void draw(HDC hdc, int winCenterX, int winCenterY) const;
+#ifdef _WIN32
+    void draw(HDC hdc, int winCenterX, int winCenterY) const; // Реализация в GdiDraw.cpp
+#endif
 };
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// --- Файл, отображенный в память только для чтения (mmap / MapViewOfFile) ---
+// Страницы подгружает ОС по мере чтения, поэтому файл в несколько гигабайт не загружается в память целиком.
+// Отображается весь файл сразу: для многогигабайтных файлов нужна 64-битная сборка.
+class MappedFile {
+private:
+    const uint8_t* m_data;
+    size_t m_size;
+    bool m_open;
+#ifdef _WIN32
+    void* m_file;    // HANDLE
+    void* m_mapping; // HANDLE
+#else
+    int m_fd;
+#endif
+    std::string m_lastError;
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // sequential == true: подсказка ОС, что файл будет читаться подряд (упреждающее чтение).
+    bool open(const std::string& path, bool sequential = true);
+    void close();
+
+    bool isOpen() const { return m_open; }
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    const std::string& lastError() const { return m_lastError; }
+};
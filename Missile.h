@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Point.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h> // Только для HDC в draw()
+#endif
+
+// --- Класс Ракеты ---
+// Летит по прямой с постоянной скоростью от пусковой к цели; пройдя точку цели, выходит из игры.
+class Missile {
+public:
+    Point pos;       // Текущая позиция (мировые координаты)
+    Point velocity;  // Вектор скорости (ед./с)
+    Point origin;    // Точка старта
+    float launchTime; // Игровое время начала полета: pos = origin + velocity * (t - launchTime)
+    float arrivalTime; // Игровое время прохода точки цели (дальше ракета летит мимо, см. SimulationState::expireMissiles)
+    bool isActive;   // false: сбита / потеряна / еще не запущена
+    int id;          // ID ракеты (порядковый номер запуска)
+    int launcherId;  // ID запустившей пусковой
+
+    Missile();
+
+    void launch(int missileId, int launcherId, const Point& startPos, const Point& targetPos, float speed, float startTime = 0.0f);
+    void update(float dt);
+
+    // Расстояние до центра (позиции радара (0,0)).
+    float getDistanceToCenter() const { return pos.length(); }
+
+#ifdef _WIN32
+    void draw(HDC hdc, int winCenterX, int winCenterY) const; // Реализация в GdiDraw.cpp
+#endif
+};
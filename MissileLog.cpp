@@ -1 +1,179 @@
+#include "MissileLog.h" // Включаем заголовок класса MissileLog
+#include <cstring>
+#include <cwchar>
 
+// --- Тексты событий ---
+const wchar_t* missileEventName(MissileEvent event) {
+    switch (event) {
+    case MissileEvent::Launched:     return L"Запущена";
+    case MissileEvent::Detected:     return L"Обнаружена";
+    case MissileEvent::Destroyed:    return L"Уничтожена";
+    case MissileEvent::LostDeadZone: return L"Потеряна (мертв.зона)";
+    case MissileEvent::RadarHit:     return L"Поражение радара!";
+    case MissileEvent::Victory:      return L"ПОБЕДА!";
+    case MissileEvent::Missed:       return L"Промах";
+    default:                         return L"?";
+    }
+}
+
+std::wstring formatMissileLogEntry(const MissileLogEntry& entry) {
+    std::wstring text = missileEventName(entry.event);
+    if (entry.event == MissileEvent::Launched) {
+        wchar_t details[96];
+        std::swprintf(details, sizeof(details) / sizeof(details[0]), L" Start=(%g,%g), Target=(%g,%g), Speed=%g",
+            entry.data[0], entry.data[1], entry.data[2], entry.data[3], entry.data[4]);
+        text += details;
+    }
+    return text;
+}
+
+// --- Контрольная сумма событий ---
+static uint64_t digestWord(uint64_t digest, uint32_t word) {
+    for (int i = 0; i < 4; ++i) {
+        digest ^= (word >> (8 * i)) & 0xFFu;
+        digest *= 0x100000001B3ull;
+    }
+    return digest;
+}
+
+static uint32_t floatBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+uint64_t missileLogDigest(uint64_t digest, const MissileLogEntry& entry) {
+    digest = digestWord(digest, static_cast<uint32_t>(entry.missileId));
+    digest = digestWord(digest, static_cast<uint32_t>(entry.launcherId));
+    digest = digestWord(digest, floatBits(entry.timestamp));
+    digest = digestWord(digest, static_cast<uint32_t>(entry.event));
+    for (int i = 0; i < MissileLogEntry::DATA_LEN; ++i) digest = digestWord(digest, floatBits(entry.data[i]));
+    return digest;
+}
+
+
+// --- Упаковка последнего события в одно слово индекса ---
+// Биты 0-31: время (float), 32-39: код события, 40-62: launcherId + 1, 63: признак "есть событие".
+uint64_t MissileLog::packLatest(const MissileLogEntry& entry) {
+    uint32_t timeBits;
+    std::memcpy(&timeBits, &entry.timestamp, sizeof(timeBits));
+    uint64_t launcher = static_cast<uint64_t>(static_cast<uint32_t>(entry.launcherId + 1) & 0x7FFFFFu);
+    return (1ull << 63) | (launcher << 40) | (static_cast<uint64_t>(entry.event) << 32) | timeBits;
+}
+
+MissileLogEntry MissileLog::unpackLatest(int missileId, uint64_t packed) {
+    MissileLogEntry entry = {};
+    if (!(packed >> 63)) {
+        entry.missileId = -1;
+        entry.launcherId = -1;
+        return entry;
+    }
+    uint32_t timeBits = static_cast<uint32_t>(packed);
+    std::memcpy(&entry.timestamp, &timeBits, sizeof(timeBits));
+    entry.missileId = missileId;
+    entry.event = static_cast<MissileEvent>((packed >> 32) & 0xFF);
+    entry.launcherId = static_cast<int>((packed >> 40) & 0x7FFFFFu) - 1;
+    return entry;
+}
+
+// Слот ракеты: сегмент s начинается с ID INDEX_FIRST_SEGMENT * (2^s - 1).
+std::atomic<uint64_t>& MissileLog::latestSlot(size_t missileId) const {
+    size_t q = missileId / INDEX_FIRST_SEGMENT + 1;
+    size_t segment = 0;
+    while (q >>= 1) ++segment;
+    return m_latest[segment][missileId - INDEX_FIRST_SEGMENT * ((static_cast<size_t>(1) << segment) - 1)];
+}
+
+// Запись побеждает, если она не раньше текущей по игровому времени: поток радара пишет время своего снимка,
+// которое может отставать от времени симуляции, и его запоздавшая запись не должна затереть более новое событие.
+void MissileLog::updateLatest(const MissileLogEntry& entry) {
+    if (entry.missileId < 0 || static_cast<size_t>(entry.missileId) >= m_latestCount.load(std::memory_order_acquire)) return;
+    std::atomic<uint64_t>& slot = latestSlot(static_cast<size_t>(entry.missileId));
+    const uint64_t packed = packLatest(entry);
+    uint64_t cur = slot.load(std::memory_order_relaxed);
+    for (;;) {
+        if (cur >> 63) {
+            float curTime;
+            uint32_t curBits = static_cast<uint32_t>(cur);
+            std::memcpy(&curTime, &curBits, sizeof(curTime));
+            if (entry.timestamp < curTime) return;
+        }
+        if (slot.compare_exchange_weak(cur, packed, std::memory_order_release, std::memory_order_relaxed)) return;
+    }
+}
+
+
+// --- Конструктор ---
+// Вся память кольца выделяется здесь, один раз; индекс растет по мере запусков.
+MissileLog::MissileLog(size_t capacity) : m_ring(capacity), m_latestCount(0), m_latestUsed(0), m_latestSegments(0) {}
+
+// Новый сегмент обнуляется один раз при выделении; дальше его занятую часть обнуляет clear().
+void MissileLog::indexMissile(int missileId) {
+    if (missileId < 0) return;
+    const size_t id = static_cast<size_t>(missileId);
+    size_t count = m_latestCount.load(std::memory_order_relaxed);
+    while (id >= count && m_latestSegments < INDEX_SEGMENTS) {
+        const size_t size = INDEX_FIRST_SEGMENT << m_latestSegments;
+        std::unique_ptr<std::atomic<uint64_t>[]> segment(new std::atomic<uint64_t>[size]);
+        for (size_t i = 0; i < size; ++i) segment[i].store(0, std::memory_order_relaxed);
+        m_latest[m_latestSegments++] = std::move(segment);
+        count += size;
+        m_latestCount.store(count, std::memory_order_release); // Сегмент виден читателям только готовым
+    }
+    if (id < count && id >= m_latestUsed) m_latestUsed = id + 1;
+}
+
+// --- Добавление записи (потокобезопасно, без блокировок и выделения памяти) ---
+// Вызывается из потока симуляции и из потока радара.
+void MissileLog::addEntry(int missileId, int launcherId, float timestamp, MissileEvent event) {
+    MissileLogEntry entry = {};
+    entry.missileId = missileId;
+    entry.launcherId = launcherId;
+    entry.timestamp = timestamp;
+    entry.event = event;
+    addEntry(entry);
+}
+
+void MissileLog::addEntry(const MissileLogEntry& entry) {
+    m_ring.push(entry);
+    updateLatest(entry);
+}
+
+// --- Последняя запись для ракеты ---
+// Для ракет из индекса - одно атомарное чтение (параметры data при этом не заполняются).
+// Остальные ищутся с конца кольца. Если записей нет, возвращает запись с missileId == -1.
+MissileLogEntry MissileLog::getLastEntryForMissile(int missileId) const {
+    if (missileId >= 0 && static_cast<size_t>(missileId) < m_latestCount.load(std::memory_order_acquire)) {
+        return unpackLatest(missileId, latestSlot(static_cast<size_t>(missileId)).load(std::memory_order_acquire));
+    }
+    MissileLogEntry found = {};
+    found.missileId = -1;
+    found.launcherId = -1;
+    m_ring.forEachNewest([&](const MissileLogEntry& entry) {
+        if (entry.missileId != missileId) return true;
+        found = entry;
+        return false;
+    });
+    return found;
+}
+
+// --- Последние count записей (от старых к новым) ---
+std::vector<MissileLogEntry> MissileLog::getLastEntries(size_t count) const {
+    std::vector<MissileLogEntry> result;
+    result.reserve(count);
+    m_ring.forEachNewest([&](const MissileLogEntry& entry) {
+        if (result.size() >= count) return false;
+        result.push_back(entry);
+        return true;
+    });
+    return std::vector<MissileLogEntry>(result.rbegin(), result.rend());
+}
+
+// --- Очистка лога ---
+// Безопасна при работающих писателях: старые записи просто становятся невидимыми.
+// Индекс обнуляется только в занятой части (ракеты, прошедшие через indexMissile()); вызывает поток симуляции.
+void MissileLog::clear() {
+    m_ring.clear();
+    for (size_t i = 0; i < m_latestUsed; ++i) latestSlot(i).store(0, std::memory_order_relaxed);
+    m_latestUsed = 0;
+}
@@ -1,42 +1,109 @@
 #pragma once
 
 #include <vector>    
-#include <string>    
-#include <windows.h> 
+#include <string>
+#include <memory>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "EventRing.h"
+
+
+// --- Коды событий журнала ---
+// В записи хранится только код и числовые параметры; текст строится при показе (missileEventName / formatMissileLogEntry).
+// Значения кодов записываются в бинарный журнал (EventJournal.h): новые коды - только в конец.
+enum class MissileEvent : uint8_t {
+    None = 0,        // Нет события (пустая запись)
+    Launched,        // "Запущена"; data: startX, startY, targetX, targetY, speed
+    Detected,        // "Обнаружена"
+    Destroyed,       // "Уничтожена"
+    LostDeadZone,    // "Потеряна (мертв.зона)"
+    RadarHit,        // "Поражение радара!"
+    Victory,         // "ПОБЕДА!" (missileId = launcherId = -1)
+    Missed,          // "Промах": прошла точку цели, не задев базу (цель сценария в стороне от базы)
+    Count
+};
+
+// Короткое название события (статичная строка, без выделения памяти).
+const wchar_t* missileEventName(MissileEvent event);
 
 
 // --- Структура для одной записи в журнале событий ---
+// Запись фиксированного размера без владения кучей.
 struct MissileLogEntry {
-    int missileId;    // ID ракеты
-    int launcherId;   // ID пусковой
-    float timestamp;  // Игровое время
-    std::wstring status; // Описание события
+    enum { DATA_LEN = 5 };
+
+    int missileId;      // ID ракеты
+    int launcherId;     // ID пусковой
+    float timestamp;    // Игровое время
+    MissileEvent event; // Код события
+    float data[DATA_LEN]; // Параметры события (смысл зависит от кода, см. MissileEvent)
 };
 
+// Полный текст записи: название и параметры (например, "Запущена Start=(-400,400), Target=(0,0), Speed=75").
+std::wstring formatMissileLogEntry(const MissileLogEntry& entry);
 
-// Объявляем extern глобальную критическую секцию.
-// Определена и инициализирована в main.cpp. MissileLog будет использовать указатель на нее.
-extern CRITICAL_SECTION g_cs;
+// Контрольная сумма последовательности записей (FNV-1a по всем полям, числа с плавающей точкой - побитно).
+// Начальное значение - MISSILE_LOG_DIGEST_INIT; совпадение сумм означает побитно одинаковые события.
+const uint64_t MISSILE_LOG_DIGEST_INIT = 0xCBF29CE484222325ull;
+uint64_t missileLogDigest(uint64_t digest, const MissileLogEntry& entry);
 
 
 // --- Класс Журнала Событий ---
+// Кольцо фиксированной емкости (EventRing): addEntry() из потока симуляции и потока радара
+// не берет блокировок и не выделяет память, при переполнении затираются самые старые записи,
+// поэтому память не растет при длинных прогонах.
+//
+// Рядом с кольцом - плотный индекс "ID ракеты -> последнее событие": одно атомарное 64-битное слово
+// на ракету (время, код, пусковая). getLastEntryForMissile() для ракет из индекса - одно чтение, O(1).
+// Индекс растет по мере запусков (indexMissile()) сегментами удваивающегося размера: сегмент s хранит
+// INDEX_FIRST_SEGMENT * 2^s ракет, уже выделенные сегменты не перемещаются (другие потоки читают
+// и пишут их без блокировок) и сохраняются между играми. Поэтому память и стоимость перезапуска
+// зависят от числа запущенных ракет, а не от бюджета налета; clear() обнуляет только занятую часть.
+// Ракеты за пределами INDEX_SEGMENTS сегментов ищутся в кольце.
 class MissileLog {
+public:
+    enum { DEFAULT_CAPACITY = 4096 };
+    static const size_t INDEX_FIRST_SEGMENT = 4096;
+    static const size_t INDEX_SEGMENTS = 13; // 4096 * (2^13 - 1) > GameConfig::MAX_MISSILES
+
 private:
-    std::vector<MissileLogEntry> m_entries; // Записи лога
-    CRITICAL_SECTION* m_pCs; // Указатель на глобальную CS
+    EventRing<MissileLogEntry> m_ring; // Записи лога
+    std::unique_ptr<std::atomic<uint64_t>[]> m_latest[INDEX_SEGMENTS]; // Последнее событие по ID ракеты (0 - нет)
+    std::atomic<size_t> m_latestCount; // Ракет в выделенных сегментах (публикуется после выделения)
+    size_t m_latestUsed;               // ID, прошедших через indexMissile() с прошлой очистки (поток симуляции)
+    size_t m_latestSegments;
+
+    static uint64_t packLatest(const MissileLogEntry& entry);
+    static MissileLogEntry unpackLatest(int missileId, uint64_t packed);
+    std::atomic<uint64_t>& latestSlot(size_t missileId) const;
+    void updateLatest(const MissileLogEntry& entry);
 
 public:
-    MissileLog(); // Конструктор
+    explicit MissileLog(size_t capacity = DEFAULT_CAPACITY); // Конструктор
+
+    // Включает ракету missileId (ID выдаются по порядку с 0) в индекс последних событий, при необходимости
+    // выделяя следующий сегмент. Вызывает только поток симуляции, до первой записи о ракете.
+    void indexMissile(int missileId);
 
     // --- Методы ---
-    void initialize(CRITICAL_SECTION* pCs); // Инициализация лога с CS
+    // Потокобезопасные методы (без блокировок)
+    void addEntry(int missileId, int launcherId, float timestamp, MissileEvent event);
+    void addEntry(const MissileLogEntry& entry);
     MissileLogEntry getLastEntryForMissile(int missileId) const;
-    // Потокобезопасные методы
-    void addEntry(int missileId, int launcherId, float timestamp, const std::wstring& status);
-    // Получение последних записей. Значение по умолчанию 10. const-корректный.
+    // Получение последних записей (от старых к новым). Значение по умолчанию 10.
     std::vector<MissileLogEntry> getLastEntries(size_t count = 10) const;
     void clear(); // Очистка лога
 
+    // Последовательное чтение для потребителя: см. EventRing::consume().
+    template <typename F>
+    uint64_t consume(uint64_t& cursor, F&& f) const { return m_ring.consume(cursor, std::forward<F>(f)); }
+
+    size_t capacity() const { return m_ring.capacity(); }
+    uint64_t totalWritten() const { return m_ring.head(); } // Сквозной счетчик записей
+    uint64_t droppedCount() const { return m_ring.dropped(); }
+
     // // Если нужен метод отрисовки лога, то добавтье объявление здесь.
     // void draw(HDC hdc, int x, int y, int maxLines) const;
 };
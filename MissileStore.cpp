@@ -0,0 +1,191 @@
+#include "MissileStore.h" // Включаем заголовок хранилища ракет
+#include <algorithm>      // Для std::lower_bound
+
+// --- Выбор SIMD-набора на этапе компиляции ---
+// AVX: /arch:AVX (MSVC) или -mavx / -march=native (GCC, Clang). SSE2 есть на любом x64.
+#if defined(__AVX__)
+#include <immintrin.h>
+#define MISSILE_STORE_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MISSILE_STORE_SSE2 1
+#endif
+
+MissileStore::MissileStore() : m_activeCount(0) {}
+
+void MissileStore::clear() {
+    // clear() оставляет емкость: перезапуск игры не перевыделяет массивы.
+    m_x.clear();
+    m_y.clear();
+    m_vx.clear();
+    m_vy.clear();
+    m_x0.clear();
+    m_y0.clear();
+    m_t0.clear();
+    m_t1.clear();
+    m_id.clear();
+    m_launcherId.clear();
+    m_active.clear();
+    m_activeCount = 0;
+}
+
+void MissileStore::reserve(size_t capacity) {
+    m_x.reserve(capacity);
+    m_y.reserve(capacity);
+    m_vx.reserve(capacity);
+    m_vy.reserve(capacity);
+    m_x0.reserve(capacity);
+    m_y0.reserve(capacity);
+    m_t0.reserve(capacity);
+    m_t1.reserve(capacity);
+    m_id.reserve(capacity);
+    m_launcherId.reserve(capacity);
+    m_active.reserve(capacity);
+}
+
+// --- Добавление ракеты ---
+size_t MissileStore::add(const Missile& missile) {
+    m_x.push_back(missile.pos.x);
+    m_y.push_back(missile.pos.y);
+    // Неактивная ракета не должна двигаться: скорость обнуляем (см. инварианты в MissileStore.h).
+    m_vx.push_back(missile.isActive ? missile.velocity.x : 0.0f);
+    m_vy.push_back(missile.isActive ? missile.velocity.y : 0.0f);
+    // У неактивной ракеты точка старта - ее текущая позиция (см. инварианты).
+    m_x0.push_back(missile.isActive ? missile.origin.x : missile.pos.x);
+    m_y0.push_back(missile.isActive ? missile.origin.y : missile.pos.y);
+    m_t0.push_back(missile.launchTime);
+    m_t1.push_back(missile.arrivalTime);
+    m_id.push_back(missile.id);
+    m_launcherId.push_back(missile.launcherId);
+    m_active.push_back(missile.isActive ? 1 : 0);
+    if (missile.isActive) ++m_activeCount;
+    return m_x.size() - 1;
+}
+
+// --- Векторизованный пересчет позиций ---
+// pos = origin + velocity * (gameTime - launchTime) (вычитание, умножение и сложение отдельно, без FMA),
+// поэтому SIMD-путь побитово совпадает со скалярным хвостом.
+void MissileStore::update(float gameTime) {
+    const size_t n = m_x.size();
+    float* x = m_x.data();
+    float* y = m_y.data();
+    const float* x0 = m_x0.data();
+    const float* y0 = m_y0.data();
+    const float* t0 = m_t0.data();
+    const float* vx = m_vx.data();
+    const float* vy = m_vy.data();
+    size_t i = 0;
+
+#if defined(MISSILE_STORE_AVX)
+    const __m256 vt = _mm256_set1_ps(gameTime);
+    for (; i + 8 <= n; i += 8) {
+        __m256 age = _mm256_sub_ps(vt, _mm256_load_ps(t0 + i));
+        _mm256_store_ps(x + i, _mm256_add_ps(_mm256_load_ps(x0 + i), _mm256_mul_ps(_mm256_load_ps(vx + i), age)));
+        _mm256_store_ps(y + i, _mm256_add_ps(_mm256_load_ps(y0 + i), _mm256_mul_ps(_mm256_load_ps(vy + i), age)));
+    }
+#elif defined(MISSILE_STORE_SSE2)
+    const __m128 vt = _mm_set1_ps(gameTime);
+    for (; i + 4 <= n; i += 4) {
+        __m128 age = _mm_sub_ps(vt, _mm_load_ps(t0 + i));
+        _mm_store_ps(x + i, _mm_add_ps(_mm_load_ps(x0 + i), _mm_mul_ps(_mm_load_ps(vx + i), age)));
+        _mm_store_ps(y + i, _mm_add_ps(_mm_load_ps(y0 + i), _mm_mul_ps(_mm_load_ps(vy + i), age)));
+    }
+#endif
+
+    // Скалярный хвост (или весь массив без SIMD).
+    for (; i < n; ++i) {
+        float age = gameTime - t0[i];
+        x[i] = x0[i] + vx[i] * age;
+        y[i] = y0[i] + vy[i] * age;
+    }
+}
+
+// --- Сборка объекта Missile по индексу ---
+Missile MissileStore::get(size_t i) const {
+    Missile m;
+    m.pos = { m_x[i], m_y[i] };
+    m.velocity = { m_vx[i], m_vy[i] };
+    m.origin = { m_x0[i], m_y0[i] };
+    m.launchTime = m_t0[i];
+    m.arrivalTime = m_t1[i];
+    m.isActive = m_active[i] != 0;
+    m.id = m_id[i];
+    m.launcherId = m_launcherId[i];
+    return m;
+}
+
+void MissileStore::deactivate(size_t i) {
+    if (!m_active[i]) return;
+    m_active[i] = 0;
+    m_x0[i] = m_x[i]; // Ракета замирает в текущей позиции.
+    m_y0[i] = m_y[i];
+    m_vx[i] = 0.0f;
+    m_vy[i] = 0.0f;
+    --m_activeCount;
+}
+
+void MissileStore::deactivateAll() {
+    std::fill(m_active.begin(), m_active.end(), static_cast<uint8_t>(0));
+    std::copy(m_x.begin(), m_x.end(), m_x0.begin());
+    std::copy(m_y.begin(), m_y.end(), m_y0.begin());
+    std::fill(m_vx.begin(), m_vx.end(), 0.0f);
+    std::fill(m_vy.begin(), m_vy.end(), 0.0f);
+    m_activeCount = 0;
+}
+
+// --- Поиск по ID ---
+// ID отсортированы по возрастанию (см. инварианты), поэтому бинарный поиск.
+long MissileStore::findById(int missileId) const {
+    auto it = std::lower_bound(m_id.begin(), m_id.end(), missileId);
+    if (it == m_id.end() || *it != missileId) return -1;
+    return static_cast<long>(it - m_id.begin());
+}
+
+// --- Удаление неактивных ракет (стабильное уплотнение всех массивов за один проход) ---
+size_t MissileStore::removeInactive() {
+    const size_t n = m_x.size();
+    if (m_activeCount == n) return 0; // Нечего удалять.
+    size_t w = 0;
+    for (size_t r = 0; r < n; ++r) {
+        if (!m_active[r]) continue;
+        if (w != r) {
+            m_x[w] = m_x[r];
+            m_y[w] = m_y[r];
+            m_vx[w] = m_vx[r];
+            m_vy[w] = m_vy[r];
+            m_x0[w] = m_x0[r];
+            m_y0[w] = m_y0[r];
+            m_t0[w] = m_t0[r];
+            m_t1[w] = m_t1[r];
+            m_id[w] = m_id[r];
+            m_launcherId[w] = m_launcherId[r];
+            m_active[w] = 1;
+        }
+        ++w;
+    }
+    m_x.resize(w);
+    m_y.resize(w);
+    m_vx.resize(w);
+    m_vy.resize(w);
+    m_x0.resize(w);
+    m_y0.resize(w);
+    m_t0.resize(w);
+    m_t1.resize(w);
+    m_id.resize(w);
+    m_launcherId.resize(w);
+    m_active.resize(w);
+    return n - w;
+}
+
+// --- Совместимость: активные ракеты как std::vector<Missile> ---
+void MissileStore::copyActiveTo(std::vector<Missile>& out) const {
+    out.clear(); // Емкость out сохраняется между вызовами.
+    out.reserve(m_activeCount);
+    const size_t n = m_x.size();
+    for (size_t i = 0; i < n; ++i) {
+        if (m_active[i]) {
+            out.push_back(get(i));
+        }
+    }
+}
+
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "Point.h"
+#include "Missile.h"
+#include "AlignedAllocator.h"
+
+// --- Хранилище ракет "структура массивов" (SoA) ---
+// Координаты, скорости, ID и флаги лежат в отдельных выровненных массивах,
+// поэтому update() пересчитывает все ракеты за один проход SIMD-ядром (AVX / SSE2 / скалярный хвост).
+// Для старого кода есть get(i) и copyActiveTo() -> std::vector<Missile>.
+// Снимок для радара строит BearingIndex::build() прямо из сырых массивов.
+//
+// Позиция не накапливается по тикам, а считается от точки старта: pos = origin + velocity * (t - launchTime).
+// Она зависит только от игрового времени, а не от того, сколькими шагами до него дошли, поэтому
+// событийный движок (EventEngine.h) может пропускать тики без изменения результата.
+//
+// Инварианты:
+// - ID добавляются по возрастанию (порядок запуска), removeInactive() сохраняет порядок,
+//   поэтому findById() - бинарный поиск.
+// - У неактивной ракеты скорость обнулена, а точка старта равна последней позиции:
+//   ядро считает все элементы без маски, неактивные стоят на месте.
+class MissileStore {
+private:
+    AlignedVector<float> m_x;
+    AlignedVector<float> m_y;
+    AlignedVector<float> m_vx;
+    AlignedVector<float> m_vy;
+    AlignedVector<float> m_x0;  // Точка старта
+    AlignedVector<float> m_y0;
+    AlignedVector<float> m_t0;  // Игровое время начала полета
+    std::vector<float> m_t1;    // Игровое время прохода точки цели
+    std::vector<int> m_id;
+    std::vector<int> m_launcherId;
+    std::vector<uint8_t> m_active;
+    size_t m_activeCount;
+
+public:
+    MissileStore();
+
+    void clear();
+    void reserve(size_t capacity);
+    size_t size() const { return m_x.size(); }
+    size_t activeCount() const { return m_activeCount; }
+    bool anyActive() const { return m_activeCount > 0; }
+
+    // Добавляет ракету (копирует поля Missile, включая origin и launchTime). Возвращает индекс.
+    size_t add(const Missile& missile);
+
+    // Векторизованный пересчет позиций на игровое время gameTime: pos = origin + velocity * (gameTime - launchTime).
+    void update(float gameTime);
+
+    // --- Доступ к элементу по индексу ---
+    bool isActive(size_t i) const { return m_active[i] != 0; }
+    int id(size_t i) const { return m_id[i]; }
+    int launcherId(size_t i) const { return m_launcherId[i]; }
+    Point pos(size_t i) const { return { m_x[i], m_y[i] }; }
+    Point origin(size_t i) const { return { m_x0[i], m_y0[i] }; }
+    Point velocity(size_t i) const { return { m_vx[i], m_vy[i] }; }
+    float launchTime(size_t i) const { return m_t0[i]; }
+    float arrivalTime(size_t i) const { return m_t1[i]; }
+    float distanceSqToCenter(size_t i) const { return m_x[i] * m_x[i] + m_y[i] * m_y[i]; }
+    Missile get(size_t i) const;
+
+    void deactivate(size_t i);
+    void deactivateAll();
+
+    // Индекс ракеты с данным ID или -1.
+    long findById(int missileId) const;
+
+    // Удаляет неактивные ракеты с сохранением порядка. Возвращает число удаленных.
+    size_t removeInactive();
+
+    // Совместимость со старым API: активные ракеты в виде std::vector<Missile> (out перезаписывается).
+    void copyActiveTo(std::vector<Missile>& out) const;
+
+    // --- Сырые массивы для пакетных ядер ---
+    const float* xData() const { return m_x.data(); }
+    const float* yData() const { return m_y.data(); }
+    const float* vxData() const { return m_vx.data(); }
+    const float* vyData() const { return m_vy.data(); }
+    const int* idData() const { return m_id.data(); }
+    const int* launcherIdData() const { return m_launcherId.data(); }
+    const uint8_t* activeData() const { return m_active.data(); }
+};
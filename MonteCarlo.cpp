@@ -0,0 +1,163 @@
+#include "MonteCarlo.h"
+#include "SimulationState.h"
+#include "EventEngine.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <thread>
+
+// --- Распределение по играм ---
+Distribution Distribution::of(std::vector<float> values) {
+    Distribution d;
+    d.count = values.size();
+    if (values.empty()) return d;
+    std::sort(values.begin(), values.end());
+    double sum = 0.0;
+    for (float v : values) sum += v;
+    d.mean = sum / static_cast<double>(values.size());
+    auto rank = [&values](double q) {
+        size_t i = static_cast<size_t>(std::ceil(q * static_cast<double>(values.size())));
+        return values[i > 0 ? i - 1 : 0];
+    };
+    d.min = values.front();
+    d.p05 = rank(0.05);
+    d.p25 = rank(0.25);
+    d.p50 = rank(0.50);
+    d.p75 = rank(0.75);
+    d.p95 = rank(0.95);
+    d.max = values.back();
+    return d;
+}
+
+// Игра - отдельный поток чисел серии (Xoshiro256::streamSeed): соседние номера дают несвязанные значения.
+uint64_t monteCarloGameSeed(uint64_t seed, int gameIndex) {
+    return Xoshiro256::streamSeed(seed, static_cast<uint64_t>(gameIndex));
+}
+
+// --- Рабочий поток: берет очередную игру, пока они есть ---
+// Задание job - игра job % games конфигурации job / games; итог пишется в outcomes[job].
+// SimulationState один на поток и переиспользуется: initialize() сбрасывает игру, емкость массивов сохраняется.
+static void monteCarloWorker(const std::vector<GameConfig>& sharedConfigs, const MonteCarloOptions& options,
+                             std::atomic<long long>& nextJob, std::vector<GameOutcome>& outcomes) {
+    const long long games = options.games;
+    const long long jobs = games * static_cast<long long>(sharedConfigs.size());
+    std::unique_ptr<SimulationState> state(new SimulationState());
+    EventEngine engine(*state);
+    GameConfig config;       // Своя копия текущей конфигурации: потоки не читают общих данных во время игры.
+    size_t configIndex = sharedConfigs.size();
+
+    for (;;) {
+        long long job = nextJob.fetch_add(1, std::memory_order_relaxed);
+        if (job >= jobs) break;
+
+        size_t c = static_cast<size_t>(job / games);
+        if (c != configIndex) {
+            configIndex = c;
+            config = sharedConfigs[c];
+            config.event_journal.clear();
+            config.input_recording.clear();
+            config.radar_scan_threads = 1; // Параллелизм - по играм: позиции радаров в игре сканируются по очереди.
+        }
+
+        GameOutcome outcome;
+        outcome.seed = monteCarloGameSeed(options.seed, static_cast<int>(job % games));
+        state->seed(outcome.seed);
+        state->initialize(config, RadarMode::Lockstep);
+        if (options.eventDriven) {
+            EventEngineStats stats = engine.run(config, options.dt, options.maxGameTime);
+            outcome.ticks = static_cast<long long>(stats.ticks);
+            outcome.updates = static_cast<long long>(stats.updates);
+        }
+        else {
+            while (!state->isGameOver() && state->getGameTime() < options.maxGameTime) {
+                state->update(options.dt, config);
+                ++outcome.ticks;
+            }
+            outcome.updates = outcome.ticks;
+        }
+        outcome.finished = state->isGameOver();
+        outcome.won = outcome.finished && state->hasPlayerWon();
+        outcome.gameTime = state->getGameTime();
+        outcome.launched = state->getMissilesLaunched();
+        outcome.destroyed = state->getMissilesDestroyed();
+        outcome.maxMissiles = state->getMaxMissiles();
+        outcome.assignmentSolves = static_cast<long long>(state->getAssignmentSolves());
+        outcome.assignmentNsTotal = state->getAssignmentNsTotal();
+        outcome.assignmentNsMax = state->getAssignmentNsMax();
+        outcomes[static_cast<size_t>(job)] = outcome;
+    }
+    state->shutdown();
+}
+
+// --- Сводка по итогам игр одной конфигурации ---
+static void summarize(MonteCarloSummary& summary) {
+    std::vector<float> lossTimes, winTimes, killRatios;
+    long long assignmentNsTotal = 0;
+    lossTimes.reserve(summary.outcomes.size());
+    killRatios.reserve(summary.outcomes.size());
+    for (const GameOutcome& o : summary.outcomes) {
+        if (!o.finished) ++summary.timeouts;
+        else if (o.won) { ++summary.wins; winTimes.push_back(o.gameTime); }
+        else { ++summary.losses; lossTimes.push_back(o.gameTime); }
+        summary.launched += o.launched;
+        summary.destroyed += o.destroyed;
+        summary.ticks += o.ticks;
+        summary.updates += o.updates;
+        summary.assignmentSolves += o.assignmentSolves;
+        assignmentNsTotal += o.assignmentNsTotal;
+        if (o.assignmentNsMax * 1e-3 > summary.assignmentUsMax) summary.assignmentUsMax = o.assignmentNsMax * 1e-3;
+        if (o.launched > 0) killRatios.push_back(static_cast<float>(o.destroyed) / static_cast<float>(o.launched));
+    }
+    if (summary.games > 0) {
+        double n = static_cast<double>(summary.games);
+        summary.winRate = summary.wins / n;
+        summary.winRateCi95 = 1.96 * std::sqrt(summary.winRate * (1.0 - summary.winRate) / n);
+    }
+    if (summary.assignmentSolves > 0) summary.assignmentUsMean = assignmentNsTotal * 1e-3 / summary.assignmentSolves;
+    summary.killRatio = summary.launched > 0 ? static_cast<double>(summary.destroyed) / static_cast<double>(summary.launched) : 0.0;
+    summary.killRatioPerGame = Distribution::of(std::move(killRatios));
+    summary.timeToLoss = Distribution::of(std::move(lossTimes));
+    summary.timeToWin = Distribution::of(std::move(winTimes));
+}
+
+std::vector<MonteCarloSummary> runMonteCarloBatch(const std::vector<GameConfig>& configs, const MonteCarloOptions& options) {
+    MonteCarloOptions opts = options;
+    opts.games = options.games > 0 ? options.games : 0;
+    const long long jobs = static_cast<long long>(opts.games) * static_cast<long long>(configs.size());
+
+    int threads = options.threads > 0 ? options.threads : static_cast<int>(std::thread::hardware_concurrency());
+    if (threads < 1) threads = 1;
+    if (threads > jobs) threads = jobs > 0 ? static_cast<int>(jobs) : 1;
+
+    std::vector<GameOutcome> outcomes(static_cast<size_t>(jobs));
+    std::atomic<long long> nextJob(0);
+
+    auto wallStart = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    pool.reserve(static_cast<size_t>(threads - 1));
+    for (int t = 1; t < threads; ++t) {
+        pool.emplace_back(monteCarloWorker, std::cref(configs), std::cref(opts), std::ref(nextJob), std::ref(outcomes));
+    }
+    monteCarloWorker(configs, opts, nextJob, outcomes); // Вызывающий поток работает наравне с остальными.
+    for (auto& th : pool) th.join();
+    double wallSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    std::vector<MonteCarloSummary> summaries(configs.size());
+    for (size_t c = 0; c < configs.size(); ++c) {
+        MonteCarloSummary& summary = summaries[c];
+        summary.games = opts.games;
+        summary.threads = threads;
+        summary.wallSec = wallSec; // Время всего прогона (конфигурации идут вперемешку)
+        auto first = outcomes.begin() + static_cast<std::ptrdiff_t>(c * static_cast<size_t>(opts.games));
+        summary.outcomes.assign(first, first + opts.games);
+        summarize(summary);
+    }
+    return summaries;
+}
+
+MonteCarloSummary runMonteCarlo(const GameConfig& config, const MonteCarloOptions& options) {
+    std::vector<MonteCarloSummary> summaries = runMonteCarloBatch(std::vector<GameConfig>(1, config), options);
+    return std::move(summaries.front());
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "GameConfig.h"
+#include "Random.h"
+
+// --- Прогон Монте-Карло: много независимых безоконных игр одной конфигурации ---
+// Итог игры зависит от случайных задержек запусков и выбора пусковой, поэтому одна игра ничего не говорит
+// о конфигурации. runMonteCarlo() раздает игры потокам: у каждого потока свой SimulationState
+// (радар без потока, свой MissileLog), у каждой игры - свое начальное значение генератора.
+// Общего у потоков только счетчик следующей игры и массив итогов (каждый элемент пишет один поток),
+// поэтому скорость растет почти линейно с числом ядер.
+//
+// Начальное значение игры i зависит только от (seed, i): результат не зависит от числа потоков,
+// а любую игру можно повторить отдельно (BatchRunner --seed <gameSeed>).
+//
+// runMonteCarloBatch() прогоняет сразу несколько конфигураций (перебор параметров, SweepRunner.cpp):
+// все пары (конфигурация, игра) идут в одну очередь одного пула, SimulationState потока переиспользуется
+// между конфигурациями. Игра i каждой конфигурации получает одно и то же начальное значение, поэтому
+// конфигурации сравниваются на одинаковых последовательностях запусков.
+
+struct MonteCarloOptions {
+    int games = 1000;
+    int threads = 0;              // 0 - std::thread::hardware_concurrency()
+    uint64_t seed = 0;            // Базовое начальное значение серии
+    float dt = 0.03f;             // Шаг симуляции (как SIMULATION_STEP в main.cpp)
+    float maxGameTime = 3600.0f;  // Игра дольше считается TIMEOUT
+    bool eventDriven = false;     // EventEngine: тики без событий пропускаются (итоги те же, см. EventEngine.h)
+};
+
+// Итог одной игры.
+struct GameOutcome {
+    uint64_t seed = 0;
+    bool finished = false;  // false - TIMEOUT
+    bool won = false;
+    float gameTime = 0.0f;
+    int launched = 0;
+    int destroyed = 0;
+    int maxMissiles = 0;
+    long long ticks = 0;
+    long long updates = 0;  // Выполнено update() (меньше ticks у событийного движка)
+    long long assignmentSolves = 0;   // Решений назначения огневых каналов (radar_fire_channels > 0)
+    long long assignmentNsTotal = 0;
+    long long assignmentNsMax = 0;
+};
+
+// Распределение величины по играм (перцентили - ближайший ранг).
+struct Distribution {
+    size_t count = 0;
+    double mean = 0.0;
+    float min = 0.0f, p05 = 0.0f, p25 = 0.0f, p50 = 0.0f, p75 = 0.0f, p95 = 0.0f, max = 0.0f;
+
+    static Distribution of(std::vector<float> values);
+};
+
+struct MonteCarloSummary {
+    int games = 0;
+    int threads = 0;
+    int wins = 0;
+    int losses = 0;
+    int timeouts = 0;
+    double winRate = 0.0;
+    double winRateCi95 = 0.0;       // Половина 95% доверительного интервала (нормальное приближение)
+    long long launched = 0;
+    long long destroyed = 0;
+    double killRatio = 0.0;         // Сбито / запущено по всем играм
+    Distribution killRatioPerGame;  // Сбито / запущено в каждой игре
+    Distribution timeToLoss;        // Игровое время до поражения (только проигранные игры)
+    Distribution timeToWin;         // Игровое время до победы
+    long long ticks = 0;
+    long long updates = 0;
+    long long assignmentSolves = 0;
+    double assignmentUsMean = 0.0;  // Среднее время решения назначения, мкс
+    double assignmentUsMax = 0.0;
+    double wallSec = 0.0;
+    std::vector<GameOutcome> outcomes; // Индекс - номер игры
+};
+
+// Начальное значение генератора игры gameIndex серии seed.
+uint64_t monteCarloGameSeed(uint64_t seed, int gameIndex);
+
+// Журнал событий и запись ввода (config.event_journal, config.input_recording) в прогоне Монте-Карло не пишутся.
+MonteCarloSummary runMonteCarlo(const GameConfig& config, const MonteCarloOptions& options);
+std::vector<MonteCarloSummary> runMonteCarloBatch(const std::vector<GameConfig>& configs, const MonteCarloOptions& options);
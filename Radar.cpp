@@ -1,33 +1,22 @@
-#define NOMINMAX
-#include <windows.h>
 #include "Radar.h"
-#include "SimulationState.h"
+#include "BeamKernel.h"
 #include <algorithm> 
 #include <limits>    
 #include <chrono>    
 #include <cmath>    
 #include <utility> 
 #include <string> 
-#include <objbase.h>
-#include <windows.h> 
+#include <thread>
+#include <mutex>
 
-// Объявление extern глобальной критической секции g_cs
-// Радар (через свой указатель m_pCs) использует ее для синхронизации доступа к разделяемому состоянию m_state.
-extern CRITICAL_SECTION g_cs;
-
-
-// --- Объявление extern глобального объекта состояния симуляции ---
-
-// Этот класс (в методе draw()) обращается к g_simulationState (которая синхронизирована SimulationState-ом),
-//но прямой доступ к вектору ракет в Radar::draw() небезопасен без внешней блокировки,
-// которая и выполняется здесь через m_pCs (указывающий на g_cs).
-extern SimulationState g_simulationState; 
+// Состояние радара m_state публикуется через seqlock, снимки ракет - через тройной буфер: блокировок нет.
+// Шаги по игровому времени (Lockstep/Pipelined) и правило назначения целей - в RadarNetwork.
+// Окно рисует радар по RenderFrame (копия RadarState), а не по самому объекту.
 
 
 
 // --- Конструктор класса Radar ---
 // Инициализирует члены класса начальными значениями.
-// Инициализирует ВНУТРЕННЮЮ Critical Section снимка (m_snapshotCs).
 Radar::Radar() :
     pos({ 0.0f, 0.0f }), // Позиция радара фиксирована в центре игровых координат (0,0).
                          // Эта позиция не меняется в данной симуляции.
@@ -42,320 +31,475 @@ Radar::Radar() :
              0.0f,      // beamWidth - Ширина луча.
              0.0f,      // radar_range - Радиус внешнего (ЗЕЛЕНОГО) круга.
              0.0f,      // engagementRadius - Радиус среднего (ЖЕЛТОГО) круга.
-             0.0f }),    // deadZoneRadius - Радиус внутреннего (КРАСНОГО) круга.
+             0.0f,      // deadZoneRadius - Радиус внутреннего (КРАСНОГО) круга.
+             0.0f,      // sweepStartAngle - Начало последнего шага сканирования.
+             0.0f }),   // sweepArc - Поворот луча за последний шаг.
 
-    m_pCs(nullptr), // Указатель на ГЛОБАЛЬНУЮ CS (будет присвоен в initialize).
-    m_hThread(NULL), // Дескриптор потока логики радара (будет создан в initialize). NULL = 0.
     m_stopThread(false), // Атомарный флаг для остановки потока (false: не остановлен).
-    m_hWnd(NULL), // Дескриптор окна (для MessageBox из потока, будет присвоен в initialize).
+    m_armed(false),      // Поток еще не взведен.
+    m_parked(true),      // Потока нет - считается на парковке.
     m_pMissileLog(nullptr), // Указатель на лог (для записи об обнаружении, присвоен в initialize).
-    m_latestGameTimeSnapshot(0.0f) // Время последнего снимка ракет (нач. 0.0f).
+    m_mode(RadarMode::Lockstep), // Режим задается в initialize().
+    // Счетчики обмена снимками (сбрасываются также в initialize).
+    m_statPublishes(0), m_statOverwritten(0), m_statPublishNsTotal(0), m_statPublishNsMax(0),
+    m_statReads(0), m_statFreshReads(0), m_statAgeNsTotal(0), m_statAgeNsMax(0)
 {
-    // Инициализация внутренней Critical Section для защиты m_missileSnapshot и m_latestGameTimeSnapshot.
-    InitializeCriticalSection(&m_snapshotCs);
+    // m_snapshots (тройной буфер) синхронизируется атомарным индексом, явной инициализации не требует.
+    m_scan = RadarScan();
     // Инициализация m_lastUpdateTime здесь или в initialize
     m_lastUpdateTime = std::chrono::high_resolution_clock::now();
 } 
 
 
 // --- Деструктор класса Radar ---
-// Отвечает за корректную очистку управляемых ресурсов: остановка потока и удаление внутренней CS.
+// Отвечает за корректную очистку управляемых ресурсов: остановка потока.
 Radar::~Radar() {
     shutdown(); // Сигнализируем потоку об остановке и ждем его завершения.
-    DeleteCriticalSection(&m_snapshotCs); // Удаляем внутреннюю Critical Section снимка (после завершения потока!).
 } 
 
 
 // --- Метод инициализации объекта Radar ---
-// Вызывается из SimulationState::initialize при старте или перезапуске игры.
-// Настраивает состояние радара, сохраняет внешние зависимости (CS, HWND, Log) и запускает поток логики.
-void Radar::initialize(const GameConfig& config, CRITICAL_SECTION* pCs, HWND hWnd, MissileLog* pLog) {
-    // Если радар уже работает (т.е. hThread не NULL), корректно завершаем предыдущую работу.
-    shutdown(); // Это установит m_stopThread и дождется завершения старого потока run().
-
-    // --- Важно: Сохраняем указатель на ГЛОБАЛЬНУЮ критическую секцию ---
-    // m_pCs будет использоваться во всех потокобезопасных методах доступа к m_state.
-    // pCs указывает на g_cs, которая должна быть инициализирована в main.cpp ДО вызова этого метода.
-    m_pCs = pCs;
-
-    // Сохраняем дескриптор окна и указатель на журнал событий.
-    m_hWnd = hWnd;
-    m_pMissileLog = pLog;
-
-    // Сбрасываем флаг остановки потока - новый поток должен начать работать.
-    m_stopThread = false;
+// Вызывается из RadarNetwork::initialize при старте или перезапуске игры.
+// Настраивает позицию и состояние радара, сохраняет журнал и (Threaded) запускает поток логики.
+void Radar::initialize(const RadarSite& site, MissileLog* pLog, RadarMode mode, size_t trackCapacity, const TrackFilterParams& filter) {
+    // Если поток радара сканирует прошлую игру, паркуем его: после park() он не трогает ни буферы, ни лог.
+    park();
 
-    // --- Инициализация m_state (состояние радара) под защитой ГЛОБАЛЬНОЙ CS ---
-    EnterCriticalSection(m_pCs); // Захватываем глобальную CS g_cs для безопасного доступа к m_state.
+    // Сохраняем указатель на журнал событий и позицию.
+    m_pMissileLog = pLog;
+    pos = site.pos;
 
+    // --- Инициализация m_state (состояние радара): публикуем всю структуру одной записью seqlock ---
+    RadarState state;
     // Сброс состояния при новой игре/симуляции.
-    m_state.currentAngle = 0.0f; // Начинаем сканирование с 0 радиан.
-    m_state.isOperational = true; // Радар включается.
-    m_state.detectedMissileId = -1; // Нет обнаруженной цели.
-    m_state.detectionTime = 0.0f; // Время обнаружения 0.
-
-    // Копируем актуальные параметры из GameConfig в m_state.
-    m_state.sweepSpeed = config.radar_sweep_speed;     // Скорость сканирования (в радианах/с).
-    m_state.beamWidth = config.radar_beam_width;         // Ширина луча (в радианах).
-    m_state.radar_range = config.radar_range;               // Внешний ЗЕЛЕНЫЙ радиус.
-    m_state.engagementRadius = config.radar_engagement_radius; // Средний ЖЕЛТЫЙ радиус.
-    m_state.deadZoneRadius = config.danger_zone_radius;     // Внутренний КРАСНЫЙ радиус.
-
-    LeaveCriticalSection(m_pCs); // Освобождаем глобальную CS.
-
-
-    // --- Очищаем данные снимка активных ракет ---
-    EnterCriticalSection(&m_snapshotCs); // Захватываем внутреннюю CS снимка для безопасного доступа к m_missileSnapshot.
-    m_missileSnapshot.clear(); // Очищаем снимок.
-    m_latestGameTimeSnapshot = 0.0f; // Сбрасываем время снимка.
-    LeaveCriticalSection(&m_snapshotCs); // Освобождаем внутреннюю CS снимка.
+    state.currentAngle = 0.0f; // Начинаем сканирование с 0 радиан.
+    state.isOperational = true; // Радар включается.
+    state.detectedMissileId = -1; // Нет обнаруженной цели.
+    state.detectionTime = 0.0f; // Время обнаружения 0.
+
+    // Копируем параметры этого радара (для основного - ключи radar_* GameConfig).
+    state.sweepSpeed = site.sweepSpeed;               // Скорость сканирования (в радианах/с).
+    state.beamWidth = site.beamWidth;                 // Ширина луча (в радианах).
+    state.radar_range = site.range;                   // Внешний ЗЕЛЕНЫЙ радиус.
+    state.engagementRadius = site.engagementRadius;   // Средний ЖЕЛТЫЙ радиус.
+    state.deadZoneRadius = site.deadZoneRadius;       // Внутренний КРАСНЫЙ радиус.
+    state.sweepStartAngle = 0.0f; // Луч еще не двигался.
+    state.sweepArc = 0.0f;
+
+    m_state.write(state);
+
+    // Кольца азимутального индекса совпадают с зонами радара.
+    m_bearingIndex.configure(site.deadZoneRadius, site.engagementRadius, site.range);
+
+
+    // --- Очищаем снимки активных ракет ---
+    // Поток радара на парковке (park() выше), а поток симуляции вызывает нас сам,
+    // поэтому буферы можно сбросить без синхронизации. Емкость массивов сохраняется.
+    m_snapshots.resetEach([](PublishedSnapshot& s) {
+        s.missiles.clear();
+        s.gameTime = 0.0f;
+        s.publishedAt = std::chrono::steady_clock::time_point();
+    });
+    m_lockstepSnapshot.missiles.clear();
+    m_lockstepSnapshot.gameTime = 0.0f;
+    m_scan = RadarScan();
+    m_tracks.reset(trackCapacity, filter); // Таблица треков - целиком здесь, за игру память не выделяется
+    m_statPublishes = 0; m_statOverwritten = 0; m_statPublishNsTotal = 0; m_statPublishNsMax = 0;
+    m_statReads = 0; m_statFreshReads = 0; m_statAgeNsTotal = 0; m_statAgeNsMax = 0;
+    m_mode = mode;
 
 
     // Инициализируем время последнего обновления для расчета dt в потоке run().
     m_lastUpdateTime = std::chrono::high_resolution_clock::now();
 
-    // --- Запускаем новый поток для выполнения логики радара (метода run()) ---
-    // Создаем поток, передавая адрес статической функции RadarThreadProc и указатель на этот объект (this).
-    m_hThread = CreateThread(
-        NULL,          // Атрибуты защиты по умолчанию.
-        0,             // Размер стека по умолчанию.
-        RadarThreadProc, // Указатель на функцию потока (статическая).
-        this,          // Параметр, передаваемый в функцию потока (указатель на текущий объект Radar).
-        0,             // Флаги создания (0: поток сразу начинает работать).
-        NULL           // Идентификатор потока (не нужен нам).
-    );
-    // Проверяем, успешно ли создан поток. CreateThread возвращает NULL при сбое.
-    if (m_hThread == NULL) {
-        // Если не удалось создать поток, выводим сообщение об ошибке и радар не будет работать.
-        MessageBox(m_hWnd, L"Не удалось создать поток радара!", L"Ошибка", MB_OK | MB_ICONERROR);
+    // Без потока сканированием управляет RadarNetwork (scanStep/commitScan).
+    if (m_mode != RadarMode::Threaded) return;
+
+    // --- Взводим поток логики радара (метод run()) ---
+    // Поток создается один раз, при первой игре в режиме Threaded; дальше он только паркуется и взводится.
+    {
+        std::lock_guard<std::mutex> lock(m_controlMutex);
+        m_armed = true;
+    }
+    if (m_thread.joinable()) {
+        m_control.notify_all();
+        return;
+    }
+    m_stopThread = false;
+    try {
+        m_thread = std::thread(RadarThreadProc, this);
+    }
+    catch (const std::system_error&) {
+        // Если не удалось создать поток, радар не будет работать.
+        // Игра продолжится без обнаружения целей (проигрыш виден на экране/в итоге пакетного прогона).
         setOperational(false); // Устанавливаем статус радар как нерабочий (потокобезопасно).
     }
 } // Конец initialize()
 
 
+// --- Парковка потока радара ---
+// Вызывается из initialize() и RadarNetwork при конце игры. Снимает взвод и ждет, пока поток закончит
+// текущий шаг и встанет на парковку: ожидание - не дольше одного step(), без сна и без join().
+void Radar::park() {
+    std::unique_lock<std::mutex> lock(m_controlMutex);
+    m_armed = false;
+    if (!m_thread.joinable()) return;
+    m_control.notify_all();
+    m_control.wait(lock, [this] { return m_parked; });
+} // Конец park()
+
+
 // --- Метод завершения работы объекта Radar ---
-// Вызывается из SimulationState::shutdown. Сигнализирует потоку run() об остановке
-// и ЖДЕТ его завершения, затем закрывает дескриптор потока.
+// Вызывается из SimulationState::shutdown и деструктора. Сигнализирует потоку run() об остановке
+// и ЖДЕТ его завершения.
 void Radar::shutdown() {
-    m_stopThread = true; // Устанавливаем атомарный флаг остановки потока run().
-                        // Поток run() проверяет этот флаг в условии своего основного цикла.
-
-    // Если дескриптор потока существует и он еще не NULL (поток был успешно создан).
-    if (m_hThread != NULL) {
-        // Ждем завершения потока (WaitForSingleObject). Таймаут 500мс.
-        // Если поток не завершится за это время, продолжим (это лучше, чем вечная блокировка).
-        DWORD waitResult = WaitForSingleObject(m_hThread, 500); // WAIT_TIMEOUT = 258 (если превышен таймаут)
-        // if (waitResult == WAIT_TIMEOUT) { /* Optional: Log a timeout warning */ }
-
-        CloseHandle(m_hThread); // Закрываем дескриптор потока, освобождая ресурс ядра.
-        m_hThread = NULL; // Сбрасываем дескриптор, чтобы не пытаться закрыть/ждать несуществующий поток снова.
+    {
+        std::lock_guard<std::mutex> lock(m_controlMutex);
+        m_armed = false;
+        m_stopThread = true; // Поток run() проверяет этот флаг на парковке и в паузах.
+    }
+    m_control.notify_all();
+
+    // Если поток был успешно создан и еще не присоединен.
+    if (m_thread.joinable()) {
+        // Паузы потока прерываются m_control, поэтому ожидание - не дольше одного шага.
+        m_thread.join();
     }
 } // Конец shutdown()
 
 
 // --- Статическая точка входа для потока логики радара (RadarThreadProc) ---
-// Эта функция должна иметь специфическую сигнатуру DWORD WINAPI function_name(LPVOID parameter)
-// для использования с функцией CreateThread().
-// Она просто принимает указатель на объект Radar (переданный в CreateThread), преобразует его
+// Принимает указатель на объект Radar (переданный в std::thread)
 // и вызывает нестатический метод run() для этого объекта.
-DWORD WINAPI Radar::RadarThreadProc(LPVOID lpParam) {
-    Radar* pRadar = static_cast<Radar*>(lpParam);
+// Исключения не должны выходить за пределы потока (иначе std::terminate).
+void Radar::RadarThreadProc(Radar* pRadar) {
     try {
         if (pRadar) {
             pRadar->run(); 
         }
     }
-    catch (const std::exception& ex) {
-        
-
-        return 1; 
-    }
     catch (...) 
     {
-        return 0; 
+        // Поток радара просто завершается; park() не должен ждать его вечно.
+        if (pRadar) {
+            std::lock_guard<std::mutex> lock(pRadar->m_controlMutex);
+            pRadar->m_parked = true;
+        }
+        if (pRadar) pRadar->m_control.notify_all();
     }
-   
-    return 0; 
 }
 
 
 void Radar::run() {
-    
-    float currentAngle_local; 
-    float sweepSpeed_local;     // Скорость вращения луча (рад/с).
-    float beamWidth_local;      // Ширина луча (радианы).
-    float radar_range_local;        // Радиус внешнего ЗЕЛЕНОГО круга (Внешняя граница Обнаружения).
-    float engagementRadius_local;   // Радиус среднего ЖЕЛТОГО круга (Зона Поражения).
-    float deadZoneRadius_local;     // Радиус внутреннего КРАСНОГО круга (Мертвая Зона / Внутр. граница Обнаружения).
-
-
-    EnterCriticalSection(m_pCs); // Захватываем глобальную критическую секцию g_cs для доступа к m_state.
-
-    currentAngle_local = m_state.currentAngle; // Читаем начальный угол.
-    // Копируем параметры из m_state в локальные переменные потока.
-    sweepSpeed_local = m_state.sweepSpeed;
-    beamWidth_local = m_state.beamWidth;
-    radar_range_local = m_state.radar_range;          // Копируем радиус Зеленой зоны.
-    engagementRadius_local = m_state.engagementRadius; // Копируем радиус Желтой зоны.
-    deadZoneRadius_local = m_state.deadZoneRadius;    // Копируем радиус Красной зоны.
-
-    LeaveCriticalSection(m_pCs); 
-    while (!m_stopThread.load()) { // Используем load() для чтения атомарной переменной.
-        // --- Расчет времени кадра (dt) ---
-        auto currentTime = std::chrono::high_resolution_clock::now(); // Текущее точное время.
-        std::chrono::duration<float> elapsed = currentTime - m_lastUpdateTime; // Время с прошлого кадра.
-        float dt = elapsed.count(); // Дельта времени в секундах.
-        m_lastUpdateTime = currentTime; // Обновляем время последнего кадра для следующего шага.
-
-
-        // --- Проверка операционного статуса радара ---
-        bool isOperationalStatus = isOperational(); // Используем публичный геттер; он потокобезопасен (использует m_pCs).
-        if (!isOperationalStatus) 
-        {
-            // Если радар не работает, спим некоторое время и пропускаем логику сканирования/поиска в этом цикле.
-            Sleep(100); // Короткий сон, чтобы не грузить CPU пустым циклом.
-            continue; // Переходим к следующей итерации цикла while.
+    std::unique_lock<std::mutex> lock(m_controlMutex);
+    for (;;) {
+        // --- Парковка: между играми поток ждет взвода (initialize()) или остановки (shutdown()) ---
+        m_parked = true;
+        m_control.notify_all();
+        m_control.wait(lock, [this] { return m_armed || m_stopThread.load(); });
+        if (m_stopThread.load()) break;
+        m_parked = false;
+        m_lastUpdateTime = std::chrono::high_resolution_clock::now(); // Время стоянки не входит в dt.
+
+        while (m_armed && !m_stopThread.load()) {
+            lock.unlock();
+            // --- Расчет времени кадра (dt) ---
+            auto currentTime = std::chrono::high_resolution_clock::now(); // Текущее точное время.
+            std::chrono::duration<float> elapsed = currentTime - m_lastUpdateTime; // Время с прошлого кадра.
+            float dt = elapsed.count(); // Дельта времени в секундах.
+            m_lastUpdateTime = currentTime; // Обновляем время последнего кадра для следующего шага.
+
+            // --- Проверка операционного статуса радара ---
+            // Нерабочий радар не сканирует и ждет дольше, чтобы не грузить CPU пустым циклом.
+            bool isOperationalStatus = isOperational(); // Используем публичный геттер; он потокобезопасен (чтение seqlock).
+            if (isOperationalStatus) step(dt); // Один шаг сканирования по реальному (настенному) времени.
+            std::chrono::milliseconds pause(isOperationalStatus ? 10 : 100);
+
+            // Пауза - ожидание на m_control: парковка и остановка прерывают ее сразу.
+            lock.lock();
+            m_control.wait_for(lock, pause, [this] { return !m_armed || m_stopThread.load(); });
         }
+    }
+    m_parked = true;
+    m_control.notify_all();
+    // Поток закончил свою работу.
+} // Конец метода run()
 
 
-        // --- ОБНОВЛЕНИЕ угла сканирования ---
-        // Увеличиваем локальный угол сканирования на sweepSpeed * dt.
-        currentAngle_local = normalizeAngle(currentAngle_local + sweepSpeed_local * dt); // normalizeAngle из Point.h.
-
-
-        // --- Получаем актуальный ЛОКАЛЬНЫЙ СНИМОК ракет и игровое время ---
-        // Этот снимок был сделан основным потоком (SimulationState::update) и используется здесь ТОЛЬКО ДЛЯ ЧТЕНИЯ.
-        // Доступ к снимку защищен внутренней CS m_snapshotCs.
-        std::vector<Missile> missilesSnapshotCopy; // Создаем вектор для копирования снимка.
-        float currentGameTime;                   // Переменная для времени снимка.
-        EnterCriticalSection(&m_snapshotCs); // Захватываем ВНУТРЕННЮЮ Critical Section снимка.
-        missilesSnapshotCopy = m_missileSnapshot; // Копируем весь вектор снимка (эффективно для небольшого кол-ва ракет).
-        currentGameTime = m_latestGameTimeSnapshot; // Читаем время, соответствующее этому снимку.
-        LeaveCriticalSection(&m_snapshotCs); // Освобождаем ВНУТРЕННЮЮ Critical Section снимка.
-
-
-        // --- Логика: Поиск НОВОЙ цели для ПЕРВИЧНОГО ОБНАРУЖЕНИЯ ---
-        // Радар сканирует пространство в поисках НОВОЙ цели ТОЛЬКО если в данный момент он НЕ отслеживает никакую другую цель.
-        int currentDetectedId = getDetectedMissileId(); // Получаем ID цели, которую радар уже отслеживает (потокобезопасно).
-        std::pair<int, int> foundTargetInfo = { -1, -1 };
-        foundTargetInfo = findTarget
-        (
-            missilesSnapshotCopy,   // Снимок активных ракет.
-            currentAngle_local,     // Текущий угол сканирования луча.
-            beamWidth_local,        // Ширина луча.
-            radar_range_local,      // Внешний радиус ЗОНЫ ОБНАРУЖЕНИЯ (ЗЕЛЕНЫЙ круг).
-            deadZoneRadius_local    // Внутренний радиус ЗОНЫ ОБНАРУЖЕНИЯ (КРАСНЫЙ/МЕРТВАЯ зона).
-        );
-        // Если currentDetectedId != -1, радар УЖЕ ОТСЛЕЖИВАЕТ ЦЕЛЬ, findTarget НЕ ВЫЗЫВАЕТСЯ в этом цикле run().
-        // Логика отслеживания и сбития/потери цели в этом случае находится в SimulationState::update.
-
-
-        // --- Синхронизация ОБНОВЛЕННОГО ЛОКАЛЬНОГО состояния с общим m_state (под защитой ГЛОБАЛЬНОЙ CS m_pCs) ---
-        // В этом блоке обновляем: 1. Текущий угол сканирования в m_state. 2. Информацию о НОВОЙ ОБНАРУЖЕННОЙ цели, если найдена.
-        EnterCriticalSection(m_pCs); // Захватываем глобальную критическую секцию g_cs для доступа к m_state.
-
-        // 1. Обновляем текущий угол сканирования в общем состоянии радара m_state.
-        m_state.currentAngle = currentAngle_local;
-
-        // 2. Логика ПЕРВОГО ОБНАРУЖЕНИЯ и сохранения информации о цели:
-        // Если findTarget НАШЕЛ потенциальную цель (его ID != -1), И в общем состоянии радара НЕ БЫЛО отслеживаемой цели (m_state.detectedMissileId == -1, это условие было проверено выше, поэтому можно просто if (foundTargetInfo.first != -1)).
-        if (foundTargetInfo.first != -1 && m_state.detectedMissileId == -1) 
-        {
-            // Это НОВАЯ цель, которая впервые попала в СКАНИРУЮЩИЙ луч радара ВНУТРИ ЗОНЫ ОБНАРУЖЕНИЯ.
-            m_state.detectedMissileId = foundTargetInfo.first; // Запоминаем ее уникальный ID.
-            m_state.detectionTime = currentGameTime;           // Запоминаем игровое время, когда цель была обнаружена.
-
-            // --- Логирование СОБЫТИЯ ОБНАРУЖЕНИЯ ---
-            // Добавляем запись в журнал событий MissileLog (он потокобезопасен внутри).
-            if (m_pMissileLog) 
-            { // Проверяем, что указатель на лог валиден.
-                // addEntry ожидает (missileId, launcherId, timestamp, status string).
-                m_pMissileLog->addEntry(m_state.detectedMissileId, foundTargetInfo.second, m_state.detectionTime, L"Обнаружена");
-            }
-        }
-        // Если findTarget ничего не нашел (или не был вызван), И радар что-то отслеживал (detectedMissileId != -1),
-        // то либо цель вне текущего луча (но радар ее все еще отслеживает), либо она уже сбита/потеряна (тогда SimulationState::update сбросит detectedMissileId).
-        // Этот поток НЕ СБРАСЫВАЕТ detectedMissileId! Это делает SimulationState::update через вызов clearDetectedMissile().
+// --- Один шаг сканирования радара ---
+// Поворачивает луч на sweepSpeed * dt, ищет НОВУЮ цель, через которую луч прошел за этот поворот, и фиксирует обнаружение.
+// Вызывается из run() (поток радара, dt по настенным часам).
+void Radar::step(float dt) {
+    // Согласованная копия всего состояния за одно чтение seqlock (без блокировки).
+    RadarState state = m_state.read();
+    if (!state.isOperational) return; // Нерабочий радар не сканирует.
 
-        LeaveCriticalSection(m_pCs); // Освобождаем глобальную критическую секцию.
+    // --- ОБНОВЛЕНИЕ угла сканирования ---
+    // Увеличиваем угол сканирования на sweepSpeed * dt.
+    float arc = state.sweepSpeed * dt;
+    scan(state, acquireSnapshot(), normalizeAngle(state.currentAngle + arc), arc, dt); // normalizeAngle из Point.h.
+} // Конец метода step()
 
 
-        Sleep(10); // Короткая пауза для потока (10 мс) для снижения нагрузки на CPU.
-    } // Конец цикла while (!m_stopThread.load()). Поток завершается, когда m_stopThread становится true.
+// --- Шаг сканирования по игровому времени (радар без потока, вызывает RadarNetwork) ---
+// Угол - функция игрового времени (beamAngleAt), а не сумма шагов, поэтому он одинаков при любом числе
+// тиков до этого момента (см. EventEngine.h). Снимок ракет - того же тика.
+void Radar::prepareScan(const MissileStore& missiles, float gameTime) {
+    m_bearingIndex.build(missiles, m_lockstepSnapshot.missiles, pos);
+    m_lockstepSnapshot.gameTime = gameTime;
+}
 
-    // Поток закончил свою работу.
-} // Конец метода run()
+void Radar::scanStep(const MissileStore& missiles, float gameTime, float dt, const std::vector<int>& excluded) {
+    if (!beginScan(gameTime, dt)) return;
+    prepareScan(missiles, gameTime);
+    searchCandidates(dt, excluded);
+}
 
+void Radar::scanStep(const MissileFrame& missiles, float gameTime, float dt, const std::vector<int>& excluded) {
+    if (!beginScan(gameTime, dt)) return;
+    m_bearingIndex.build(missiles, m_lockstepSnapshot.missiles, pos);
+    m_lockstepSnapshot.gameTime = gameTime;
+    searchCandidates(dt, excluded);
+}
 
-// --- Реализация метода findTarget ---
-// Этот метод вызывается из run(). Ищет ближайшую АКТИВНУЮ ракету в ПЕРЕДАННОМ снимке
-// (не меняет оригинал) и проверяет, находится ли она:
-// 1. В дальностном кольце ОБНАРУЖЕНИЯ (СТРОГО > deadZoneRadius, <= range - где range = radar_range_local).
-// 2. В текущем СКАНИРУЮЩЕМ луче (ширина beamWidth вокруг угла currentScanAngle).
-// Возвращает std::pair{ID ракеты, ID пусковой установки}, если найдена, или {-1, -1}, если нет.
-std::pair<int, int> Radar::findTarget(const std::vector<Missile>& missilesSnapshot, float currentScanAngle, float beamWidth, float range, float deadZoneRadius) {
-    // Используем квадрат расстояния для сравнения - это быстрее, чем std::sqrt().
-    float closestDistSq = std::numeric_limits<float>::max();
-
-    int foundMissileId = -1;         // Переменная для хранения ID найденной ракеты. Изначально -1 (не найдена).
-    int foundMissileLauncherId = -1; // Переменная для хранения Launcher ID найденной ракеты.
-
-    // Итерируем по каждой ракете в переданном снимке. Снимок - это копия, работаем безопасно.
-    for (const auto& missile : missilesSnapshot) {
-        if (!missile.isActive) continue; // Проверяем только активные ракеты.
-
-        float missileDist = missile.getDistanceToCenter(); // Получаем расстояние ракеты до центра (позиции радара).
-
-        // 1. Проверка нахождения ракеты в дальностном кольце ОБНАРУЖЕНИЯ: (Красный, Зеленый].
-        // Ракета должна быть ЗА пределами КРАСНОГО круга (Мертвая зона)
-        // И ВНУТРИ или НА границе ЗЕЛЕНОГО внешнего круга (граница Radar::range).
-        // isMissileInRangeRingInternal() - наш приватный метод, который выполняет эту проверку.
-        bool isInRangeRing = isMissileInRangeRingInternal(missileDist, range, deadZoneRadius);
-
-        // 2. Проверка нахождения ракеты в пределах углов ТЕКУЩЕГО СКАНИРУЮЩЕГО луча:
-        // Угол ракеты должен попадать в сектор, определяемый currentScanAngle и beamWidth.
-        // isMissileInBeam() - наш СТАТИЧЕСКИЙ метод, выполняет проверку углового положения.
-        bool isInScanBeam = Radar::isMissileInBeam(missile.pos, currentScanAngle, beamWidth);
-
-        // Ракета считается ПОДХОДЯЩЕЙ ДЛЯ ОБНАРУЖЕНИЯ, если она активна И находится в ПРАВИЛЬНОЙ дальности И в текущем секторе сканирования.
-        if (isInRangeRing && isInScanBeam) {
-            // Если ракета подходит, вычисляем ее квадрат расстояния до центра
-            float distSq = missile.pos.x * missile.pos.x + missile.pos.y * missile.pos.y; // Квадрат расстояния.
-
-            // Ищем ближайшую ракету СРЕДИ ВСЕХ подходящих в этом луче/диапазоне.
-            if (distSq < closestDistSq) {
-                closestDistSq = distSq;          // Обновляем минимальный квадрат расстояния.
-                foundMissileId = missile.id;       // Сохраняем ID этой ближайшей ракеты.
-                foundMissileLauncherId = missile.launcherId; // Сохраняем Launcher ID этой ракеты (Missile имеет член launcherId).
-            }
+bool Radar::beginScan(float gameTime, float dt) {
+    RadarState state = m_state.read();
+    m_scan.operational = state.isOperational;
+    m_scan.searched = false;
+    m_scan.candidates.clear();
+    if (!state.isOperational) return false;
+
+    m_scan.sweepStart = state.currentAngle;
+    m_scan.arc = state.sweepSpeed * dt;
+    m_scan.newAngle = beamAngleAt(state.sweepSpeed, gameTime);
+    m_scan.gameTime = gameTime;
+    // Полная таблица треков - новые цели не ищем (и индекс не строим): завязать трек все равно негде,
+    // пока SimulationState не сбросит какой-нибудь.
+    m_scan.freeSlots = static_cast<int>(m_tracks.freeSlots());
+    m_scan.searched = m_scan.freeSlots > 0;
+    return m_scan.searched;
+} // Конец метода beginScan()
+
+void Radar::searchCandidates(float dt, const std::vector<int>& excluded) {
+    RadarState state = m_state.read(); // Параметры луча
+    m_scan.candidates.resize(static_cast<size_t>(m_scan.freeSlots) + RadarScan::SPARE_CANDIDATES);
+    int count = findTargets(m_lockstepSnapshot.missiles, m_scan.sweepStart, m_scan.arc, dt,
+                            state.beamWidth, state.radar_range, state.engagementRadius, state.deadZoneRadius,
+                            excluded.data(), excluded.size(), m_scan.candidates.data(), static_cast<int>(m_scan.candidates.size()));
+    m_scan.candidates.resize(static_cast<size_t>(count));
+} // Конец метода searchCandidates()
+
+// Завязка треков и события - в порядке accepted; таблицу в это время никто другой не трогает (TrackTable.h).
+void Radar::commitScan(const std::vector<int>& accepted) {
+    if (!m_scan.operational) return;
+    for (int k : accepted) {
+        const RadarCandidate& detected = m_scan.candidates[static_cast<size_t>(k)];
+        if (!m_tracks.add(detected.missileId, detected.launcherId, m_scan.gameTime, detected.x, detected.y)) break;
+        if (m_pMissileLog) {
+            m_pMissileLog->addEntry(detected.missileId, detected.launcherId, m_scan.gameTime, MissileEvent::Detected);
         }
-    } // Конец цикла по снимку ракет.
+    }
+    const RadarScan& scan = m_scan;
+    m_state.update([&scan](RadarState& shared) {
+        shared.sweepStartAngle = scan.sweepStart;
+        shared.sweepArc = scan.arc;
+        shared.currentAngle = scan.newAngle;
+    });
+} // Конец метода commitScan()
+
+
+// --- Поворот луча без поиска цели ---
+// Для пропущенных тиков событийного движка: он заранее знает, что новых обнаружений на них нет.
+// Сектор шага публикуется так же, как в scan(): от него зависит проверка поражения на следующем тике.
+void Radar::sweepTo(float gameTime, float dt) {
+    m_state.update([gameTime, dt](RadarState& shared) {
+        if (!shared.isOperational) return;
+        shared.sweepStartAngle = shared.currentAngle;
+        shared.sweepArc = shared.sweepSpeed * dt;
+        shared.currentAngle = beamAngleAt(shared.sweepSpeed, gameTime);
+    });
+}
 
-    // --- Возвращаем результат поиска ---
-    // Если foundMissileId все еще -1, подходящая цель не была найдена.
-    // Иначе возвращаем ID и LauncherID найденной ближайшей подходящей ракеты.
-    if (foundMissileId != -1) {
-        return { foundMissileId, foundMissileLauncherId }; // Используем std::pair
+
+// Угол луча в момент gameTime при старте из 0: sweepSpeed * gameTime по модулю 2*PI (в double - без потери
+// точности на больших временах).
+float Radar::beamAngleAt(float sweepSpeed, float gameTime) {
+    const double TWO_PI = 6.283185307179586476925286766559;
+    double a = std::fmod(static_cast<double>(sweepSpeed) * static_cast<double>(gameTime), TWO_PI);
+    if (a < 0.0) a += TWO_PI;
+    float angle = static_cast<float>(a);
+    return angle < 2.0f * M_PI_F ? angle : 0.0f;
+}
+
+
+// --- Последний снимок, опубликованный потоком симуляции (только поток радара) ---
+// Забираем последний опубликованный кадр тройного буфера: без блокировки и без копирования.
+// front() принадлежит только этому потоку, пока мы снова не вызовем acquire().
+const Radar::PublishedSnapshot& Radar::acquireSnapshot() {
+    bool fresh = m_snapshots.acquire();
+    const PublishedSnapshot& snapshot = m_snapshots.front();
+    m_statReads.store(m_statReads.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (fresh) {
+        uint64_t ageNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - snapshot.publishedAt).count());
+        m_statFreshReads.store(m_statFreshReads.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        m_statAgeNsTotal.store(m_statAgeNsTotal.load(std::memory_order_relaxed) + ageNs, std::memory_order_relaxed);
+        if (ageNs > m_statAgeNsMax.load(std::memory_order_relaxed)) m_statAgeNsMax.store(ageNs, std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+
+// --- Поиск новой цели, через которую прошел луч, и публикация угла ---
+// state - копия состояния, прочитанная вызывающим (радар работает). Луч повернулся от state.currentAngle
+// на arc радиан до newAngle; ракеты за это время пролетели motionDt секунд.
+void Radar::scan(const RadarState& state, const PublishedSnapshot& snapshot, float newAngle, float arc, float motionDt) {
+    float sweepStart_local = state.currentAngle;
+    float currentAngle_local = newAngle;
+    float beamWidth_local = state.beamWidth;            // Ширина луча (радианы).
+    float radar_range_local = state.radar_range;        // Радиус внешнего ЗЕЛЕНОГО круга (Внешняя граница Обнаружения).
+    float deadZoneRadius_local = state.deadZoneRadius;  // Радиус внутреннего КРАСНОГО круга (Мертвая Зона / Внутр. граница Обнаружения).
+
+
+    // --- Поиск НОВОЙ цели в актуальном СНИМКЕ ракет ---
+    // Этот снимок был сделан основным потоком (SimulationState::update) и используется здесь ТОЛЬКО ДЛЯ ЧТЕНИЯ.
+    float currentGameTime = snapshot.gameTime; // Игровое время, соответствующее этому снимку.
+    RadarCandidate nearest;
+    int found = findTargets
+    (
+        snapshot.missiles,      // Снимок активных ракет.
+        sweepStart_local,       // Угол луча в начале шага.
+        arc,                    // Поворот луча за шаг.
+        motionDt,               // Время полета ракет за шаг.
+        beamWidth_local,        // Ширина луча.
+        radar_range_local,      // Внешний радиус ЗОНЫ ОБНАРУЖЕНИЯ (ЗЕЛЕНЫЙ круг).
+        state.engagementRadius, // Радиус ЗОНЫ ПОРАЖЕНИЯ (ЖЕЛТЫЙ круг): цель, которая в нее не войдет, не берется.
+        deadZoneRadius_local,   // Внутренний радиус ЗОНЫ ОБНАРУЖЕНИЯ (КРАСНЫЙ/МЕРТВАЯ зона).
+        nullptr, 0,             // Других радаров у потока нет - исключать некого.
+        &nearest, 1             // Только ближайшая.
+    );
+    std::pair<int, int> foundTargetInfo = found ? std::make_pair(nearest.missileId, nearest.launcherId) : std::make_pair(-1, -1);
+    // Логика отслеживания и сбития/потери уже обнаруженной цели находится в SimulationState::update.
+
+
+    // --- Логика ПЕРВОГО ОБНАРУЖЕНИЯ ---
+    // Если findTargets НАШЕЛ потенциальную цель (его ID != -1), И у радара НЕ БЫЛО отслеживаемой цели.
+    // Назначить цель (ID != -1) может только этот метод, а SimulationState лишь сбрасывает ее в -1,
+    // поэтому прочитанное выше "целей нет" между чтением и записью измениться не может.
+    // Событие пишем в журнал ДО публикации: иначе поток симуляции мог бы успеть записать "Уничтожена" раньше "Обнаружена".
+    bool newDetection = foundTargetInfo.first != -1 && state.detectedMissileId == -1;
+    if (newDetection && m_pMissileLog) {
+        // addEntry ожидает (missileId, launcherId, timestamp, код события). MissileLog потокобезопасен внутри.
+        m_pMissileLog->addEntry(foundTargetInfo.first, foundTargetInfo.second, currentGameTime, MissileEvent::Detected);
+    }
+
+
+    // --- Публикация ОБНОВЛЕННОГО состояния ---
+    // Чтение-изменение-запись seqlock: меняем только угол и, при обнаружении, цель;
+    // поля, которые тем временем мог изменить поток симуляции (isOperational, сброс цели), не затираются.
+    m_state.update([&](RadarState& shared) {
+        // 1. Обновляем текущий угол сканирования и сектор, накрытый за шаг.
+        shared.sweepStartAngle = sweepStart_local;
+        shared.sweepArc = arc;
+        shared.currentAngle = currentAngle_local;
+
+        // 2. Запоминаем НОВУЮ цель, впервые попавшую в СКАНИРУЮЩИЙ луч ВНУТРИ ЗОНЫ ОБНАРУЖЕНИЯ.
+        if (newDetection && shared.detectedMissileId == -1 && shared.isOperational) {
+            shared.detectedMissileId = foundTargetInfo.first; // Запоминаем ее уникальный ID.
+            shared.detectionTime = currentGameTime;           // Запоминаем игровое время, когда цель была обнаружена.
+        }
+    });
+    // Этот метод НЕ СБРАСЫВАЕТ detectedMissileId! Это делает SimulationState::update через вызов clearDetectedMissile().
+} // Конец метода scan()
+
+
+// --- Реализация метода findTargets ---
+// Этот метод вызывается из scan() и searchCandidates(). Ищет ближайшие ракеты в ПЕРЕДАННОМ снимке
+// (не меняет оригинал), через которые за шаг прошел СКАНИРУЮЩИЙ луч (повернулся от sweepStartAngle на sweepArc),
+// причем в момент прохода ракета была в дальностном кольце ОБНАРУЖЕНИЯ (СТРОГО > deadZoneRadius, <= range).
+// Проверяется весь накрытый сектор против движения ракеты за шаг (sweptBeamHit), поэтому при крупном шаге
+// или быстром луче ракета не проскакивает между двумя положениями луча.
+// Кандидатов отбирает пакетное ядро beamSelect() по сектору шага (без atan2/fmod/sqrt), расширенному на смещение
+// ракет за шаг: снимок хранит позиции конца шага, а луч мог пройти через ракету раньше.
+// Координаты снимка - относительно радара. Ракеты из excluded (цели других радаров) и ракеты, которые
+// в зону поражения этого радара уже не войдут (canEngage), пропускаются: иначе радар держал бы цель впустую.
+// Пишет в out до maxOut ракет по возрастанию (квадрат расстояния, ID) и возвращает их число.
+int Radar::findTargets(const MissileSnapshot& missilesSnapshot, float sweepStartAngle, float sweepArc, float motionDt,
+                       float beamWidth, float range, float engagementRadius, float deadZoneRadius,
+                       const int* excluded, size_t excludedCount, RadarCandidate* out, int maxOut) {
+    // Сектор, накрытый лучом за шаг, ограниченный кольцом (Красный, Зеленый].
+    BeamSector beam = BeamSector::makeSwept(sweepStartAngle, sweepArc, beamWidth, deadZoneRadius, range);
+    int count = 0;
+
+    // Пустой снимок (до первого тика симуляции) еще не имеет корзин.
+    if (missilesSnapshot.bucketStart.empty() || maxOut <= 0) return 0;
+
+    // Запрос кандидатов по позициям конца шага. Ракета, через которую луч прошел в момент шага, была тогда
+    // в секторе и в кольце, а к концу шага сместилась не больше чем на reach. Поэтому кольцо запроса -
+    // (deadZoneRadius - reach, range + reach] (с корзинами мертвой зоны и за дальностью), а сектор расширен
+    // на угол, под которым reach виден с внутренней границы кольца (при reach >= deadZoneRadius - весь круг).
+    const float reach = missilesSnapshot.maxSpeed * motionDt * 1.001f; // Запас на округление float
+    BeamSector query = beam;
+    int ringMin = BearingGrid::RING_ENGAGE;
+    int ringMax = BearingGrid::RING_DETECT;
+    if (reach > 0.0f) {
+        float widen = reach < deadZoneRadius ? std::asin(reach / deadZoneRadius) : M_PI_F;
+        query = BeamSector::makeSwept(sweepStartAngle - widen, sweepArc + 2.0f * widen, beamWidth, deadZoneRadius - reach, range + reach);
+        if (deadZoneRadius <= reach) query.minRangeSq = -1.0f;
+        ringMin = BearingGrid::RING_DEAD;
+        ringMax = BearingGrid::RING_OUTSIDE;
     }
-    return { -1, -1 }; // Нет подходящей цели в текущем сканирующем луче в зоне обнаружения.
-} // Конец реализации findTarget()
 
+    // (distSq, id) раньше, чем кандидат c: ближе, а при равенстве - с меньшим ID (как при полном переборе по ID).
+    auto closer = [](float distSq, int id, const RadarCandidate& c) {
+        return distSq < c.distSq || (distSq == c.distSq && id < c.missileId);
+    };
+
+    // Перебираем только корзины азимутального индекса под сектором запроса в его кольцах:
+    // стоимость шага зависит от числа ракет под лучом, а не от общего числа ракет.
+    missilesSnapshot.grid.forEachRangeInBeam(query, ringMin, ringMax, missilesSnapshot.bucketStart.data(),
+        [&](uint32_t begin, uint32_t end) {
+            if (begin == end) return;
+            size_t len = end - begin;
+            if (m_beamHits.size() < len) m_beamHits.resize(len); // Буфер индексов (емкость переиспользуется).
+            size_t hitCount = beamSelect(query, missilesSnapshot.x.data() + begin, missilesSnapshot.y.data() + begin, len, m_beamHits.data());
+
+            for (size_t k = 0; k < hitCount; ++k) {
+                uint32_t i = begin + m_beamHits[k];
+                float x = missilesSnapshot.x[i];
+                float y = missilesSnapshot.y[i];
+                // Точная проверка: где была ракета, когда луч через нее проходил (начало шага - x - v * dt).
+                if (!sweptBeamHit(x - missilesSnapshot.vx[i] * motionDt, y - missilesSnapshot.vy[i] * motionDt, x, y,
+                                  sweepStartAngle, sweepArc, beamWidth, deadZoneRadius, range)) continue;
+                int id = missilesSnapshot.id[i];
+                if (excludedCount && std::binary_search(excluded, excluded + excludedCount, id)) continue;
+                if (!canEngage(x, y, missilesSnapshot.vx[i], missilesSnapshot.vy[i], engagementRadius)) continue;
+                float distSq = x * x + y * y;
+                if (count == maxOut && !closer(distSq, id, out[count - 1])) continue;
+
+                // Вставка в отсортированный список (при переполнении последний выпадает).
+                int slot = count < maxOut ? count++ : maxOut - 1;
+                while (slot > 0 && closer(distSq, id, out[slot - 1])) {
+                    out[slot] = out[slot - 1];
+                    --slot;
+                }
+                out[slot].missileId = id;
+                out[slot].launcherId = missilesSnapshot.launcherId[i];
+                out[slot].distSq = distSq;
+                out[slot].x = x;
+                out[slot].y = y;
+            }
+        });
 
-// --- Реализация вспомогательной приватной функции: isMissileInRangeRingInternal ---
-// Этот метод проверяет ТОЛЬКО ДАЛЬНОСТЬ ракеты. Находится ли она в кольце (deadZoneRadius, range].
-// Используется методом findTarget(). Приватный. Const-корректный. Реализация ОДИН РАЗ.
-bool Radar::isMissileInRangeRingInternal(float dist, float range, float deadZoneRadius) const { // Реализация ОДИН РАЗ. const в конце.
-    // dist > deadZoneRadius   (строго больше радиуса Красной зоны - ЗА ее пределами)
-    // dist <= range         (меньше ИЛИ РАВНО радиусу Зеленой зоны - ВНУТРИ или НА ее границе)
-    return dist > deadZoneRadius && dist <= range;
-} // Конец реализации isMissileInRangeRingInternal()
+    return count;
+} // Конец реализации findTargets()
 
 
 // --- Реализация вспомогательной СТАТИЧЕСКОЙ геометрической функции: isMissileInBeam ---
 // Этот метод проверяет ТОЛЬКО УГОЛ ракеты. Попадает ли точка (позиция ракеты)
 // в угловой сектор ("луч"), определенный центром (0,0), углом луча и его шириной.
-// Используется findTarget() (в потоке радара, для сканирования)
-// и SimulationState::update (для проверки вхождения в луч захвата - хотя сейчас logic in SS handles this based on detected ID not actual beam).
+// Эталонная скалярная версия: рабочие пути (findTargets, SimulationState, отрисовка) используют BeamSector
+// из BeamKernel.h без atan2/fmod; эта функция остается для сравнения в BeamBench.cpp.
 // СТАТИЧЕСКАЯ функция: не имеет доступа к членам конкретного объекта Radar (кроме статических). const не применяется. Реализация ОДИН РАЗ.
 bool Radar::isMissileInBeam(const Point& missilePos, float radarAngle, float beamWidth) { // static перед bool. Реализация ОДИН РАЗ.
     // Вычисляем угол ракеты относительно центра (0,0) - позиции радара.
@@ -378,254 +522,99 @@ bool Radar::isMissileInBeam(const Point& missilePos, float radarAngle, float bea
 
 // --- Реализация updateMissileSnapshot ---
 // Этот метод вызывается ИЗ основного потока SimulationState::update.
-// Его задача - скопировать текущий вектор активных ракет и текущее игровое время
-// во внутренние члены Radar (m_missileSnapshot, m_latestGameTimeSnapshot)
-// для потока run(). Это должно быть потокобезопасно (под защитой m_snapshotCs).
-void Radar::updateMissileSnapshot(const std::vector<Missile>& activeMissiles, float currentGameTime) {
-    // Захватываем ВНУТРЕННЮЮ Critical Section снимка для безопасной записи в m_missileSnapshot и m_latestGameTimeSnapshot.
-    EnterCriticalSection(&m_snapshotCs); // Захват CS снимка.
-
-    m_missileSnapshot = activeMissiles; // Копируем ВЕСЬ вектор активных ракет из основного потока в вектор снимка радара.
-    m_latestGameTimeSnapshot = currentGameTime; // Сохраняем игровое время, соответствующее этому снимку.
-
-    LeaveCriticalSection(&m_snapshotCs); // Освобождение CS снимка.
+// Его задача - разложить активные ракеты из MissileStore по корзинам азимутального индекса
+// прямо в свободный буфер m_snapshots и опубликовать его вместе с игровым временем для потока run().
+// Блокировок нет: back() принадлежит только потоку симуляции, публикация - один атомарный обмен индексов.
+void Radar::updateMissileSnapshot(const MissileStore& missiles, float currentGameTime) {
+    if (m_mode != RadarMode::Threaded) {
+        prepareScan(missiles, currentGameTime); // Радар без потока: снимок нужен только шагу этого же тика.
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+
+    PublishedSnapshot& back = m_snapshots.back();
+    m_bearingIndex.build(missiles, back.missiles, pos); // Перезаписывает буфер целиком (емкость переиспользуется).
+    back.gameTime = currentGameTime;               // Игровое время, соответствующее этому снимку.
+    back.publishedAt = std::chrono::steady_clock::now();
+    uint64_t publishNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(back.publishedAt - start).count());
+    bool overwritten = m_snapshots.publish();      // Радар не успел прочитать предыдущий кадр - он просто заменен.
+    // После publish() буфер back больше не наш - не трогаем его.
+
+    m_statPublishes.store(m_statPublishes.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (overwritten) m_statOverwritten.store(m_statOverwritten.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    m_statPublishNsTotal.store(m_statPublishNsTotal.load(std::memory_order_relaxed) + publishNs, std::memory_order_relaxed);
+    if (publishNs > m_statPublishNsMax.load(std::memory_order_relaxed)) m_statPublishNsMax.store(publishNs, std::memory_order_relaxed);
 } // Конец updateMissileSnapshot()
 
 
-void Radar::draw(HDC hdc, int winCenterX, int winCenterY) const {
-    // Читаем актуальное состояние радара потокобезопасно через публичные геттеры.
-    bool isOperationalStatus = isOperational();          // Работает ли радар?
-    float currentAngle = getCurrentAngle();             // Текущий угол сканирования для луча.
-    float beamWidth = getBeamWidth();                     // Ширина луча сканирования.
-
-    // --- Получаем радиусы трех зон ИЗ СОСТОЯНИЯ ЧЕРЕЗ ГЕТТЕРЫ ---
-    float outerGreenRadius = getRange();            // Радиус внешнего ЗЕЛЕНОГО круга.
-    float middleYellowRadius = getEngagementRadius(); // Радиус среднего ЖЕЛТОГО круга (Зона Поражения).
-    float deadZoneRedRadius = getDeadZoneRadius();    // Радиус внутреннего КРАСНОГО круга (Мертвая зона).
-
-    int detectedMissileId = getDetectedMissileId(); // ID ракеты, которую радар отслеживает для сбития (-1 если нет).
-
-
-    // Вычисляем экранные координаты центра радара (он в мировых (0,0)).
-    int screenX = static_cast<int>(pos.x + winCenterX);
-    int screenY = static_cast<int>(-pos.y + winCenterY);
-
-
-    // --- Управление GDI объектами (карандаши для контуров/линий, кисти для заливки) ---
-    // Сохраняем текущие выбранные GDI объекты в HDC, чтобы восстановить их В САМОМ КОНЦЕ draw().
-    // Выбираем стандартные NULL объекты как базу для SelectObject().
-    HPEN hOldPen = (HPEN)SelectObject(hdc, GetStockObject(NULL_PEN));     // Сохраняем и выбираем NULL перо.
-    HBRUSH hOldBrush = (HBRUSH)SelectObject(hdc, GetStockObject(NULL_BRUSH)); // Сохраняем и выбираем NULL кисть.
-
-
-    // --- Определяем цвета для рисования ---
-    COLORREF greenColor = RGB(0, 200, 0);         // Зеленый: Внешний круг, Луч.
-    COLORREF yellowColor = RGB(255, 255, 0);        // Желтый: Средний круг (Зона Поражения), Маркеры обнаружения лучом.
-    COLORREF redColor = RGB(255, 0, 0);           // Красный: Внутренний круг (Мертвая зона), База радара.
-    COLORREF baseOutlineColor = RGB(0, 0, 0);     // Черный: Контур базы.
-    COLORREF targetLineColor = RGB(255, 255, 255); // Белый: Линия к отслеживаемой цели (пунктир).
-    COLORREF baseColorNonOperational = RGB(100, 0, 0); // Темно-красный: База нерабочего радара.
-
-
-    // --- Создаем GDI Перья (карандаши) и Кисти ---
-    // Кисть для заливки базы.
-    HBRUSH hBrushBase = CreateSolidBrush(isOperationalStatus ? redColor : baseColorNonOperational); // Кисть для заливки базы.
-    // Перья для контуров зон и линий.
-    HPEN hPenGreen = CreatePen(PS_SOLID, 1, greenColor);         // Для внешнего ЗЕЛЕНОГО круга.
-    HPEN hPenYellow = CreatePen(PS_SOLID, 1, yellowColor);       // Для среднего ЖЕЛТОГО круга.
-    HPEN hPenRed = CreatePen(PS_SOLID, 1, redColor);             // Для внутреннего КРАСНОГО круга.
-    HPEN hPenBeam = CreatePen(PS_SOLID, 2, greenColor);          // Для ЗЕЛЕНОГО луча (толщина 2).
-    HPEN hPenTargetLine = CreatePen(PS_DOT, 1, targetLineColor); // Для БЕЛОЙ ПУНКТИРНОЙ линии к цели.
-    HPEN hPenBaseOutline = CreatePen(PS_SOLID, 1, baseOutlineColor); // Для черного контура базы.
-    // Временные объекты для маркеров обнаружения лучом (создаются/удаляются ВНУТРИ if(isOperationalStatus)).
-
-
-    // --- 1. Отрисовка Базы Радара (Красная заливка с черным контуром) ---
-    SelectObject(hdc, hPenBaseOutline); // Выбираем черное перо контура базы.
-    SelectObject(hdc, hBrushBase);      // Выбираем кисть заливки базы.
-    Ellipse(hdc, screenX - 10, screenY - 10, screenX + 10, screenY + 10); // Рисуем круг базы (радиус 10px).
-    // !!! ВАЖНО !!!: Удаляем созданные GDI объекты базы СРАЗУ.
-    DeleteObject(hBrushBase);      // Удаляем созданную кисть.
-    DeleteObject(hPenBaseOutline); // Удаляем созданное перо контура.
-
-
-    // --- 2. Отрисовка Зон (кругов), Луча и Маркеров ОБНАРУЖЕНИЯ (только если радар работает) ---
-    if (isOperationalStatus) { // Рисуем эти элементы только если радар включен.
-
-        SelectObject(hdc, GetStockObject(NULL_BRUSH)); // Круги зон без заливки.
-
-        // 2.1. Отрисовка ВНЕШНЕГО ЗЕЛЕНОГО круга (Радиус = radar_range).
-        SelectObject(hdc, hPenGreen); // Выбираем зеленое перо.
-        Ellipse(hdc, screenX - (int)outerGreenRadius, screenY - (int)outerGreenRadius,
-            screenX + (int)outerGreenRadius, screenY + (int)outerGreenRadius);
-
-        // 2.2. Отрисовка СРЕДНЕГО ЖЕЛТОГО круга (Радиус = engagementRadius, Зона Поражения).
-        SelectObject(hdc, hPenYellow); // Выбираем желтое перо.
-        Ellipse(hdc, screenX - (int)middleYellowRadius, screenY - (int)middleYellowRadius,
-            screenX + (int)middleYellowRadius, screenY + (int)middleYellowRadius);
-
-        // 2.3. Отрисовка ВНУТРЕННЕГО КРАСНОГО круга (Мертвая зона, Радиус = deadZoneRadius).
-        SelectObject(hdc, hPenRed); // Выбираем красное перо.
-        Ellipse(hdc, screenX - (int)deadZoneRedRadius, screenY - (int)deadZoneRedRadius,
-            screenX + (int)deadZoneRedRadius, screenY + (int)deadZoneRedRadius);
-
-
-        // 2.4. Отрисовка ЛУЧА СКАНИРОВАНИЯ (Зеленый, толщина 2, из центра до внешнего Зеленого круга).
-        SelectObject(hdc, hPenBeam); // Выбираем Зеленое перо для луча.
-        float beamStartAngle = normalizeAngle(currentAngle - beamWidth / 2.0f);
-        float beamEndAngle = normalizeAngle(currentAngle + beamWidth / 2.0f);
-        Point p1_outer_world = { pos.x + outerGreenRadius * std::cos(beamStartAngle), pos.y + outerGreenRadius * std::sin(beamStartAngle) };
-        Point p2_outer_world = { pos.x + outerGreenRadius * std::cos(beamEndAngle), pos.y + outerGreenRadius * std::sin(beamEndAngle) };
-        int p1_outer_screenX = static_cast<int>(p1_outer_world.x + winCenterX);
-        int p1_outer_screenY = static_cast<int>(-p1_outer_world.y + winCenterY); // Инверсия Y
-        int p2_outer_screenX = static_cast<int>(p2_outer_world.x + winCenterX);
-        int p2_outer_screenY = static_cast<int>(-p2_outer_world.y + winCenterY); // Инверсия Y
-        MoveToEx(hdc, screenX, screenY, NULL); LineTo(hdc, p1_outer_screenX, p1_outer_screenY);
-        MoveToEx(hdc, screenX, screenY, NULL); LineTo(hdc, p2_outer_screenX, p2_outer_screenY);
-
-
-        // --- <<< НОВОЕ: Отрисовка маркеров на ВСЕХ ракетах, попадающих под ТЕКУЩИЙ ЛУЧ В ЗОНЕ ОБНАРУЖЕНИЯ >>> ---
-        // Это визуальное отображение, какие ракеты "видит" сканирующий луч прямо сейчас.
-        // Доступ к списку ракет из SimulationState:
-        EnterCriticalSection(m_pCs); // *** Захват g_cs для потокобезопасного доступа к данным SimulationState! ***
-        const std::vector<Missile>& activeMissilesRef = g_simulationState.getActiveMissilesUnsafe(); // Получаем список активных ракет.
-
-        // Создаем временные GDI объекты для отрисовки маркеров (Желтый цвет, соответствующий средней зоне).
-        HBRUSH hBrushMarker = CreateSolidBrush(yellowColor); // Желтая кисть.
-        HPEN hPenMarker = CreatePen(PS_SOLID, 1, yellowColor);   // Желтое перо.
-        // Сохраняем текущие объекты и выбираем наши временные маркеры.
-        HBRUSH hOldBrushMarker = (HBRUSH)SelectObject(hdc, hBrushMarker);
-        HPEN hOldPenMarker = (HPEN)SelectObject(hdc, hPenMarker);
-
-        // Итерируем по КАЖДОЙ активной ракете.
-        for (const auto& missile : activeMissilesRef) {
-            if (missile.isActive) {
-                float missileDist = missile.getDistanceToCenter();
-                bool isInRangeRingNow = isMissileInRangeRingInternal(missileDist, outerGreenRadius, deadZoneRedRadius);
-                bool isInBeamNow = Radar::isMissileInBeam(missile.pos, currentAngle, beamWidth);
-
-                if (isInRangeRingNow && isInBeamNow) {
-                    int missileScreenX = static_cast<int>(missile.pos.x + winCenterX);
-                    int missileScreenY = static_cast<int>(-missile.pos.y + winCenterY);
-                    int markerSize = 3;
-                    Ellipse(hdc, missileScreenX - markerSize, missileScreenY - markerSize, missileScreenX + markerSize + 1, missileScreenY + markerSize + 1);
-                }
-            }
-        } // Конец цикла по активным ракетам для отрисовки маркеров.
-
-
-        // --- Отрисовка линии к ЗАПОМНЕННОЙ (отслеживаемой) цели ---
-        // ЭТА ЛИНИЯ рисуется ТОЛЬКО к ОДНОЙ ракете (detectedMissileId), чей ID ЗАПОМНИЛ радар для сбития.
-        // Указатель на отслеживаемую ракету pDetectedForDraw был получен внутри этого CS блока (если detectedMissileId != -1).
-        const Missile* pDetectedForDraw = nullptr; // Объявление указателя.
-        if (detectedMissileId != -1) { // Если есть ID отслеживаемой цели.
-            auto itDetected = std::find_if(activeMissilesRef.begin(), activeMissilesRef.end(),
-                [&](const Missile& m) { return m.isActive && m.id == detectedMissileId; });
-            if (itDetected != activeMissilesRef.end()) { pDetectedForDraw = &(*itDetected); } // Нашли, сохраняем указатель.
-        }
-
-        LeaveCriticalSection(m_pCs); // *** ОСВОБОЖДЕНИЕ g_cs ***
-
-        // !!! ВАЖНО !!!: Удаляем временные GDI объекты маркеров ПОСЛЕ освобождения CS и их использования. !!!
-        SelectObject(hdc, hOldBrushMarker); // Восстанавливаем кисть.
-        SelectObject(hdc, hOldPenMarker);   // Восстанавливаем перо.
-        DeleteObject(hBrushMarker);         // Удаляем кисть.
-        DeleteObject(hPenMarker);           // Удаляем перо.
-
-
-        // --- Рисуем линию к ЗАПОМНЕННОЙ цели, если она найдена и активна ---
-        // Выполняется ВНЕ блока CS.
-        if (detectedMissileId != -1 && pDetectedForDraw) { // Проверяем, что есть ID отслеживания И указатель валиден.
-            SelectObject(hdc, hPenTargetLine); // <<< ИСПРАВЛЕНИЕ: ВЫБРАТЬ ПЕРО ЛИНИИ К ЦЕЛИ ***ЗДЕСЬ***. Белый пунктир.
-            MoveToEx(hdc, screenX, screenY, NULL); // Начинаем линию из центра радара.
-            LineTo(hdc, static_cast<int>(pDetectedForDraw->pos.x + winCenterX), static_cast<int>(-pDetectedForDraw->pos.y + winCenterY));
-        }
-        // else: Линия не рисуется.
-
-       // ... (Остальной код draw в блоке if (isOperationalStatus) - если есть что-то после отрисовки линии) ...
-
-
-    } // Конец if (isOperationalStatus). Рисует зоны, луч, маркеры/линии.
-
-
-    // --- Удаление всех созданных GDI объектов (перьев и кистей) ---
-    // Удаляем перья и кисти, созданные Create...().
-    // Делается после того, как они использованы И после восстановления старых объектов в HDC.
-    DeleteObject(hPenGreen);       // Удаляем зеленое перо.
-    DeleteObject(hPenYellow);      // Удаляем желтое перо.
-    DeleteObject(hPenRed);         // Удаляем красное перо.
-    DeleteObject(hPenBeam);        // Удаляем перо луча.
-    DeleteObject(hPenTargetLine);  // Удаляем перо линии к цели.
-    // hPenBaseOutline и hBrushBase уже были удалены после отрисовки базы.
-
+// --- Счетчики обмена снимками ---
+// Каждый счетчик пишет один поток (load + store без RMW), здесь - только чтение, можно из любого потока.
+SnapshotStats Radar::getSnapshotStats() const {
+    SnapshotStats s;
+    s.publishes = m_statPublishes.load(std::memory_order_relaxed);
+    s.overwrittenUnread = m_statOverwritten.load(std::memory_order_relaxed);
+    s.reads = m_statReads.load(std::memory_order_relaxed);
+    s.freshReads = m_statFreshReads.load(std::memory_order_relaxed);
+    s.publishNsTotal = m_statPublishNsTotal.load(std::memory_order_relaxed);
+    s.publishNsMax = m_statPublishNsMax.load(std::memory_order_relaxed);
+    s.ageNsTotal = m_statAgeNsTotal.load(std::memory_order_relaxed);
+    s.ageNsMax = m_statAgeNsMax.load(std::memory_order_relaxed);
+    return s;
+}
 
-    // --- Восстановление исходных GDI объектов контекста устройства ---
-    // Восстанавливаем в HDC те перо и кисть, которые были активны ДО ВХОДА в этот метод draw().
-    SelectObject(hdc, hOldPen);   // Восстанавливаем оригинальное перо.
-    SelectObject(hdc, hOldBrush); // Восстанавливаем оригинальную кисть.
-    // Объекты GetStockObject() не удаляются.
 
+// --- Геттеры ---
+// Каждый геттер - одно чтение seqlock (без мьютекса). Если нужно несколько полей сразу,
+// getState() дает согласованную копию всей структуры за одно чтение.
+RadarState Radar::getState() const {
+    return m_state.read();
 }
-
 bool Radar::isOperational() const { // Геттер статуса работы
-    CRITICAL_SECTION* pCs_non_const = const_cast<CRITICAL_SECTION*>(m_pCs); // const_cast
-    EnterCriticalSection(pCs_non_const); // Захват g_cs
-    bool operational = m_state.isOperational; // Чтение значения
-    LeaveCriticalSection(pCs_non_const); // Освобождение g_cs
-    return operational; // Возвращаем прочитанное значение
+    return m_state.read().isOperational;
 }
 float Radar::getCurrentAngle() const { // Геттер текущего угла сканирования
-    CRITICAL_SECTION* pCs_non_const = const_cast<CRITICAL_SECTION*>(m_pCs); 
-    EnterCriticalSection(pCs_non_const); float angle = m_state.currentAngle; LeaveCriticalSection(pCs_non_const); return angle;
+    return m_state.read().currentAngle;
 }
 float Radar::getBeamWidth() const { // Геттер ширины луча
-    CRITICAL_SECTION* pCs_non_const = const_cast<CRITICAL_SECTION*>(m_pCs);
-    EnterCriticalSection(pCs_non_const); float width = m_state.beamWidth; LeaveCriticalSection(pCs_non_const); return width;
+    return m_state.read().beamWidth;
 }
 // Геттер для радиуса ВНЕШНЕГО ЗЕЛЕНОГО круга (из config.radar_range)
 float Radar::getRange() const {
-    CRITICAL_SECTION* pCs_non_const = const_cast<CRITICAL_SECTION*>(m_pCs);
-    EnterCriticalSection(pCs_non_const); float range_val = m_state.radar_range; LeaveCriticalSection(pCs_non_const); return range_val;
+    return m_state.read().radar_range;
 }
 // Геттер для радиуса СРЕДНЕГО ЖЕЛТОГО круга (ЗОНА ПОРАЖЕНИЯ, из config.radar_engagement_radius)
-// ЭТО ОДНО ИЗ ОПРЕДЕЛЕНИЙ, НА КОТОРЫЕ ЖАЛОВАЛСЯ КОМПИЛЯТОР E0040/C2511. СИНТАКСИС ПРОВЕРЕН.
-float Radar::getEngagementRadius() const
-{
-    CRITICAL_SECTION* pCs_non_const = const_cast<CRITICAL_SECTION*>(m_pCs);
-    EnterCriticalSection(pCs_non_const); float radius = m_state.engagementRadius; LeaveCriticalSection(pCs_non_const); return radius;
+float Radar::getEngagementRadius() const {
+    return m_state.read().engagementRadius;
 }
 // Геттер для радиуса ВНУТРЕННЕГО КРАСНОГО круга (МЕРТВАЯ ЗОНА, из config.danger_zone_radius)
 float Radar::getDeadZoneRadius() const {
-    CRITICAL_SECTION* pCs_non_const = const_cast<CRITICAL_SECTION*>(m_pCs); // const_cast
-    EnterCriticalSection(pCs_non_const); float radius = m_state.deadZoneRadius; LeaveCriticalSection(pCs_non_const); return radius;
+    return m_state.read().deadZoneRadius;
 }
 
 // Геттеры для информации об ОБНАРУЖЕННОЙ цели (ID и время обнаружения).
-// Эти геттеры используются в SimulationState::update для реализации логики сбития/потери.
 int Radar::getDetectedMissileId() const {
-    CRITICAL_SECTION* pCs_non_const = const_cast<CRITICAL_SECTION*>(m_pCs); // const_cast
-    EnterCriticalSection(pCs_non_const); int id = m_state.detectedMissileId; LeaveCriticalSection(pCs_non_const); return id;
+    return m_state.read().detectedMissileId;
 }
 float Radar::getDetectionTime() const {
-    CRITICAL_SECTION* pCs_non_const = const_cast<CRITICAL_SECTION*>(m_pCs); // const_cast
-    EnterCriticalSection(pCs_non_const); float time = m_state.detectionTime; LeaveCriticalSection(pCs_non_const); return time;
+    return m_state.read().detectionTime;
 }
 void Radar::setOperational(bool operational) {
-    EnterCriticalSection(m_pCs); // Захват глобальной CS для безопасного изменения m_state.
-    m_state.isOperational = operational; // Изменяем статус работы.
-    if (!operational) { // Если статус изменился на НЕрабочий
-        // Сбрасываем обнаруженную цель - радар не может отслеживать, если не работает.
-        m_state.detectedMissileId = -1;
-        m_state.detectionTime = 0.0f;
-    }
-    LeaveCriticalSection(m_pCs); // Освобождение глобальной CS.
+    m_state.update([operational](RadarState& state) {
+        state.isOperational = operational; // Изменяем статус работы.
+        if (!operational) { // Если статус изменился на НЕрабочий
+            // Сбрасываем обнаруженную цель - радар не может отслеживать, если не работает.
+            state.detectedMissileId = -1;
+            state.detectionTime = 0.0f;
+        }
+    });
+    if (!operational) m_tracks.clear(); // Вызывается потоком симуляции вне шага радара
 } // Конец setOperational()
 
 // clearDetectedMissile: Сбрасывает информацию об обнаруженной цели (устанавливает detectedMissileId в -1).
 // Вызывается из SimulationState::update, когда отслеживаемая цель была уничтожена, ушла в мертвую зону, или стала неактивна по другой причине.
 void Radar::clearDetectedMissile() {
-    EnterCriticalSection(m_pCs); // Захват глобальной CS для безопасного изменения m_state.
-    m_state.detectedMissileId = -1; // Сброс ID цели (-1 означает "нет цели").
-    m_state.detectionTime = 0.0f; // Сброс времени обнаружения.
-    LeaveCriticalSection(m_pCs); // Освобождение глобальной CS.
+    m_state.update([](RadarState& state) {
+        state.detectedMissileId = -1; // Сброс ID цели (-1 означает "нет цели").
+        state.detectionTime = 0.0f; // Сброс времени обнаружения.
+    });
 } 
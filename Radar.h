@@ -0,0 +1,218 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <utility>
+#include <string> 
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "Point.h"
+#include "GameConfig.h"
+#include "Missile.h"
+#include "MissileStore.h"
+#include "BearingIndex.h"
+#include "TrackTable.h"
+#include "MissileLog.h"
+#include "TripleBuffer.h"
+#include "Seqlock.h"
+
+class SimulationState; // Предварительное объявление
+
+struct RadarState {
+    float currentAngle;
+    bool isOperational;
+    // Threaded: цель, найденную потоком радара (одна на радар), SimulationState переносит в таблицу треков
+    // и сбрасывает здесь, когда трек закрыт. В остальных режимах цели - только в TrackTable, поле равно -1.
+    int detectedMissileId;
+    float detectionTime;
+    float sweepSpeed;
+    float beamWidth;
+    float radar_range;
+    float engagementRadius;
+    float deadZoneRadius;
+    // Последний шаг сканирования: луч повернулся от sweepStartAngle на sweepArc радиан (до currentAngle).
+    // Поражение проверяется по всему накрытому сектору (BeamSector::makeSwept), а не по одному углу.
+    float sweepStartAngle;
+    float sweepArc;
+};
+
+// --- Кандидат в цели: ракета, через которую прошел луч за шаг (координаты и расстояние - от этого радара) ---
+struct RadarCandidate {
+    int missileId;
+    int launcherId;
+    float distSq;
+    float x;
+    float y;
+};
+
+// --- Итог поиска целей одного радара за шаг (RadarNetwork: параллельная часть шага) ---
+// Ближайшие новые цели по возрастанию (distSq, ID): на freeSlots свободных мест таблицы треков плюс
+// SPARE_CANDIDATES запасных. Какие из них радар возьмет, решает правило назначения RadarNetwork -
+// одну ракету не ведут два радара, и ближних может забрать другой радар.
+struct RadarScan {
+    enum { SPARE_CANDIDATES = 3 };
+    bool operational;      // Радар работал: шаг публикуется commitScan()
+    bool searched;         // ... и было свободное место: искал новые цели (иначе candidates пуст)
+    float sweepStart;
+    float arc;
+    float newAngle;
+    float gameTime;
+    int freeSlots;
+    std::vector<RadarCandidate> candidates; // Емкость переиспользуется
+};
+
+// --- Счетчики обмена снимками между потоком симуляции и радаром ---
+// Блокировки на этом пути нет вообще; счетчики показывают, насколько писатель и читатель
+// расходятся по темпу и сколько времени кадр идет от публикации до радара.
+struct SnapshotStats {
+    uint64_t publishes = 0;         // Опубликовано снимков (поток симуляции)
+    uint64_t overwrittenUnread = 0; // Из них заменено до того, как радар их прочитал
+    uint64_t reads = 0;             // Шагов радара, читавших снимок
+    uint64_t freshReads = 0;        // Из них получили новый снимок
+    uint64_t publishNsTotal = 0;    // Время построения + публикации снимка (нс), сумма
+    uint64_t publishNsMax = 0;      // ... максимум
+    uint64_t ageNsTotal = 0;        // Возраст снимка в момент первого чтения радаром (нс), сумма
+    uint64_t ageNsMax = 0;          // ... максимум
+};
+
+class Radar {
+private:
+    Point pos;
+    Seqlock<RadarState> m_state; // Публикуется целиком: читатели получают согласованную копию без блокировки
+    // Threaded: поток радара создается при первой игре и живет до shutdown(). Между играми он стоит на
+    // парковке: park() снимает m_armed и ждет, пока поток подтвердит m_parked; initialize() сбрасывает
+    // буферы и снова взводит m_armed. Паузы потока - ожидание на m_control, поэтому парковка не ждет сна.
+    std::thread m_thread;
+    std::atomic<bool> m_stopThread;
+    std::mutex m_controlMutex;
+    std::condition_variable m_control;
+    bool m_armed;   // Под m_controlMutex: поток сканирует
+    bool m_parked;  // Под m_controlMutex: поток вне шага и ждет взвода (пишет только поток)
+    MissileLog* m_pMissileLog; // Указатель на лог
+
+    // Снимок ракет с моментом публикации
+    struct PublishedSnapshot {
+        MissileSnapshot missiles;
+        float gameTime = 0.0f;
+        std::chrono::steady_clock::time_point publishedAt;
+    };
+
+    // Азимутальный индекс строится в updateMissileSnapshot() (поток симуляции) прямо в back() тройного буфера
+    // и публикуется одной атомарной операцией; step() (поток радара) читает front() без блокировки и копирования.
+    // Радар без потока (шаг внутри update()) обходится без обмена: снимок строится в m_lockstepSnapshot
+    // и сразу читается searchCandidates() в том же потоке - ни атомарных обменов, ни замеров времени.
+    // Конвейер (Pipelined) строит m_lockstepSnapshot на рабочем потоке стадии из кадра RadarNetwork.
+    // Координаты снимка - относительно позиции радара (pos).
+    BearingIndex m_bearingIndex;
+    TripleBuffer<PublishedSnapshot> m_snapshots;
+    PublishedSnapshot m_lockstepSnapshot;
+    RadarMode m_mode; // Режим, заданный последним initialize()
+    RadarScan m_scan; // Итог scanStep() (пишет только поток, сканирующий этот радар)
+    TrackTable m_tracks; // Сопровождаемые цели (Lockstep/Pipelined - завязка в commitScan(); см. TrackTable.h)
+
+    // Счетчики (каждое поле пишет только один поток, читать можно из любого)
+    std::atomic<uint64_t> m_statPublishes, m_statOverwritten, m_statPublishNsTotal, m_statPublishNsMax;
+    std::atomic<uint64_t> m_statReads, m_statFreshReads, m_statAgeNsTotal, m_statAgeNsMax;
+
+    // Рабочий буфер findTargets() (используется только сканирующим потоком, емкость переиспользуется).
+    std::vector<uint32_t> m_beamHits;
+
+    std::chrono::high_resolution_clock::time_point m_lastUpdateTime;
+
+    // Методы потока
+    static void RadarThreadProc(Radar* pRadar);
+    void run();
+
+    // Шаг потока радара (step()): луч повернулся на arc до newAngle за motionDt секунд игры ракет.
+    void scan(const RadarState& state, const PublishedSnapshot& snapshot, float newAngle, float arc, float motionDt);
+    const PublishedSnapshot& acquireSnapshot(); // Поток радара: последний опубликованный снимок (со счетчиками)
+    void prepareScan(const MissileStore& missiles, float gameTime); // Индекс ракет в m_lockstepSnapshot
+    bool beginScan(float gameTime, float dt);   // Поворот луча в m_scan; true - есть место в таблице, ищем цели
+    void searchCandidates(float dt, const std::vector<int>& excluded);
+
+    // Ближайшие (до maxOut) ракеты, через которые прошел луч за шаг, кроме excluded (отсортирован по возрастанию)
+    // и кроме тех, что в зону поражения engagementRadius уже не войдут (canEngage).
+    int findTargets(const MissileSnapshot& missilesSnapshot, float sweepStartAngle, float sweepArc, float motionDt,
+                    float beamWidth, float range, float engagementRadius, float deadZoneRadius,
+                    const int* excluded, size_t excludedCount, RadarCandidate* out, int maxOut);
+
+public:
+    Radar();
+    ~Radar();
+
+    // Threaded: свой поток по настенным часам (только основной радар и одна цель, см. RadarNetwork).
+    // Lockstep/Pipelined: поток не создается, сканирование - стадия шага симуляции, им управляет RadarNetwork:
+    // scanStep() (параллельно по радарам), затем commitScan() по правилу назначения.
+    // trackCapacity - емкость таблицы треков (GameConfig::radar_track_capacity), filter - параметры ее фильтра.
+    // Перезапуск игры не создает и не останавливает поток: initialize() паркует его, сбрасывает буферы
+    // (емкость сохраняется) и взводит снова.
+    void initialize(const RadarSite& site, MissileLog* pLog, RadarMode mode, size_t trackCapacity, const TrackFilterParams& filter);
+    void park();     // Threaded: остановить сканирование до следующего initialize(); поток остается
+    void shutdown(); // Остановка и завершение потока
+    void step(float dt); // Один шаг сканирования (поворот луча + поиск новой цели), поток радара
+    void sweepTo(float gameTime, float dt); // Только поворот луча на beamAngleAt(gameTime), без поиска цели
+    static float beamAngleAt(float sweepSpeed, float gameTime);
+    void updateMissileSnapshot(const MissileStore& missiles, float currentGameTime); // Threaded: публикация снимка
+
+    // --- Шаг по игровому времени (RadarNetwork) ---
+    // scanStep: поворот луча на beamAngleAt(gameTime) и, если в таблице треков есть место, азимутальный индекс
+    // ракет относительно pos и кандидаты в цели - в lastScan(); excluded - ID всех сопровождаемых целей сети,
+    // по возрастанию.
+    // Только читает общие данные и пишет в свой радар: разные радары можно считать параллельно.
+    void scanStep(const MissileStore& missiles, float gameTime, float dt, const std::vector<int>& excluded);
+    void scanStep(const MissileFrame& missiles, float gameTime, float dt, const std::vector<int>& excluded);
+    const RadarScan& lastScan() const { return m_scan; }
+    // Публикует шаг: угол, сектор и завязка треков lastScan().candidates[accepted[k]] (с записью в лог, по порядку).
+    void commitScan(const std::vector<int>& accepted);
+    TrackTable& tracks() { return m_tracks; }
+    const TrackTable& tracks() const { return m_tracks; }
+    SnapshotStats getSnapshotStats() const;
+
+    // Потокобезопасные геттеры (чтение seqlock, без блокировки).
+    // Для нескольких полей сразу - getState(): одна согласованная копия вместо нескольких чтений.
+    RadarState getState() const;
+    bool isOperational() const;
+    float getCurrentAngle() const;
+    float getBeamWidth() const;
+    float getRange() const;
+    float getDeadZoneRadius() const;
+    int getDetectedMissileId() const;
+    float getDetectionTime() const;
+    float getEngagementRadius() const;
+
+    // Потокобезопасные сеттеры/методы
+    void setOperational(bool operational);
+    void clearDetectedMissile();
+    // void setCurrentAngle(float angle); // Если нужен мгновенный поворот
+
+    Point getPos() const { return pos; }
+
+    // Войдет ли ракета (x, y относительно радара, скорость vx, vy; полет прямолинейный) в круг engagementRadius
+    // или уже в нем. Для основного радара верно всегда: ракеты летят к базе.
+    static bool canEngage(float x, float y, float vx, float vy, float engagementRadius) {
+        const float radiusSq = engagementRadius * engagementRadius;
+        if (x * x + y * y <= radiusSq) return true;
+        if (x * vx + y * vy >= 0.0f) return false; // Не приближается
+        const float cross = x * vy - y * vx;       // Расстояние наибольшего сближения = |cross| / |v|
+        return cross * cross <= radiusSq * (vx * vx + vy * vy);
+    }
+    // Через сколько секунд такая ракета войдет в круг engagementRadius: 0 - уже в нем, бесконечность - не войдет
+    // (canEngage() ложно). Вход - меньший корень |p + v t| = R.
+    static float timeToEngage(float x, float y, float vx, float vy, float engagementRadius) {
+        const float outside = x * x + y * y - engagementRadius * engagementRadius;
+        if (outside <= 0.0f) return 0.0f;
+        if (!canEngage(x, y, vx, vy, engagementRadius)) return std::numeric_limits<float>::infinity();
+        const float a = vx * vx + vy * vy; // > 0: ракета приближается
+        const float b = x * vx + y * vy;   // < 0
+        const float disc = b * b - a * outside;
+        return (-b - std::sqrt(disc > 0.0f ? disc : 0.0f)) / a;
+    }
+
+    // Статическая функция проверки луча (эталонная скалярная версия через atan2;
+    // рабочие пути используют BeamSector из BeamKernel.h)
+    static bool isMissileInBeam(const Point& missilePos, float radarAngle, float beamWidth);
+};
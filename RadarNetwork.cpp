@@ -0,0 +1,162 @@
+#include "RadarNetwork.h"
+#include <algorithm>
+#include <system_error>
+#include <thread>
+
+RadarNetwork::RadarNetwork() :
+    m_mode(RadarMode::Lockstep),
+    m_pipelineWrite(0),
+    m_pipelineJob(nullptr)
+{
+    m_sites.emplace_back(new Radar()); // Основной радар есть всегда (геттеры до initialize())
+}
+
+RadarNetwork::~RadarNetwork() {
+    shutdown();
+}
+
+
+// --- Настройка сети на новую игру ---
+void RadarNetwork::initialize(const GameConfig& config, MissileLog* pLog, RadarMode mode) {
+    park();
+    m_mode = mode;
+
+    const size_t count = config.radarCount();
+    while (m_sites.size() < count) m_sites.emplace_back(new Radar());
+    m_sites.resize(count);
+    // Threaded ведет одну цель (почтовый ящик detectedMissileId потока радара).
+    const size_t trackCapacity = mode == RadarMode::Threaded ? 1 : static_cast<size_t>(config.radar_track_capacity);
+    const TrackFilterParams filter = config.trackFilter();
+    m_sites[0]->initialize(config.primarySite(), pLog, mode, trackCapacity, filter);
+    for (size_t i = 1; i < count; ++i) {
+        m_sites[i]->initialize(config.radar_sites[i - 1], pLog, mode, trackCapacity, filter);
+    }
+
+    // Потоков параллельной части - не больше, чем позиций; вызывающий поток тоже работает.
+    int threads = config.radar_scan_threads > 0 ? config.radar_scan_threads : static_cast<int>(std::thread::hardware_concurrency());
+    if (threads > static_cast<int>(count)) threads = static_cast<int>(count);
+    if (threads < 1 || mode == RadarMode::Threaded) threads = 1;
+    m_pool.start(threads);
+
+    // Рабочий поток конвейера создается один раз; если создать не удалось, postStep() выполняет стадию сам.
+    if (m_mode == RadarMode::Pipelined && !m_stageWorker.isRunning()) {
+        try {
+            m_stageWorker.start([this]() { runPipelineStage(); });
+        }
+        catch (const std::system_error&) {
+        }
+    }
+} // Конец initialize()
+
+void RadarNetwork::park() {
+    waitStep(); // Незавершенная стадия конвейера (рабочие потоки остаются ждать следующей игры).
+    for (auto& radar : m_sites) radar->park();
+}
+
+void RadarNetwork::shutdown() {
+    waitStep();
+    for (auto& radar : m_sites) radar->shutdown();
+}
+
+void RadarNetwork::setOperational(bool operational) {
+    for (auto& radar : m_sites) radar->setOperational(operational);
+}
+
+void RadarNetwork::sweepTo(float gameTime, float dt) {
+    for (auto& radar : m_sites) radar->sweepTo(gameTime, dt);
+}
+
+void RadarNetwork::updateMissileSnapshot(const MissileStore& missiles, float gameTime) {
+    m_sites[0]->updateMissileSnapshot(missiles, gameTime);
+}
+
+void RadarNetwork::stepAt(const MissileStore& missiles, float gameTime, float dt) {
+    scanAll(missiles, gameTime, dt);
+}
+
+
+// --- Шаг сети: параллельный поиск, затем назначение и публикация по порядку позиций ---
+template <typename Missiles>
+void RadarNetwork::scanAll(const Missiles& missiles, float gameTime, float dt) {
+    // Цели на сопровождении в начале шага: другие радары их не ищут.
+    m_tracked.clear();
+    for (const auto& radar : m_sites) {
+        const TrackTable& tracks = radar->tracks();
+        m_tracked.insert(m_tracked.end(), tracks.missileIdData(), tracks.missileIdData() + tracks.size());
+    }
+    std::sort(m_tracked.begin(), m_tracked.end());
+
+    auto scanSite = [&](size_t i) { m_sites[i]->scanStep(missiles, gameTime, dt, m_tracked); };
+    m_pool.run(m_sites.size(), scanSite);
+
+    assignTargets();
+    for (size_t i = 0; i < m_sites.size(); ++i) {
+        m_sites[i]->commitScan(m_accepted[i]);
+    }
+} // Конец scanAll()
+
+// Заявки всех позиций по возрастанию (расстояние, позиция, кандидат): первая заявка на ракету от позиции
+// со свободным местом в таблице треков выигрывает. Кандидаты каждой позиции уже отсортированы, поэтому
+// позиция получает ближайшие из еще не занятых ракет своего списка.
+void RadarNetwork::assignTargets() {
+    m_accepted.resize(m_sites.size());
+    for (auto& accepted : m_accepted) accepted.clear();
+    if (m_sites.size() == 1) {
+        const RadarScan& scan = m_sites[0]->lastScan();
+        const int count = std::min(static_cast<int>(scan.candidates.size()), scan.freeSlots);
+        for (int c = 0; c < count; ++c) m_accepted[0].push_back(c);
+        return;
+    }
+
+    m_claims.clear();
+    for (size_t i = 0; i < m_sites.size(); ++i) {
+        const RadarScan& scan = m_sites[i]->lastScan();
+        for (int c = 0; c < static_cast<int>(scan.candidates.size()); ++c) {
+            Claim claim = { scan.candidates[c].distSq, static_cast<int>(i), c, scan.candidates[c].missileId };
+            m_claims.push_back(claim);
+        }
+    }
+    std::sort(m_claims.begin(), m_claims.end(), [](const Claim& a, const Claim& b) {
+        if (a.distSq != b.distSq) return a.distSq < b.distSq;
+        if (a.site != b.site) return a.site < b.site;
+        return a.candidate < b.candidate;
+    });
+
+    m_assignedIds.clear();
+    for (const Claim& claim : m_claims) {
+        std::vector<int>& accepted = m_accepted[claim.site];
+        if (static_cast<int>(accepted.size()) >= m_sites[claim.site]->lastScan().freeSlots) continue;
+        if (std::find(m_assignedIds.begin(), m_assignedIds.end(), claim.missileId) != m_assignedIds.end()) continue;
+        accepted.push_back(claim.candidate);
+        m_assignedIds.push_back(claim.missileId);
+    }
+    // Завязка - в порядке кандидатов позиции (ближние первыми), как у одиночного радара.
+    for (auto& accepted : m_accepted) std::sort(accepted.begin(), accepted.end());
+} // Конец assignTargets()
+
+
+// --- Стадия сети конвейера: кадр тика -> рабочий поток ---
+// Вызывается из SimulationState::update в конце тика вместо stepAt(). Стадия делает с кадром ровно то же,
+// что lockstep в этом месте тика, поэтому события и их порядок совпадают с последовательным прогоном.
+void RadarNetwork::postStep(const MissileStore& missiles, float gameTime, float dt) {
+    waitStep(); // Владелец уже дождался стадии прошлого тика; здесь - на случай пропущенного waitStep().
+
+    PipelineFrame& frame = m_pipelineFrames[m_pipelineWrite];
+    frame.missiles.assign(missiles);
+    frame.gameTime = gameTime;
+    frame.dt = dt;
+    m_pipelineJob = &frame; // Видим рабочему потоку: post() публикует счетчик после этой записи.
+    m_pipelineWrite ^= 1;
+
+    if (m_stageWorker.isRunning()) m_stageWorker.post();
+    else runPipelineStage(); // Поток не создан - та же стадия последовательно.
+} // Конец postStep()
+
+void RadarNetwork::waitStep() {
+    m_stageWorker.wait();
+}
+
+void RadarNetwork::runPipelineStage() {
+    const PipelineFrame& frame = *m_pipelineJob;
+    scanAll(frame.missiles, frame.gameTime, frame.dt);
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "GameConfig.h"
+#include "MissileStore.h"
+#include "BearingIndex.h"
+#include "MissileLog.h"
+#include "Radar.h"
+#include "StageWorker.h"
+
+// --- Сеть радарных позиций ---
+// Позиция 0 - основной радар в центре (ключи radar_* GameConfig), остальные - строки radar_site.
+// Все радары сканируют одни и те же ракеты: шаг сети по игровому времени - это
+//   1) параллельная часть на пуле StagePool: каждый радар поворачивает луч и, если в его таблице треков
+//      есть место, строит свой азимутальный индекс и ищет новые цели (общие данные только читаются,
+//      пишет каждый радар только в себя - ни блокировок, ни потока на радар);
+//   2) последовательное назначение и завязка треков в потоке шага.
+// Правило назначения: одну ракету ведет не больше одного радара. Цели, уже взятые на сопровождение,
+// в поиск не попадают. Из новых кандидатов ракету получает ближайший к ней радар со свободным местом (при
+// равном расстоянии - с меньшим номером позиции); радар берет не больше целей, чем у него свободных мест.
+// Порядок заданий в пуле на итог не влияет: одни и те же события при любом числе потоков.
+// С одной позицией шаг сети совпадает с прежним шагом одного радара.
+class RadarNetwork {
+private:
+    // Заявка радара site на свой кандидат candidate (RadarScan::candidates) - для правила назначения.
+    struct Claim {
+        float distSq;
+        int site;
+        int candidate;
+        int missileId;
+    };
+
+    // --- Конвейер: кадры тиков для стадии сети (двойной буфер) ---
+    // Поток симуляции пишет кадр m_pipelineWrite, рабочий поток читает другой: запись кадра N+1
+    // никогда не касается кадра N, даже если стадия N еще идет.
+    struct PipelineFrame {
+        MissileFrame missiles;
+        float gameTime = 0.0f;
+        float dt = 0.0f;
+    };
+
+    std::vector<std::unique_ptr<Radar>> m_sites; // Радары переживают перезапуск игры (емкость буферов сохраняется)
+    RadarMode m_mode;
+    StagePool m_pool;                  // Потоки параллельной части шага (radar_scan_threads)
+    std::vector<int> m_tracked;        // ID целей на сопровождении в начале шага, по возрастанию
+    std::vector<Claim> m_claims;
+    std::vector<std::vector<int>> m_accepted; // Номера кандидатов, назначенных каждой позиции (по возрастанию)
+    std::vector<int> m_assignedIds;    // ID ракет, уже назначенных на этом шаге
+    PipelineFrame m_pipelineFrames[2];
+    int m_pipelineWrite;
+    const PipelineFrame* m_pipelineJob; // Кадр текущей стадии (задается до post(), читается рабочим потоком)
+
+    template <typename Missiles>
+    void scanAll(const Missiles& missiles, float gameTime, float dt);
+    void assignTargets();
+    void runPipelineStage();
+
+public:
+    RadarNetwork();
+    ~RadarNetwork();
+
+    RadarNetwork(const RadarNetwork&) = delete;
+    RadarNetwork& operator=(const RadarNetwork&) = delete;
+
+    // Threaded допускается только с одной позицией (поток основного радара по настенным часам);
+    // SimulationState заменяет его на Lockstep, если позиций больше.
+    void initialize(const GameConfig& config, MissileLog* pLog, RadarMode mode);
+    void park();     // Конец игры: стадия конвейера дождана, потоки радаров на парковке (см. Radar::park)
+    void shutdown(); // Завершение потоков радаров
+
+    size_t size() const { return m_sites.size(); }
+    Radar& site(size_t i) { return *m_sites[i]; }
+    const Radar& site(size_t i) const { return *m_sites[i]; }
+    Radar& primary() { return *m_sites[0]; }
+    const Radar& primary() const { return *m_sites[0]; }
+    int scanThreads() const { return m_pool.threadCount(); }
+
+    void setOperational(bool operational); // Все позиции
+    void sweepTo(float gameTime, float dt); // Все позиции (пропуск тиков, только Lockstep)
+    void updateMissileSnapshot(const MissileStore& missiles, float gameTime); // Threaded: снимок основному радару
+
+    // Lockstep: шаг всей сети на ракетах этого тика.
+    void stepAt(const MissileStore& missiles, float gameTime, float dt);
+
+    // --- Конвейер (RadarMode::Pipelined) ---
+    // postStep() копирует ракеты тика в кадр и запускает на рабочем потоке то же, что делает stepAt(),
+    // и сразу возвращается. waitStep() ждет окончания стадии; до него владелец не должен читать цели
+    // радаров и трогать кольцо лога сверх своих записей. Рабочий поток живет до деструктора.
+    void postStep(const MissileStore& missiles, float gameTime, float dt);
+    void waitStep();
+
+private:
+    StageWorker m_stageWorker; // Последним: останавливается первым, пока остальные члены еще живы
+};
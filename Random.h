@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <random>
+
+// --- Генератор случайных чисел симуляции (xoshiro256**) ---
+// У каждого SimulationState свой экземпляр: общего состояния между симуляциями нет (в отличие от rand()),
+// и игра полностью определяется начальным значением. Алгоритм и отображение в диапазон (below())
+// зафиксированы здесь, а не взяты из <random>, поэтому одно и то же начальное значение дает одну и ту же
+// игру на любой платформе и стандартной библиотеке.
+//
+// Независимые потоки чисел:
+//   streamSeed(seed, i) - начальное значение потока i серии seed (splitmix64 от пары), удобно, когда потоки
+//                         нумеруются (игра i прогона Монте-Карло) и каждый нужно повторить отдельно;
+//   split()             - отдает копию текущего состояния и сдвигает себя на 2^128 шагов (jump()),
+//                         так что последовательности родителя и потомка гарантированно не пересекаются.
+class Xoshiro256 {
+private:
+    uint64_t m_s[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    // Интерфейс UniformRandomBitGenerator (можно передавать в алгоритмы <random>/<algorithm>).
+    typedef uint64_t result_type;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<uint64_t>::max(); }
+
+    explicit Xoshiro256(uint64_t seed = 0) { this->seed(seed); }
+
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Случайное начальное значение (std::random_device) - когда воспроизводимость не задана явно.
+    static uint64_t entropySeed() {
+        std::random_device rd;
+        return (static_cast<uint64_t>(rd()) << 32) | rd();
+    }
+
+    static uint64_t streamSeed(uint64_t seed, uint64_t stream) {
+        uint64_t x = seed ^ splitmix64(stream);
+        return splitmix64(x);
+    }
+
+    // Состояние заполняется splitmix64 - никогда не бывает полностью нулевым.
+    void seed(uint64_t seed) {
+        uint64_t x = seed;
+        for (int i = 0; i < 4; ++i) m_s[i] = splitmix64(x);
+    }
+
+    uint64_t next() {
+        const uint64_t result = rotl(m_s[1] * 5, 7) * 9;
+        const uint64_t t = m_s[1] << 17;
+        m_s[2] ^= m_s[0];
+        m_s[3] ^= m_s[1];
+        m_s[1] ^= m_s[2];
+        m_s[0] ^= m_s[3];
+        m_s[2] ^= t;
+        m_s[3] = rotl(m_s[3], 45);
+        return result;
+    }
+    result_type operator()() { return next(); }
+
+    // Равномерно [0, n), n > 0. Умножение со сдвигом (Lemire) с отбраковкой - без смещения и без деления
+    // в обычном случае.
+    uint32_t below(uint32_t n) {
+        uint64_t m = static_cast<uint64_t>(static_cast<uint32_t>(next() >> 32)) * n;
+        uint32_t low = static_cast<uint32_t>(m);
+        if (low < n) {
+            const uint32_t threshold = static_cast<uint32_t>(-n) % n;
+            while (low < threshold) {
+                m = static_cast<uint64_t>(static_cast<uint32_t>(next() >> 32)) * n;
+                low = static_cast<uint32_t>(m);
+            }
+        }
+        return static_cast<uint32_t>(m >> 32);
+    }
+
+    // Равномерно [0, 1).
+    float uniform01() { return static_cast<float>(next() >> 40) * (1.0f / 16777216.0f); }
+
+    // Сдвиг на 2^128 шагов.
+    void jump() {
+        static const uint64_t JUMP[] = { 0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull };
+        uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        for (int i = 0; i < 4; ++i) {
+            for (int b = 0; b < 64; ++b) {
+                if (JUMP[i] & (1ull << b)) {
+                    s0 ^= m_s[0]; s1 ^= m_s[1]; s2 ^= m_s[2]; s3 ^= m_s[3];
+                }
+                next();
+            }
+        }
+        m_s[0] = s0; m_s[1] = s1; m_s[2] = s2; m_s[3] = s3;
+    }
+
+    Xoshiro256 split() {
+        Xoshiro256 child = *this;
+        jump();
+        return child;
+    }
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include "Point.h"
+#include "Missile.h"
+#include "Launcher.h"
+#include "Radar.h"
+#include "MissileLog.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h> // Только для HDC/RECT в draw()
+#endif
+
+// --- Радар в кадре (по одному на позицию RadarNetwork, основной - первый) ---
+struct RenderRadar {
+    Point pos = { 0.0f, 0.0f };
+    RadarState state = {};          // Состояние радара на момент публикации
+    float previousBeamAngle = 0.0f; // Угол луча в предыдущем кадре
+    std::vector<int> trackIds;      // ID целей на сопровождении (порядок завязки)
+
+    // Луч вращается только вперед: от предыдущего угла к текущему по кратчайшему положительному повороту.
+    float beamAngleAt(float alpha) const {
+        return normalizeAngle(previousBeamAngle + normalizeAngle(state.currentAngle - previousBeamAngle) * alpha);
+    }
+};
+
+// --- Кадр для отрисовки ---
+// Поток симуляции (SimulationThread) после шага копирует сюда все, что нужно окну, и публикует кадр
+// через тройной буфер; отрисовка читает только кадр и к SimulationState не обращается.
+// Кадр хранит два момента - предыдущий шаг и текущий, - и отрисовка показывает состояние между ними
+// (interpolationAlpha), поэтому частота кадров окна не связана с шагом симуляции.
+// Позиции ракет интерполируются точно: полет прямолинейный, pos = origin + velocity * (t - launchTime).
+struct RenderFrame {
+    enum { RECENT_MISSILES = 15 }; // Сколько последних ракет показывать в списке событий
+
+    uint64_t tick = 0;
+    float previousGameTime = 0.0f; // Игровое время предыдущего шага (начало интервала интерполяции)
+    float gameTime = 0.0f;         // Игровое время этого шага
+    float stepSeconds = 0.0f;      // Длительность шага по настенным часам
+    std::chrono::steady_clock::time_point stepWallTime; // Настенное время, которому соответствует gameTime
+
+    std::vector<RenderRadar> radars;
+
+    std::vector<Launcher> launchers;
+    std::vector<Missile> missiles; // Активные ракеты (pos - на gameTime)
+
+    bool isGameOver = false;
+    bool playerWon = false;
+    int missilesLaunched = 0;
+    int maxMissiles = 0;
+    int missilesDestroyed = 0;
+    // Последние события ракет с ID missilesLaunched - 1, missilesLaunched - 2, ... (missileId == -1 - записи нет).
+    std::vector<MissileLogEntry> recentEvents;
+
+    // Доля интервала [previousGameTime, gameTime] для момента now: 0 - предыдущий шаг, 1 - этот.
+    // Кадр показывается с отставанием на шаг, зато между шагами движение плавное.
+    float interpolationAlpha(std::chrono::steady_clock::time_point now) const {
+        if (stepSeconds <= 0.0f) return 1.0f;
+        float alpha = std::chrono::duration<float>(now - stepWallTime).count() / stepSeconds;
+        return alpha < 0.0f ? 0.0f : (alpha > 1.0f ? 1.0f : alpha);
+    }
+    float gameTimeAt(float alpha) const { return previousGameTime + (gameTime - previousGameTime) * alpha; }
+    // Позиция ракеты на момент t (до запуска - точка старта).
+    static Point missilePosAt(const Missile& missile, float t) {
+        float flight = t - missile.launchTime;
+        if (flight < 0.0f) flight = 0.0f;
+        return missile.origin + missile.velocity * flight;
+    }
+
+#ifdef _WIN32
+    void draw(HDC hdc, const RECT* clientRect, float alpha) const; // Реализация в GdiDraw.cpp
+#endif
+};
@@ -0,0 +1,100 @@
+// --- Бенчмарк перезапуска игры ---
+// Играет --restarts игр подряд на одном SimulationState: --ticks тиков с шагом --dt, затем reset(config)
+// (как клавиша перезапуска окна). Замеряется только reset(): парковка радара, сброс состояния и повторный
+// запуск. Печатает среднее, p50, p99, максимум в микросекундах и число перезапусков дольше 1 мс.
+// --radar threaded - поток радара по настенным часам (режим окна): поток живет между играми и
+// паркуется/перевзводится, а не создается заново. --realtime - тики идут с шагом dt по настенным часам,
+// как в окне (иначе игра проходит за микросекунды и поток радара до перезапуска почти не успевает работать).
+//
+// Использование: RestartBench [radar_config.txt] [--radar threaded|lockstep|pipelined] [--restarts N]
+//                             [--ticks N] [--dt сек] [--realtime]
+#include "GameConfig.h"
+#include "SimulationState.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cwchar>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    std::string configPath = "radar_config.txt";
+    RadarMode radarMode = RadarMode::Threaded;
+    int restarts = 1000;
+    int ticks = 20;
+    float dt = 0.01f;
+    bool realtime = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--radar") == 0 && i + 1 < argc) {
+            const char* mode = argv[++i];
+            if (!parseRadarMode(mode, radarMode)) {
+                std::fprintf(stderr, "unknown radar mode '%s' (threaded|lockstep|pipelined)\n", mode);
+                return 2;
+            }
+        }
+        else if (std::strcmp(argv[i], "--restarts") == 0 && i + 1 < argc) restarts = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) ticks = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--dt") == 0 && i + 1 < argc) dt = static_cast<float>(std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--realtime") == 0) realtime = true;
+        else if (argv[i][0] != '-') configPath = argv[i];
+        else {
+            restarts = 0;
+            break;
+        }
+    }
+    if (restarts <= 0 || ticks < 0 || !(dt > 0.0f)) {
+        std::fprintf(stderr, "usage: RestartBench [radar_config.txt] [--radar threaded|lockstep|pipelined] [--restarts N]\n"
+                             "                    [--ticks N] [--dt sec] [--realtime]\n");
+        return 2;
+    }
+
+    GameConfig config;
+    if (!config.loadFromFile(configPath)) {
+        std::fwprintf(stderr, L"%ls\n", config.lastError.c_str());
+        return 1;
+    }
+    config.event_journal.clear(); // Замеряется перезапуск, а не открытие файлов
+    config.input_recording.clear();
+
+    using clock = std::chrono::steady_clock;
+    SimulationState state;
+    state.seed(1);
+    auto t0 = clock::now();
+    state.initialize(config, radarMode);
+    double firstUs = std::chrono::duration<double, std::micro>(clock::now() - t0).count();
+
+    std::vector<double> us;
+    us.reserve(static_cast<size_t>(restarts));
+    for (int game = 0; game < restarts; ++game) {
+        for (int t = 0; t < ticks && !state.isGameOver(); ++t) {
+            state.update(dt, config);
+            if (realtime) std::this_thread::sleep_for(std::chrono::duration<float>(dt));
+        }
+        auto start = clock::now();
+        state.reset(config);
+        us.push_back(std::chrono::duration<double, std::micro>(clock::now() - start).count());
+    }
+    state.shutdown();
+
+    double total = 0.0;
+    int over = 0;
+    for (double v : us) {
+        total += v;
+        if (v > 1000.0) ++over;
+    }
+    std::sort(us.begin(), us.end());
+    std::printf("config=%s\n", configPath.c_str());
+    std::printf("radar=%s\n", radarModeName(radarMode));
+    std::printf("restarts=%d ticks_per_game=%d dt=%.4f realtime=%d\n", restarts, ticks, dt, realtime ? 1 : 0);
+    std::printf("first_init_us=%.1f\n", firstUs);
+    std::printf("restart_us_mean=%.1f\n", total / us.size());
+    std::printf("restart_us_p50=%.1f\n", us[us.size() / 2]);
+    std::printf("restart_us_p99=%.1f\n", us[std::min(us.size() - 1, us.size() * 99 / 100)]);
+    std::printf("restart_us_max=%.1f\n", us.back());
+    std::printf("over_1ms=%d\n", over);
+    return 0;
+}
@@ -0,0 +1,176 @@
+#include "ScenarioFile.h" // Включаем заголовок файла сценария
+#include <cstring>
+#include <ctime>
+
+namespace scenario {
+
+uint64_t digestRecord(uint64_t digest, const void* record, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(record);
+    for (size_t i = 0; i < size; ++i) {
+        digest ^= bytes[i];
+        digest *= 0x100000001B3ull;
+    }
+    return digest;
+}
+
+} // namespace scenario
+
+using namespace scenario;
+
+
+// --- Писатель ---
+
+ScenarioWriter::ScenarioWriter() : m_file(nullptr), m_batchUsed(0), m_lastTimeNs(0) {
+    std::memset(&m_header, 0, sizeof(m_header));
+}
+
+ScenarioWriter::~ScenarioWriter() {
+    close();
+}
+
+bool ScenarioWriter::open(const std::string& path, const std::vector<Point>& launchers) {
+    close();
+    m_lastError.clear();
+
+    m_file = std::fopen(path.c_str(), "wb");
+    if (!m_file) {
+        m_lastError = "cannot create '" + path + "'";
+        return false;
+    }
+    std::setvbuf(m_file, nullptr, _IONBF, 0); // Буферизацию делаем сами пакетами запусков.
+
+    m_batch.resize(DEFAULT_BATCH_LAUNCHES); // Единственное выделение памяти писателя.
+    m_batchUsed = 0;
+    m_lastTimeNs = 0;
+
+    std::memset(&m_header, 0, sizeof(m_header));
+    std::memcpy(m_header.magic, "RGSCEN\0\0", 8);
+    m_header.version = VERSION;
+    m_header.headerSize = HEADER_SIZE;
+    m_header.launcherSize = LAUNCHER_SIZE;
+    m_header.launchSize = LAUNCH_SIZE;
+    m_header.byteOrder = BYTE_ORDER_MARK;
+    m_header.launcherCount = static_cast<uint32_t>(launchers.size());
+    m_header.fingerprint = DIGEST_INIT;
+    m_header.createdUnix = static_cast<int64_t>(std::time(nullptr));
+
+    // Заголовок переписывается в close() (число запусков и контрольная сумма).
+    bool ok = std::fwrite(&m_header, sizeof(m_header), 1, m_file) == 1;
+    for (size_t i = 0; ok && i < launchers.size(); ++i) {
+        ScenarioLauncher record;
+        std::memset(&record, 0, sizeof(record));
+        record.x = launchers[i].x;
+        record.y = launchers[i].y;
+        m_header.fingerprint = digestRecord(m_header.fingerprint, &record, sizeof(record));
+        ok = std::fwrite(&record, sizeof(record), 1, m_file) == 1;
+    }
+    if (!ok) {
+        m_lastError = "cannot write header to '" + path + "'";
+        std::fclose(m_file);
+        m_file = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool ScenarioWriter::append(const ScenarioLaunch& launch) {
+    if (!m_file) return false;
+    if (launch.timeNs < m_lastTimeNs || launch.launcher >= m_header.launcherCount) {
+        m_lastError = "launch " + std::to_string(m_header.launchCount) + ": time goes backwards or launcher is out of range";
+        return false;
+    }
+    m_lastTimeNs = launch.timeNs;
+    m_header.fingerprint = digestRecord(m_header.fingerprint, &launch, sizeof(launch));
+    ++m_header.launchCount;
+    m_batch[m_batchUsed] = launch;
+    if (++m_batchUsed == m_batch.size()) return flush();
+    return true;
+}
+
+bool ScenarioWriter::flush() {
+    if (m_batchUsed == 0) return true;
+    size_t written = std::fwrite(m_batch.data(), LAUNCH_SIZE, m_batchUsed, m_file);
+    bool ok = written == m_batchUsed;
+    m_batchUsed = 0;
+    if (!ok) m_lastError = "scenario write failed";
+    return ok;
+}
+
+bool ScenarioWriter::close() {
+    if (!m_file) return false;
+    bool ok = flush();
+    ok = ok && std::fseek(m_file, 0, SEEK_SET) == 0 && std::fwrite(&m_header, sizeof(m_header), 1, m_file) == 1;
+    if (!ok && m_lastError.empty()) m_lastError = "cannot update scenario header";
+    ok = std::fclose(m_file) == 0 && ok;
+    m_file = nullptr;
+    return ok;
+}
+
+
+// --- Читатель ---
+
+ScenarioReader::ScenarioReader() : m_header(nullptr), m_launchers(nullptr), m_launches(nullptr) {}
+
+bool ScenarioReader::open(const std::string& path) {
+    if (m_header && path == m_path) return true;
+    close();
+    m_lastError.clear();
+    if (!m_file.open(path, true)) {
+        m_lastError = m_file.lastError();
+        return false;
+    }
+    if (m_file.size() < HEADER_SIZE) {
+        m_lastError = "'" + path + "' is too small for a scenario header";
+        m_file.close();
+        return false;
+    }
+    const ScenarioHeader* header = reinterpret_cast<const ScenarioHeader*>(m_file.data());
+    if (std::memcmp(header->magic, "RGSCEN\0\0", 8) != 0) {
+        m_lastError = "'" + path + "' is not a RadarGame scenario";
+        m_file.close();
+        return false;
+    }
+    if (header->byteOrder != BYTE_ORDER_MARK) {
+        m_lastError = "'" + path + "' was written with a different byte order";
+        m_file.close();
+        return false;
+    }
+    if (header->version != VERSION || header->headerSize != HEADER_SIZE || header->launcherSize != LAUNCHER_SIZE ||
+        header->launchSize != LAUNCH_SIZE) {
+        m_lastError = "'" + path + "' has an unsupported scenario version";
+        m_file.close();
+        return false;
+    }
+    // Размер проверяется без чтения записей: открытие не трогает страницы запусков.
+    const uint64_t launchersEnd = HEADER_SIZE + static_cast<uint64_t>(header->launcherCount) * LAUNCHER_SIZE;
+    if (m_file.size() < launchersEnd || (m_file.size() - launchersEnd) / LAUNCH_SIZE < header->launchCount) {
+        m_lastError = "'" + path + "' is truncated";
+        m_file.close();
+        return false;
+    }
+    m_header = header;
+    m_launchers = m_file.data() + HEADER_SIZE;
+    m_launches = m_file.data() + launchersEnd;
+    m_path = path;
+    return true;
+}
+
+void ScenarioReader::close() {
+    m_file.close();
+    m_header = nullptr;
+    m_launchers = nullptr;
+    m_launches = nullptr;
+    m_path.clear();
+}
+
+Point ScenarioReader::launcher(uint32_t i) const {
+    ScenarioLauncher record;
+    std::memcpy(&record, m_launchers + static_cast<size_t>(i) * LAUNCHER_SIZE, sizeof(record));
+    return Point{ record.x, record.y };
+}
+
+ScenarioLaunch ScenarioReader::launch(uint64_t i) const {
+    ScenarioLaunch record;
+    std::memcpy(&record, m_launches + static_cast<size_t>(i) * LAUNCH_SIZE, sizeof(record));
+    return record;
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+#include "Point.h"
+
+// --- Файл сценария: заранее рассчитанный налет (пусковые и все запуски) ---
+//
+// Формат (little-endian, все поля фиксированной ширины):
+//   ScenarioHeader (64 байта): сигнатура, версия, размеры записей, число пусковых и запусков, контрольная сумма.
+//   Далее launcherCount записей ScenarioLauncher (16 байт) - позиции пусковых (индекс - ID пусковой),
+//   затем launchCount записей ScenarioLaunch (24 байта) по неубыванию времени.
+// Время запуска - целые наносекунды часов симуляции (SimulationState::secondsToClock): момент запуска
+// не зависит от шага, и налет одинаков на любой конфигурации.
+//
+// SimulationState читает файл через MappedFile: открытие - только проверка заголовка и размера, записи
+// запусков читаются по одной по мере хода игрового времени (без разбора и выделения памяти на запуск),
+// страницы подгружает ОС. Поэтому сценарий в миллионы запусков не загружается в память и игра стартует сразу.
+// Контрольная сумма записей считается при создании файла (ScenarioWriter) и хранится в заголовке:
+// по ней повтор записи ввода проверяет, что идет тот же сценарий.
+
+namespace scenario {
+
+enum : uint32_t {
+    VERSION = 1,
+    HEADER_SIZE = 64,
+    LAUNCHER_SIZE = 16,
+    LAUNCH_SIZE = 24,
+    BYTE_ORDER_MARK = 0x01020304u
+};
+
+#pragma pack(push, 1)
+struct ScenarioHeader {
+    char magic[8];            // "RGSCEN\0\0"
+    uint32_t version;
+    uint32_t headerSize;      // HEADER_SIZE
+    uint32_t launcherSize;    // LAUNCHER_SIZE
+    uint32_t launchSize;      // LAUNCH_SIZE
+    uint32_t byteOrder;       // BYTE_ORDER_MARK в порядке байт писателя
+    uint32_t launcherCount;
+    uint64_t launchCount;
+    uint64_t fingerprint;     // Контрольная сумма пусковых и запусков (digestRecord)
+    int64_t createdUnix;      // Время создания (секунды Unix)
+    uint8_t reserved[HEADER_SIZE - 56];
+};
+
+struct ScenarioLauncher {
+    float x;
+    float y;
+    uint32_t reserved[2];
+};
+
+struct ScenarioLaunch {
+    int64_t timeNs;           // Момент запуска (часы симуляции)
+    uint32_t launcher;        // Индекс пусковой
+    float targetX;
+    float targetY;
+    float speed;              // Скорость ракеты, единиц/с
+};
+#pragma pack(pop)
+
+static_assert(sizeof(ScenarioHeader) == HEADER_SIZE, "ScenarioHeader size");
+static_assert(sizeof(ScenarioLauncher) == LAUNCHER_SIZE, "ScenarioLauncher size");
+static_assert(sizeof(ScenarioLaunch) == LAUNCH_SIZE, "ScenarioLaunch size");
+
+const uint64_t DIGEST_INIT = 0xCBF29CE484222325ull;
+// FNV-1a по байтам записи (контрольная сумма сценария).
+uint64_t digestRecord(uint64_t digest, const void* record, size_t size);
+
+} // namespace scenario
+
+
+// --- Писатель сценария (генератор, ScenarioGen.cpp) ---
+// Запуски копятся в пакет и уходят в файл одним fwrite; close() дописывает в заголовок число запусков
+// и контрольную сумму. Запуски должны идти по неубыванию времени (иначе append() возвращает false).
+class ScenarioWriter {
+private:
+    std::FILE* m_file;
+    std::vector<scenario::ScenarioLaunch> m_batch;
+    size_t m_batchUsed;
+    scenario::ScenarioHeader m_header;
+    int64_t m_lastTimeNs;
+    std::string m_lastError;
+
+    bool flush();
+
+public:
+    enum { DEFAULT_BATCH_LAUNCHES = 4096 };
+
+    ScenarioWriter();
+    ~ScenarioWriter();
+
+    ScenarioWriter(const ScenarioWriter&) = delete;
+    ScenarioWriter& operator=(const ScenarioWriter&) = delete;
+
+    // Создает (перезаписывает) файл и пишет заголовок и пусковые.
+    bool open(const std::string& path, const std::vector<Point>& launchers);
+    bool append(const scenario::ScenarioLaunch& launch);
+    bool close(); // false - ошибка записи (текст в lastError())
+
+    bool isOpen() const { return m_file != nullptr; }
+    uint64_t launchCount() const { return m_header.launchCount; }
+    uint64_t fingerprint() const { return m_header.fingerprint; }
+    const std::string& lastError() const { return m_lastError; }
+};
+
+
+// --- Читатель сценария (через MappedFile) ---
+class ScenarioReader {
+private:
+    MappedFile m_file;
+    const scenario::ScenarioHeader* m_header;
+    const uint8_t* m_launchers;
+    const uint8_t* m_launches;
+    std::string m_path;
+    std::string m_lastError;
+
+public:
+    ScenarioReader();
+
+    ScenarioReader(const ScenarioReader&) = delete;
+    ScenarioReader& operator=(const ScenarioReader&) = delete;
+
+    // Тот же путь, что у открытого файла, - ничего не делает (отображение переиспользуется между играми).
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return m_header != nullptr; }
+    const std::string& path() const { return m_path; }
+    const std::string& lastError() const { return m_lastError; }
+    const scenario::ScenarioHeader& header() const { return *m_header; }
+
+    uint32_t launcherCount() const { return m_header->launcherCount; }
+    uint64_t launchCount() const { return m_header->launchCount; }
+    uint64_t fingerprint() const { return m_header->fingerprint; }
+    Point launcher(uint32_t i) const;
+    scenario::ScenarioLaunch launch(uint64_t i) const; // Копия записи: файл не обязан быть выровнен
+};
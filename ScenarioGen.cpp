@@ -0,0 +1,106 @@
+// --- Генератор файла сценария (ScenarioFile.h) ---
+// Пусковые стоят на кольце радиуса --distance вокруг базы; запуски - поток Пуассона со средним темпом
+// launches / duration (интервалы экспоненциальные, поэтому времена идут по возрастанию без сортировки),
+// пусковая каждого запуска - случайная, скорость равномерна в [min, max], цель - база или случайная точка
+// в круге --target-spread вокруг нее. Вся случайность - из Xoshiro256 с --seed: тот же seed дает побитно
+// тот же файл. Файл пишется потоком, память не зависит от числа запусков.
+//
+// Использование: ScenarioGen файл [--launches N] [--launchers N] [--duration сек] [--seed N]
+//                            [--distance D] [--speed min:max] [--target-spread R]
+// Сценарий подключается ключом scenario конфигурации или BatchRunner --scenario файл.
+#include "ScenarioFile.h"
+#include "Random.h"
+#include "Point.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    const char* outPath = nullptr;
+    unsigned long long launches = 1000000;
+    int launcherCount = 36;
+    double duration = 600.0;
+    uint64_t seed = 1;
+    float distance = 600.0f;
+    float minSpeed = 40.0f, maxSpeed = 80.0f;
+    float targetSpread = 0.0f;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--launches") == 0 && i + 1 < argc) launches = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--launchers") == 0 && i + 1 < argc) launcherCount = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--duration") == 0 && i + 1 < argc) duration = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--distance") == 0 && i + 1 < argc) distance = static_cast<float>(std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+            if (std::sscanf(argv[++i], "%f:%f", &minSpeed, &maxSpeed) == 1) maxSpeed = minSpeed;
+        }
+        else if (std::strcmp(argv[i], "--target-spread") == 0 && i + 1 < argc) targetSpread = static_cast<float>(std::atof(argv[++i]));
+        else if (!outPath && argv[i][0] != '-') outPath = argv[i];
+        else {
+            outPath = nullptr;
+            break;
+        }
+    }
+    if (!outPath || launches == 0 || launcherCount <= 0 || !(duration > 0.0) || !(distance > 0.0f) ||
+        !(minSpeed > 0.0f) || !(maxSpeed >= minSpeed) || !(targetSpread >= 0.0f)) {
+        std::fprintf(stderr, "usage: ScenarioGen file [--launches N] [--launchers N] [--duration sec] [--seed N]\n"
+                             "                         [--distance D] [--speed min:max] [--target-spread R]\n");
+        return 2;
+    }
+
+    std::vector<Point> launchers(static_cast<size_t>(launcherCount));
+    for (int i = 0; i < launcherCount; ++i) {
+        float a = 2.0f * M_PI_F * static_cast<float>(i) / static_cast<float>(launcherCount);
+        launchers[static_cast<size_t>(i)] = { distance * std::cos(a), distance * std::sin(a) };
+    }
+
+    auto wallStart = std::chrono::steady_clock::now();
+    ScenarioWriter writer;
+    if (!writer.open(outPath, launchers)) {
+        std::fprintf(stderr, "%s\n", writer.lastError().c_str());
+        return 1;
+    }
+
+    Xoshiro256 rng(seed);
+    const double meanGap = duration / static_cast<double>(launches);
+    double t = 0.0;
+    for (unsigned long long k = 0; k < launches; ++k) {
+        // 1 - u в (0, 1]: логарифм конечен.
+        t += -std::log(1.0 - static_cast<double>(rng.uniform01())) * meanGap;
+        scenario::ScenarioLaunch launch;
+        std::memset(&launch, 0, sizeof(launch));
+        launch.timeNs = static_cast<int64_t>(std::llround(t * 1e9));
+        launch.launcher = rng.below(static_cast<uint32_t>(launcherCount));
+        launch.speed = minSpeed + (maxSpeed - minSpeed) * rng.uniform01();
+        if (targetSpread > 0.0f) {
+            float r = targetSpread * std::sqrt(rng.uniform01());
+            float a = 2.0f * M_PI_F * rng.uniform01();
+            launch.targetX = r * std::cos(a);
+            launch.targetY = r * std::sin(a);
+        }
+        if (!writer.append(launch)) {
+            std::fprintf(stderr, "%s\n", writer.lastError().c_str());
+            return 1;
+        }
+    }
+    const uint64_t fingerprint = writer.fingerprint();
+    const uint64_t written = writer.launchCount();
+    if (!writer.close()) {
+        std::fprintf(stderr, "%s\n", writer.lastError().c_str());
+        return 1;
+    }
+    double wallSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    std::printf("scenario=%s\n", outPath);
+    std::printf("launchers=%d\n", launcherCount);
+    std::printf("launches=%llu\n", static_cast<unsigned long long>(written));
+    std::printf("duration_sec=%.3f\n", t);
+    std::printf("bytes=%llu\n", static_cast<unsigned long long>(scenario::HEADER_SIZE + launchers.size() * scenario::LAUNCHER_SIZE +
+                                                                written * scenario::LAUNCH_SIZE));
+    std::printf("fingerprint=%016llx\n", static_cast<unsigned long long>(fingerprint));
+    std::printf("wall_sec=%.3f\n", wallSec);
+    return 0;
+}
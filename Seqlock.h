@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <thread>
+
+// --- Seqlock: согласованная копия небольшой структуры без мьютекса ---
+// Читатель копирует структуру целиком и повторяет копирование, только если в этот момент шла запись
+// (запись длится несколько наносекунд, повтор на практике редкость). Читатель ничего не пишет
+// в общую память, поэтому сколько угодно читателей не мешают ни друг другу, ни писателю.
+//
+// Писателей может быть несколько (поток радара и поток симуляции): они занимают счетчик через CAS
+// (нечетное значение = идет запись). Пока счетчик занят другим писателем, ждущий писатель уступает
+// процессор (std::this_thread::yield()); читатель и писатель без соперника системных вызовов не делают.
+//
+// Данные хранятся в атомарных словах (relaxed), чтобы одновременное чтение и запись не были гонкой
+// данных по стандарту; порядок обеспечивают барьеры вокруг счетчика.
+template <typename T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable<T>::value, "Seqlock<T> requires a trivially copyable T");
+
+private:
+    enum { WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t) };
+
+    std::atomic<uint32_t> m_seq;
+    std::atomic<uint64_t> m_words[WORDS];
+
+    void loadWords(T& out) const {
+        uint64_t buf[WORDS];
+        for (int i = 0; i < WORDS; ++i) buf[i] = m_words[i].load(std::memory_order_relaxed);
+        std::memcpy(&out, buf, sizeof(T));
+    }
+    void storeWords(const T& value) {
+        uint64_t buf[WORDS] = {};
+        std::memcpy(buf, &value, sizeof(T));
+        for (int i = 0; i < WORDS; ++i) m_words[i].store(buf[i], std::memory_order_relaxed);
+    }
+
+    // Захват записи: четное -> нечетное. Возвращает значение до захвата.
+    uint32_t beginWrite() {
+        uint32_t seq = m_seq.load(std::memory_order_relaxed);
+        for (;;) {
+            if ((seq & 1u) == 0 &&
+                m_seq.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                std::atomic_thread_fence(std::memory_order_release); // Нечетный счетчик виден раньше новых данных.
+                return seq;
+            }
+            if (seq & 1u) {
+                std::this_thread::yield(); // Другой писатель посередине копирования.
+                seq = m_seq.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    void endWrite(uint32_t seq) {
+        m_seq.store(seq + 2, std::memory_order_release);
+    }
+
+public:
+    explicit Seqlock(const T& initial = T()) : m_seq(0) {
+        storeWords(initial);
+    }
+
+    Seqlock(const Seqlock&) = delete;
+    Seqlock& operator=(const Seqlock&) = delete;
+
+    // Согласованная копия всей структуры.
+    T read() const {
+        T out;
+        for (;;) {
+            uint32_t before = m_seq.load(std::memory_order_acquire);
+            if (before & 1u) continue; // Идет запись.
+            loadWords(out);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_seq.load(std::memory_order_relaxed) == before) return out;
+        }
+    }
+
+    // Полная замена значения.
+    void write(const T& value) {
+        uint32_t seq = beginWrite();
+        storeWords(value);
+        endWrite(seq);
+    }
+
+    // Чтение-изменение-запись: f(T&) получает текущее значение, изменения публикуются атомарно для читателей.
+    // Между несколькими писателями update() сериализован. f должна быть короткой и не бросать исключений.
+    template <typename F>
+    void update(F&& f) {
+        uint32_t seq = beginWrite();
+        T value;
+        loadWords(value);
+        f(value);
+        storeWords(value);
+        endWrite(seq);
+    }
+};
@@ -1,62 +1,190 @@
 #pragma once
 
 #include <vector>
-#include <windows.h>
 #include <map> // Для таймеров
+#include <mutex>
+#include <cstdint>
+#include <cmath>
 #include "Missile.h"
+#include "MissileStore.h"
 #include "Launcher.h"
 #include "Radar.h"
+#include "RadarNetwork.h"
+#include "AuctionSolver.h"
 #include "GameConfig.h"
 #include "MissileLog.h"
+#include "EventJournal.h"
+#include "InputRecording.h"
+#include "ScenarioFile.h"
+#include "Random.h"
+
+struct RenderFrame; // Кадр для отрисовки (RenderFrame.h)
 
 struct LauncherTimerState {
     float timeSinceLastLaunch = 0.0f;
     float currentLaunchDelay = 2.0f;
 };
 
+// Следующий запуск пусковой из конфигурации (config.launchers): элемент min-кучи по (atNs, launcher).
+struct LaunchSlot {
+    int64_t atNs;       // Момент запуска (часы симуляции)
+    uint32_t launcher;  // Индекс в m_launchers
+    bool operator>(const LaunchSlot& other) const {
+        return atNs != other.atNs ? atNs > other.atNs : launcher > other.launcher;
+    }
+};
+
+// Интервал между запусками одной пусковой: minNs + [0, spanNs).
+struct LaunchInterval {
+    int64_t minNs;
+    int64_t spanNs;
+};
+
+// Цель назначения огневых каналов: трек радара site с индексом track в его таблице.
+struct EngagementThreat {
+    int missileId;
+    uint32_t site;
+    uint32_t track;
+};
+
 // Класс SimulationState
 class SimulationState {
 private:
-    std::vector<Missile> m_activeMissiles;
+    MissileStore m_missiles;               // Все ракеты в виде структуры массивов (основное хранилище)
     std::vector<Launcher> m_launchers;
-    Radar m_radar;
+    RadarNetwork m_radars;                 // Позиция 0 - основной радар в центре (база)
     MissileLog m_missileLog;
     MissileLog* m_pMissileLog;
+    JournalWriter m_journal;     // Бинарный журнал событий (если задан event_journal)
+    InputRecorder m_recorder;    // Запись ввода (если задан input_recording)
+    bool m_gameRunning;          // initialize() вызван, итог игры еще не записан (finishGame)
+    uint64_t m_logCursor;        // Позиция чтения кольца MissileLog (журнал и контрольная сумма)
+    uint64_t m_eventCount;       // События текущей игры
+    uint64_t m_eventDigest;      // Их контрольная сумма (missileLogDigest)
+    int m_gameIndex;             // Номер игры с момента запуска (для имени файла журнала)
+    Xoshiro256 m_rng;            // Генератор случайных задержек и выбора пусковой (свой у каждой симуляции)
+    uint64_t m_seed;             // Начальное значение генератора текущей игры
 
+    // Игровое время ведется целыми наносекундами: сумма шагов точна и не зависит от того,
+    // шли ли тики по одному или пачкой (skipTicks). m_gameTime - то же время в секундах.
+    int64_t m_clockNs;
+    uint64_t m_tick;             // Вызовов update() (и пропущенных тиков) с начала игры
     float m_gameTime;
     bool m_isGameOver;
     bool m_playerWon;
     int m_missilesDestroyed;
     int m_missilesLaunched;
     int m_maxMissiles;
-    float m_nextLaunchTimer;
+    int64_t m_nextLaunchAtNs;    // Момент следующего запуска (m_clockNs)
     float m_nextLaunchDelay;
+    // Пусковые из конфигурации: у каждой свое расписание; пусто - общее расписание m_nextLaunchAtNs.
+    std::vector<LaunchSlot> m_launchQueue;        // min-куча (std::push_heap с greater)
+    std::vector<LaunchInterval> m_launchIntervals; // По индексу пусковой
+    // Сценарий (config.scenario): отображение файла переиспользуется между играми с тем же путем.
+    ScenarioReader m_scenario;
+    uint64_t m_scenarioNext;                      // Индекс следующей записи запуска
+    RadarMode m_radarMode; // Где сканирует радар (см. initialize())
+    // Pipelined: ID целей треков каждого радара на момент передачи кадра стадии радара. Таблицы треков пишет
+    // стадия, поэтому кадр отрисовки берет эту копию, не дожидаясь стадии (перекрытие тиков сохраняется).
+    std::vector<std::vector<int>> m_frameTrackIds;
 
-    HWND m_hWnd;
+    // --- Назначение огневых каналов (radar_fire_channels > 0) ---
+    // Цели - живые треки всех радаров по возрастанию ID; выигрыш пары (цель, радар) - в m_threatBenefit.
+    AuctionSolver m_engagements;
+    int m_fireChannels;                   // Каналов у каждого радара; 0 - каждый радар сбивает свои треки
+    std::vector<RadarState> m_siteStates; // Состояния радаров этого тика
+    std::vector<EngagementThreat> m_threats;
+    std::vector<int> m_threatIds;         // ID целей подряд (для AuctionSolver::solve)
+    std::vector<float> m_threatBenefit;   // threats x радары, < 0 - радар цель не поразит
+    uint64_t m_assignmentSolves;          // Решений за игру и их время (настенные часы)
+    int64_t m_assignmentNsTotal;
+    int64_t m_assignmentNsMax;
 
     // Приватные методы
-    void launchMissile(int launcherIndex); // Индекс в векторе m_launchers
+    void launchMissile(int launcherIndex, float launchTime, Point target, float speed); // Индекс в векторе m_launchers
+    int randomInt(int n);                  // Равномерно [0, n) из m_rng
     // void updateLaunchers(float dt, const GameConfig& config); // Убрано
-    void updateMissiles(float dt);
-    void checkCollisionsAndIntercepts(const GameConfig& config);
+    bool launchIfDue(float launchTime, const GameConfig& config); // Запуск по расписанию; true - ракета добавлена
+    bool launchScheduled(const GameConfig& config); // Все наступившие запуски пусковых из конфигурации
+    bool launchFromScenario();                      // Все наступившие запуски сценария
+    void drainBurst(size_t& sinceDrain);            // Перенос лога посреди большого залпа
+    int64_t drawLaunchInterval(uint32_t launcher);
+    int64_t nextLaunchAtNs() const;                 // Момент следующего запуска (INT64_MAX - запусков больше нет)
+    void updateMissiles();
+    long findDeadZoneHit(float deadZoneRadius, size_t first) const; // Первая активная ракета в мертвой зоне или -1
+    void checkCollisionsAndIntercepts(const GameConfig& config, long deadZoneHit, float dt);
+    // Треки одного радара: measureTracks() - перенос цели потока, измерения и фильтр; engageTracks() - поражение
+    // своих целей и отпускание (без огневых каналов); releaseTracks() - удаление сброшенных треков.
+    void measureTracks(Radar& radar, const RadarState& radarState, float dt);
+    void engageTracks(Radar& radar, const RadarState& radarState);
+    void releaseTracks(Radar& radar, const RadarState& radarState);
+    void assignEngagements(const GameConfig& config, float dt); // Огневые каналы: назначение по всем радарам и поражение
+    void destroyTrack(TrackTable& tracks, size_t k);
+    void captureFrameTracks(); // Pipelined: копия ID целей треков для fillRenderFrame() (до postStep())
+    void expireMissiles();        // Ракеты, прошедшие точку цели мимо базы, - "Промах"
     void checkGameOverConditions(const GameConfig& config);
     void cleanupInactiveMissiles();
+    void drainLog();              // Новые записи MissileLog -> контрольная сумма и журнал
+    void finishGame();            // Парковка радара, последние события, итог игры в записи ввода, закрытие журнала
+
+    friend class EventEngine; // Планирует пропуск тиков по внутреннему состоянию (EventEngine.h)
 
 public:
     SimulationState();
     ~SimulationState();
 
-    void initialize(const GameConfig& config, HWND hWnd);
+    // Lockstep: без потока радара, сканирование - стадия update() по игровому времени.
+    // Threaded: радар в своем потоке по настенным часам.
+    // Pipelined: стадия радара тика N (индекс, поиск цели, запись обнаружения) идет на втором ядре,
+    // пока update() считает движение ракет тика N+1; события те же, что у Lockstep.
+    // При записи ввода (config.input_recording) Threaded заменяется на Lockstep - иначе игру нельзя повторить;
+    // так же - при нескольких позициях радаров (radar_site): поток по настенным часам есть только у одного радара.
+    void initialize(const GameConfig& config, RadarMode radarMode);
     void update(float dt, const GameConfig& config);
-    void draw(HDC hdc, const RECT* clientRect, const GameConfig& config) const;
+    // Pipelined: дождаться стадии радара последнего тика и перенести ее события (счетчики, журнал).
+    // Нужно перед чтением getEventCount()/getEventDigest() после цикла update(); в остальных режимах ничего не делает.
+    void flushRadarStage();
+    // count тиков шагом dt, на которых заведомо ничего не происходит (решает EventEngine): двигаются только
+    // часы и луч радара. Результат тот же, что у count вызовов update(dt), но без работы по ракетам.
+    // Только для RadarMode::Lockstep.
+    void skipTicks(uint64_t count, float dt);
+    // Копия всего, что рисует окно (вызывается тем же потоком, что и update(); см. SimulationThread).
+    // Векторы кадра переиспользуются, выделение памяти - только при росте числа ракет.
+    void fillRenderFrame(RenderFrame& frame) const;
     void reset(const GameConfig& config);
     void shutdown();
+    // Начальное значение генератора следующей игры (по умолчанию - std::random_device). initialize() заново
+    // заводит генератор этим значением, поэтому игра с тем же значением и конфигурацией повторяется точно.
+    // reset() берет для новой игры следующее значение из генератора закончившейся.
+    void seed(uint64_t seed);
+    uint64_t getSeed() const { return m_seed; } // Начальное значение текущей игры
 
-    // Небезопасный доступ для Radar::draw
-    const std::vector<Missile>& getActiveMissilesUnsafe() const {
-        return m_activeMissiles;
-    }
+    // Итоги игры (для пакетного прогона и статистики)
+    bool isGameOver() const { return m_isGameOver; }
+    bool hasPlayerWon() const { return m_playerWon; }
+    float getGameTime() const { return m_gameTime; }
+    uint64_t getTick() const { return m_tick; }
+    size_t getRadarCount() const { return m_radars.size(); }
+    float getRadarAngle(size_t site = 0) const { return m_radars.site(site).getCurrentAngle(); }
+    int getMissilesLaunched() const { return m_missilesLaunched; }
+    int getMissilesDestroyed() const { return m_missilesDestroyed; }
+    int getMaxMissiles() const { return m_maxMissiles; }
+    SnapshotStats getRadarSnapshotStats() const { return m_radars.primary().getSnapshotStats(); }
+    uint64_t getJournalEventCount() const { return m_journal.eventCount(); }
+    // Назначение огневых каналов: решений за игру, их суммарное и наибольшее время (нс), статистика аукциона.
+    uint64_t getAssignmentSolves() const { return m_assignmentSolves; }
+    int64_t getAssignmentNsTotal() const { return m_assignmentNsTotal; }
+    int64_t getAssignmentNsMax() const { return m_assignmentNsMax; }
+    const AuctionStats& getAssignmentStats() const { return m_engagements.stats(); }
+    // События текущей игры и их контрольная сумма: одинаковые суммы - побитно одинаковые события.
+    uint64_t getEventCount() const { return m_eventCount; }
+    uint64_t getEventDigest() const { return m_eventDigest; }
+    bool isRecording() const { return m_recorder.isOpen(); }
+    bool hasScenario() const { return m_scenario.isOpen(); } // Игра идет по файлу сценария
+
+    // Перевод шага в наносекунды часов симуляции и обратно.
+    static int64_t secondsToClock(float seconds) { return static_cast<int64_t>(std::llround(static_cast<double>(seconds) * 1e9)); }
+    static float clockToSeconds(int64_t clockNs) { return static_cast<float>(static_cast<double>(clockNs) * 1e-9); }
 };
 
 // extern SimulationState g_simulationState; // Объявляется в main.cpp
-extern GameConfig g_config; // Объявляется в GameConfig.h/cpp
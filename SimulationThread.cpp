@@ -0,0 +1,128 @@
+#include "SimulationThread.h"
+#include "SimulationState.h"
+#include <chrono>
+
+SimulationThread::SimulationThread(SimulationState& state) :
+    m_state(state),
+    m_dt(0.03f),
+    m_maxCatchUpSteps(5),
+    m_stopThread(false),
+    m_resetRequested(false),
+    m_statSteps(0), m_statFrames(0), m_statCatchUps(0), m_statDropped(0)
+{
+}
+
+SimulationThread::~SimulationThread() {
+    stop();
+}
+
+void SimulationThread::start(const GameConfig& config, float dt, int maxCatchUpSteps) {
+    stop();
+    m_config = config;
+    m_dt = dt > 0.0f ? dt : 0.03f;
+    m_maxCatchUpSteps = maxCatchUpSteps > 0 ? maxCatchUpSteps : 1;
+    m_stopThread = false;
+    m_resetRequested = false;
+    m_statSteps = 0;
+    m_statFrames = 0;
+    m_statCatchUps = 0;
+    m_statDropped = 0;
+
+    // До старта потока состояние принадлежит вызывающему потоку: игра и первый кадр готовятся здесь.
+    m_state.initialize(m_config, m_config.radar_mode);
+    m_frames.resetEach([](RenderFrame& frame) { frame = RenderFrame(); });
+    rememberBeamAngles();
+    publishFrame(m_state.getGameTime(), std::chrono::steady_clock::now());
+
+    m_thread = std::thread(&SimulationThread::run, this);
+}
+
+void SimulationThread::stop() {
+    m_stopThread = true;
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void SimulationThread::requestReset() {
+    m_resetRequested.store(true, std::memory_order_release);
+}
+
+void SimulationThread::rememberBeamAngles() {
+    m_beamAnglesBefore.resize(m_state.getRadarCount());
+    for (size_t i = 0; i < m_beamAnglesBefore.size(); ++i) {
+        m_beamAnglesBefore[i] = m_state.getRadarAngle(i);
+    }
+}
+
+// --- Кадр после шага: текущее состояние плюс начало интервала интерполяции (углы - rememberBeamAngles()) ---
+void SimulationThread::publishFrame(float previousGameTime, std::chrono::steady_clock::time_point stepWallTime) {
+    RenderFrame& frame = m_frames.back();
+    // Pipelined: стадию радара не ждем - кадр берет копию треков, снятую при ее запуске (captureFrameTracks()).
+    m_state.fillRenderFrame(frame);
+    frame.previousGameTime = previousGameTime;
+    for (size_t i = 0; i < frame.radars.size() && i < m_beamAnglesBefore.size(); ++i) {
+        frame.radars[i].previousBeamAngle = m_beamAnglesBefore[i];
+    }
+    frame.stepSeconds = m_dt;
+    frame.stepWallTime = stepWallTime;
+    m_frames.publish();
+    m_statFrames.fetch_add(1, std::memory_order_relaxed);
+}
+
+// --- Цикл: аккумулятор настенного времени, шаги постоянной длины, ограничение догона ---
+void SimulationThread::run() {
+    typedef std::chrono::steady_clock Clock;
+    const Clock::duration step = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(m_dt));
+    Clock::time_point last = Clock::now();
+    Clock::duration accumulator = Clock::duration::zero();
+
+    while (!m_stopThread) {
+        if (m_resetRequested.exchange(false, std::memory_order_acquire)) {
+            m_state.reset(m_config);
+            last = Clock::now();
+            rememberBeamAngles();
+            publishFrame(m_state.getGameTime(), last); // Новая игра - без интерполяции со старой
+            accumulator = Clock::duration::zero();
+        }
+
+        Clock::time_point now = Clock::now();
+        accumulator += now - last;
+        last = now;
+
+        int steps = 0;
+        float gameTimeBefore = 0.0f;
+        while (accumulator >= step && steps < m_maxCatchUpSteps) {
+            // Начало интервала интерполяции - состояние перед последним шагом прохода.
+            gameTimeBefore = m_state.getGameTime();
+            rememberBeamAngles();
+            m_state.update(m_dt, m_config);
+            accumulator -= step;
+            ++steps;
+        }
+        if (accumulator >= step) {
+            // Отстали больше, чем на maxCatchUpSteps шагов: лишнее время не догоняем.
+            m_statDropped.fetch_add(static_cast<uint64_t>(accumulator / step), std::memory_order_relaxed);
+            accumulator %= step;
+        }
+
+        if (steps > 0) {
+            m_statSteps.fetch_add(static_cast<uint64_t>(steps), std::memory_order_relaxed);
+            if (steps > 1) m_statCatchUps.fetch_add(1, std::memory_order_relaxed);
+            // Шаг соответствует моменту last - accumulator: остаток аккумулятора - уже прошедшая доля следующего шага.
+            publishFrame(gameTimeBefore, last - accumulator);
+        }
+
+        // Спим до следующего шага (запас аккумулятора уже учтен).
+        std::this_thread::sleep_until(last + (step - accumulator));
+    }
+}
+
+SimulationThreadStats SimulationThread::getStats() const {
+    SimulationThreadStats stats;
+    stats.steps = m_statSteps.load(std::memory_order_relaxed);
+    stats.frames = m_statFrames.load(std::memory_order_relaxed);
+    stats.catchUps = m_statCatchUps.load(std::memory_order_relaxed);
+    stats.droppedSteps = m_statDropped.load(std::memory_order_relaxed);
+    return stats;
+}
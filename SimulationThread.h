@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "GameConfig.h"
+#include "RenderFrame.h"
+#include "TripleBuffer.h"
+
+class SimulationState; // Предварительное объявление
+
+// --- Поток симуляции с постоянным шагом ---
+// Симуляция идет в своем потоке, а не в WM_TIMER: задержки цикла сообщений (перетаскивание окна,
+// долгая отрисовка) больше не замедляют игровое время и не меняют шаг. Цикл копит прошедшее
+// настенное время (аккумулятор) и делает столько шагов update(dt) с ОДНИМ И ТЕМ ЖЕ dt, сколько в него
+// помещается; после шагов публикует RenderFrame через тройной буфер (без блокировок, отрисовка
+// ничего не ждет). Окно рисует с любой частотой, интерполируя между двумя последними шагами кадра.
+//
+// Догон ограничен: за один проход не больше maxCatchUpSteps шагов. Если поток отстал сильнее
+// (например, процесс был приостановлен), остаток аккумулятора отбрасывается - игра на это время
+// замедляется, но не прыгает вперед пачкой шагов. Последовательность update(dt) при этом та же,
+// поэтому зависание окна или потока не меняет итог игры: от настенного времени зависит только то,
+// КОГДА выполнится очередной шаг. Это верно для radar_mode = lockstep (по умолчанию) и pipelined
+// (в кадре состояние радара может отставать на стадию одного тика); при радаре в своем потоке
+// (threaded) его шаги по-прежнему идут по своим часам.
+//
+// Все обращения к SimulationState после start() - только из этого потока; окно просит перезапуск
+// через requestReset().
+
+struct SimulationThreadStats {
+    uint64_t steps = 0;          // Выполнено update(dt)
+    uint64_t frames = 0;         // Опубликовано кадров
+    uint64_t catchUps = 0;       // Проходов, в которых шагов было больше одного
+    uint64_t droppedSteps = 0;   // Шагов, отброшенных ограничением догона
+};
+
+class SimulationThread {
+private:
+    SimulationState& m_state;
+    GameConfig m_config;         // Копия конфигурации (читается только потоком симуляции)
+    float m_dt;
+    int m_maxCatchUpSteps;
+
+    std::thread m_thread;
+    std::atomic<bool> m_stopThread;
+    std::atomic<bool> m_resetRequested;
+
+    TripleBuffer<RenderFrame> m_frames;
+
+    std::atomic<uint64_t> m_statSteps, m_statFrames, m_statCatchUps, m_statDropped;
+
+    std::vector<float> m_beamAnglesBefore; // Углы лучей всех радаров перед последним шагом (только поток симуляции)
+
+    void run();
+    void rememberBeamAngles();
+    void publishFrame(float previousGameTime, std::chrono::steady_clock::time_point stepWallTime);
+
+public:
+    explicit SimulationThread(SimulationState& state);
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    // Инициализирует игру (state.initialize, режим радара - config.radar_mode) и запускает поток с шагом dt.
+    void start(const GameConfig& config, float dt, int maxCatchUpSteps = 5);
+    // Останавливает поток; после этого с SimulationState снова можно работать из вызывающего потока.
+    void stop();
+    // Перезапуск игры (SimulationState::reset) на ближайшем проходе цикла.
+    void requestReset();
+
+    // --- Сторона отрисовки (один поток) ---
+    // Забирает последний опубликованный кадр; frame() остается прежним, если нового нет.
+    bool acquireFrame() { return m_frames.acquire(); }
+    const RenderFrame& frame() const { return m_frames.front(); }
+
+    SimulationThreadStats getStats() const;
+};
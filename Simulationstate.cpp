@@ -1,4 +1,6 @@
 #include "SimulationState.h"
+#include "BeamKernel.h"
+#include "RenderFrame.h"
 #include <cmath>    
 #include <string>   
 #include <vector>
@@ -6,23 +8,38 @@
 #include <iomanip>  
 #include <algorithm>                     
 #include <map> 
-#include <random>
 #include <ctime> 
+#include <mutex>
+#include <limits>
+#include <chrono>
+#include <functional> // Для std::greater
 
-extern CRITICAL_SECTION g_cs; 
-extern GameConfig g_config; 
+static const size_t MISSILE_RESERVE_LIMIT = static_cast<size_t>(1) << 20; // Больший налет растет геометрически
 
 SimulationState::SimulationState() :
+    m_pMissileLog(&m_missileLog),
+    m_gameRunning(false),
+    m_logCursor(0),
+    m_eventCount(0),
+    m_eventDigest(MISSILE_LOG_DIGEST_INIT),
+    m_gameIndex(0),
+    m_seed(Xoshiro256::entropySeed()),
+    m_clockNs(0),
+    m_tick(0),
     m_gameTime(0.0f),
     m_isGameOver(false),
     m_playerWon(false),
     m_missilesDestroyed(0),    // Начальное кол-во сбитых ракет: 0.
     m_missilesLaunched(0),     // Начальное общее кол-во запущенных ракет: 0.
     m_maxMissiles(20),         // Максимальное кол-во ракет по умолчанию (будет заменено из конфига в initialize).
-    m_hWnd(NULL),              // Дескриптор окна: изначально NULL (устанавливается в initialize).
-    m_pMissileLog(&m_missileLog),
+    m_nextLaunchAtNs(0),
     m_nextLaunchDelay(1.0f),
-    m_nextLaunchTimer(1.0f)
+    m_scenarioNext(0),
+    m_radarMode(RadarMode::Lockstep),
+    m_fireChannels(0),
+    m_assignmentSolves(0),
+    m_assignmentNsTotal(0),
+    m_assignmentNsMax(0)
 {
 
 }
@@ -30,42 +47,118 @@ SimulationState::SimulationState() :
 SimulationState::~SimulationState() {
     shutdown(); 
 }
-void SimulationState::initialize(const GameConfig& config, HWND hWnd) {
-    m_hWnd = hWnd; 
-    m_gameTime = 0.0f;         // Игровое время сбрасывается.
+
+void SimulationState::seed(uint64_t seed) {
+    m_seed = seed;
+}
+
+int SimulationState::randomInt(int n) {
+    return static_cast<int>(m_rng.below(static_cast<uint32_t>(n)));
+}
+void SimulationState::initialize(const GameConfig& config, RadarMode radarMode) {
+    // --- Журнал и итог прошлой игры ---
+    // Поток радара паркуем до очистки лога, чтобы его запоздалые записи не попали в новую игру;
+    // оставшиеся записи прошлой игры дописываются в ее журнал.
+    finishGame();
+
+    // --- Запись ввода ---
+    // Файл открывается один раз и продолжается при перезапусках (каждая игра - запись REC_GAME).
+    if (!config.input_recording.empty() && !m_recorder.isOpen()) {
+        m_recorder.open(config.input_recording); // Ошибка - игра идет без записи.
+    }
+    if (m_recorder.isOpen() && radarMode == RadarMode::Threaded) radarMode = RadarMode::Lockstep;
+    if (config.radarCount() > 1 && radarMode == RadarMode::Threaded) radarMode = RadarMode::Lockstep;
+
+    m_radarMode = radarMode;
+    m_rng.seed(m_seed);        // Вся случайность игры - из этого значения.
+    m_clockNs = 0;             // Игровое время сбрасывается.
+    m_tick = 0;
+    m_gameTime = 0.0f;
     m_isGameOver = false;       
     m_playerWon = false;         
     m_missilesDestroyed = 0;   // Счет сбитых ракет: 0.
     m_missilesLaunched = 0;   
-    m_maxMissiles = static_cast<int>(config.distance_corner_center / 10.0f); 
-    if (m_maxMissiles < 5) m_maxMissiles = 5;    // Гарантируем минимум 5 ракет.
-    if (m_maxMissiles > 50) m_maxMissiles = 50; // Ограничиваем максимум, чтобы не перегружать симуляцию.
+    m_maxMissiles = config.missileBudget(); // max_missiles или по distance_corner_center (5 - 50)
+
+    // Сценарий: ракет - сколько в нем запусков (max_missiles > 0 обрезает налет). Файл, который не открылся,
+    // заменяется расписанием (вызывающий код проверяет файл заранее, см. BatchRunner).
+    if (config.scenario.empty() || !m_scenario.open(config.scenario)) m_scenario.close();
+    m_scenarioNext = 0;
+    if (m_scenario.isOpen()) {
+        uint64_t launches = m_scenario.launchCount();
+        if (config.max_missiles > 0 && launches > static_cast<uint64_t>(config.max_missiles)) launches = static_cast<uint64_t>(config.max_missiles);
+        if (launches > static_cast<uint64_t>(GameConfig::MAX_MISSILES)) launches = GameConfig::MAX_MISSILES;
+        m_maxMissiles = static_cast<int>(launches);
+    }
 
 
-    m_activeMissiles.clear(); 
+    m_missiles.clear(); 
+    // Массивы хранилища - сразу на весь налет (до MISSILE_RESERVE_LIMIT): без перевыделений по ходу запусков.
+    m_missiles.reserve(std::min(static_cast<size_t>(m_maxMissiles), MISSILE_RESERVE_LIMIT));
     m_launchers.clear();
-    m_missileLog.clear();
-    m_missileLog.initialize(&g_cs);
-
-    float d = config.distance_corner_center;
-    m_launchers.emplace_back(Point{ -d, d }, 0); // Пусковая 0: верхняя левая мировые (-d, +d).
-    m_launchers.emplace_back(Point{ d, d }, 1);  // Пусковая 1: верхняя правая (+d, +d).
-    m_launchers.emplace_back(Point{ -d, -d }, 2);// Пусковая 2: нижняя левая (-d, -d).
-    m_launchers.emplace_back(Point{ d, -d }, 3); // Пусковая 3: нижняя правая (+d, -d).
+    m_launchQueue.clear();
+    m_launchIntervals.clear();
+
+    // --- Журнал событий новой игры ---
+    m_missileLog.clear(); // Индекс "ракета -> последнее событие" растет по мере запусков (MissileLog::indexMissile)
+    m_logCursor = m_missileLog.totalWritten(); // Журнал и контрольная сумма - только по записям этой игры.
+    m_eventCount = 0;
+    m_eventDigest = MISSILE_LOG_DIGEST_INIT;
+    if (!config.event_journal.empty()) {
+        m_journal.open(journalPathForGame(config.event_journal, m_gameIndex), config); // Ошибка - игра идет без журнала.
+    }
+    ++m_gameIndex;
 
+    if (m_scenario.isOpen()) {
+        for (uint32_t i = 0; i < m_scenario.launcherCount(); ++i) m_launchers.emplace_back(m_scenario.launcher(i), static_cast<int>(i));
+    }
+    else if (config.launchers.empty()) {
+        float d = config.distance_corner_center;
+        m_launchers.emplace_back(Point{ -d, d }, 0); // Пусковая 0: верхняя левая мировые (-d, +d).
+        m_launchers.emplace_back(Point{ d, d }, 1);  // Пусковая 1: верхняя правая (+d, +d).
+        m_launchers.emplace_back(Point{ -d, -d }, 2);// Пусковая 2: нижняя левая (-d, -d).
+        m_launchers.emplace_back(Point{ d, -d }, 3); // Пусковая 3: нижняя правая (+d, -d).
 
-    float initialDelay = 1.0f + static_cast<float>(rand() % 30) / 10.0f; // Пример: первый запуск через 1.0 - 4.0 сек.
-    m_nextLaunchDelay = initialDelay; // Устанавливаем эту случайную задержку как текущую задержку до следующего запуска.
-    m_nextLaunchTimer = m_nextLaunchDelay;
-    m_radar.initialize(config, &g_cs, m_hWnd, m_pMissileLog);
 
+        float initialDelay = 1.0f + static_cast<float>(randomInt(30)) / 10.0f; // Пример: первый запуск через 1.0 - 4.0 сек.
+        m_nextLaunchDelay = initialDelay; // Устанавливаем эту случайную задержку как текущую задержку до следующего запуска.
+        m_nextLaunchAtNs = secondsToClock(m_nextLaunchDelay);
+    }
+    else {
+        // Пусковые из конфигурации: первый запуск каждой - в случайный момент ее первого интервала,
+        // чтобы пусковые не стреляли залпом в начале игры.
+        for (size_t i = 0; i < config.launchers.size(); ++i) {
+            const LauncherSite& site = config.launchers[i];
+            m_launchers.emplace_back(site.pos, static_cast<int>(i));
+            int64_t minNs = secondsToClock(site.minInterval);
+            m_launchIntervals.push_back({ minNs, secondsToClock(site.maxInterval) - minNs });
+            m_launchQueue.push_back({ drawLaunchInterval(static_cast<uint32_t>(i)), static_cast<uint32_t>(i) });
+        }
+        std::make_heap(m_launchQueue.begin(), m_launchQueue.end(), std::greater<LaunchSlot>());
+    }
+    m_radars.initialize(config, m_pMissileLog, m_radarMode);
+    m_frameTrackIds.resize(m_radars.size());
+    for (auto& ids : m_frameTrackIds) ids.clear(); // Емкость сохраняется
+
+    // Огневые каналы: поровну у каждого радара; решение прошлой игры не переносится.
+    m_fireChannels = config.radar_fire_channels;
+    m_engagements.configure(std::vector<int>(m_fireChannels > 0 ? m_radars.size() : 0, m_fireChannels));
+    m_assignmentSolves = 0;
+    m_assignmentNsTotal = 0;
+    m_assignmentNsMax = 0;
+
+    m_recorder.game(m_seed, config, m_scenario.isOpen() ? m_scenario.fingerprint() : 0, m_scenario.isOpen() ? m_scenario.launchCount() : 0);
+    m_gameRunning = true;
 } 
 
 
 void SimulationState::shutdown() {
-    m_radar.shutdown();
-    m_activeMissiles.clear(); // Удаляем все объекты Missile из списка активных ракет.
+    finishGame(); // Дописываем последние события до очистки лога.
+    m_radars.shutdown(); // Потоки радаров завершаются (между играми они только паркуются)
+    m_recorder.exit();
+    m_missiles.clear();       // Удаляем все ракеты из хранилища (емкость массивов сохраняется).
     m_launchers.clear();      // Удаляем все объекты Launcher из списка пусковых установок.
+    m_launchQueue.clear();
 
     m_missileLog.clear();
 
@@ -76,58 +169,243 @@ void SimulationState::shutdown() {
 
 
 void SimulationState::reset(const GameConfig& config) {
-    shutdown();
-    
-    initialize(config, m_hWnd);
+    finishGame(); // Без shutdown(): запись ввода продолжается новой игрой.
+    m_seed = m_rng.next(); // Новая игра - новое (но воспроизводимое) значение.
+    initialize(config, m_radarMode);
 } 
+// --- Один тик ---
+// Pipelined: в начале тика стадия радара прошлого тика еще идет на рабочем потоке. Движение ракет и поиск
+// ракеты в мертвой зоне от нее не зависят и считаются параллельно; все, что зависит от радара или пишет
+// в лог (запуск, цель радара, поражение), - после waitStep(), в том же порядке, что в Lockstep:
+// "Обнаружена" прошлого тика всегда раньше "Запущена" этого.
 void SimulationState::update(float dt, const GameConfig& config) {
+    const bool pipelined = m_radarMode == RadarMode::Pipelined;
 
     if (m_isGameOver) {
-        m_radar.setOperational(false);
+        m_radars.waitStep();
+        m_radars.setOperational(false);
+        drainLog(); // Итоговые события игры (например, от радара) - в журнал.
+        m_recorder.tick(dt);
         return; // Выходим из метода update().
     }
 
     // --- Продвигаем общее игровое время ---
-    m_gameTime += dt; 
-    if (m_missilesLaunched < m_maxMissiles && !m_playerWon) {
-        // Уменьшаем время до следующего ОБЩЕГО запуска на величину dt.
-        m_nextLaunchTimer -= dt;
-
-        // Если таймер достиг или опустился ниже нуля, это значит, что пришло время запустить новую ракету.
-        if (m_nextLaunchTimer <= 0) {
-            m_nextLaunchDelay = 2.0f + static_cast<float>(rand() % 40) / 10.0f; // Генерируем новую случайную задержку в секундах (2.0 - 6.0).
-            // Вызов rand() требует, чтобы std::srand() был вызван ОДИН РАЗ в начале программы (напр., в WinMain) для хорошей случайности.
-            m_nextLaunchTimer = m_nextLaunchDelay; 
-            if (!m_launchers.empty()) {
-                
-                int randomLauncherIndex = rand() % m_launchers.size();
-
-                launchMissile(randomLauncherIndex); // Передаем случайный индекс пусковой.
-            } 
-            if (m_missilesLaunched >= m_maxMissiles) {
-            }
-
-        } 
+    m_recorder.tick(dt); // Расписание тиков - в запись ввода (серии одинаковых dt сжимаются).
+    float tickStartTime = m_gameTime; // Ракета, запущенная на этом тике, летит с его начала.
+    m_clockNs += secondsToClock(dt);
+    ++m_tick;
+    m_gameTime = clockToSeconds(m_clockNs);
+
+    // Поражение базы - мертвая зона основного радара (у остальных позиций это только слепое кольцо).
+    const float deadZoneRadius = m_radars.primary().getDeadZoneRadius(); // Параметр, стадия радара его не меняет
+    long deadZoneHit;
+    if (pipelined) {
+        updateMissiles();                                  // Параллельно со стадией радара прошлого тика
+        deadZoneHit = findDeadZoneHit(deadZoneRadius, 0);
+        m_radars.waitStep();
+        size_t missilesBefore = m_missiles.size();
+        if (launchIfDue(tickStartTime, config)) {
+            // Позиция - функция времени: повторный пересчет дает прежние значения и позицию новой ракеты.
+            updateMissiles();
+            if (deadZoneHit < 0) deadZoneHit = findDeadZoneHit(deadZoneRadius, missilesBefore);
+        }
+    }
+    else {
+        launchIfDue(tickStartTime, config);
+        updateMissiles();
+        deadZoneHit = findDeadZoneHit(deadZoneRadius, 0);
     }
-    updateMissiles(dt);
     // относительно зон радара для обнаружения, уничтожения, потери цели и поражения базы.
-    checkCollisionsAndIntercepts(config);
+    checkCollisionsAndIntercepts(config, deadZoneHit, dt);
+    expireMissiles();
     checkGameOverConditions(config);
     cleanupInactiveMissiles();
-    std::vector<Missile> activeSnapshot; // Создаем новый вектор для копирования снимка.
 
-    for (const auto& missile : m_activeMissiles) { // Итерируем по всем ракетам в m_activeMissiles.
-        if (missile.isActive) { // Копируем в снимок только те, которые помечены как активные.
-            activeSnapshot.push_back(missile); // Копируем объект Missile.
+    if (pipelined) {
+        // Кадр тика - стадии радара; снимок для отрисовки и лог ниже считаются уже параллельно с ней.
+        captureFrameTracks();
+        if (!m_isGameOver) m_radars.postStep(m_missiles, m_gameTime, dt);
+    }
+    else if (m_radarMode == RadarMode::Lockstep) {
+        // Без потока радара сканирование идет по игровому времени: результат не зависит от скорости прогона.
+        m_radars.stepAt(m_missiles, m_gameTime, dt);
+    }
+    else {
+        m_radars.updateMissileSnapshot(m_missiles, m_gameTime); // Обновляем снимок в радаре (SoA-массивы из хранилища).
+    }
+
+    drainLog();
+}
+
+
+void SimulationState::flushRadarStage() {
+    m_radars.waitStep();
+    drainLog();
+}
+
+// Стадия прошлого тика уже дождана (waitStep() в update()), следующая еще не передана: таблицы треков
+// принадлежат потоку симуляции. Треки, завязанные стадией этого тика, попадут в кадр следующего.
+void SimulationState::captureFrameTracks() {
+    for (size_t i = 0; i < m_radars.size(); ++i) {
+        const TrackTable& tracks = m_radars.site(i).tracks();
+        m_frameTrackIds[i].assign(tracks.missileIdData(), tracks.missileIdData() + tracks.size());
+    }
+}
+
+
+// --- Запуск по расписанию ---
+// Ракета, запущенная на тике, летит с его начала (launchTime).
+bool SimulationState::launchIfDue(float launchTime, const GameConfig& config) {
+    if (m_missilesLaunched >= m_maxMissiles || m_playerWon) return false;
+    if (m_scenario.isOpen()) return launchFromScenario();
+    if (!m_launchQueue.empty()) return launchScheduled(config);
+    // Пришло время следующего ОБЩЕГО запуска (момент считается от предыдущего запуска).
+    if (m_clockNs < m_nextLaunchAtNs) return false;
+    m_nextLaunchDelay = 2.0f + static_cast<float>(randomInt(40)) / 10.0f; // Генерируем новую случайную задержку в секундах (2.0 - 6.0).
+    m_nextLaunchAtNs = m_clockNs + secondsToClock(m_nextLaunchDelay);
+    if (m_launchers.empty()) return false;
+
+    int randomLauncherIndex = randomInt(static_cast<int>(m_launchers.size()));
+    size_t countBefore = m_missiles.size();
+    launchMissile(randomLauncherIndex, launchTime, Point{ 0.0f, 0.0f }, config.missile_speed); // Передаем случайный индекс пусковой.
+    return m_missiles.size() != countBefore;
+}
+
+
+// --- Запуск по расписаниям пусковых из конфигурации ---
+// За тик запускаются все ракеты, чей момент наступил, по порядку моментов (при равенстве - по индексу
+// пусковой). Ракета летит со своего момента по расписанию, а не с начала тика, поэтому налет не зависит
+// от шага.
+bool SimulationState::launchScheduled(const GameConfig& config) {
+    const size_t countBefore = m_missiles.size();
+    size_t sinceDrain = 0;
+    while (m_missilesLaunched < m_maxMissiles && m_launchQueue.front().atNs <= m_clockNs) {
+        std::pop_heap(m_launchQueue.begin(), m_launchQueue.end(), std::greater<LaunchSlot>());
+        LaunchSlot& slot = m_launchQueue.back();
+        launchMissile(static_cast<int>(slot.launcher), clockToSeconds(slot.atNs), Point{ 0.0f, 0.0f }, config.missile_speed);
+        slot.atNs += drawLaunchInterval(slot.launcher);
+        std::push_heap(m_launchQueue.begin(), m_launchQueue.end(), std::greater<LaunchSlot>());
+        drainBurst(sinceDrain);
+    }
+    return m_missiles.size() != countBefore;
+}
+
+// --- Запуск по сценарию (config.scenario) ---
+// Записи идут по времени: за тик - все наступившие, каждая копируется из отображенного файла (страницы
+// подгружает ОС), без разбора текста и выделения памяти. Цель и скорость ракеты - из записи.
+bool SimulationState::launchFromScenario() {
+    const size_t countBefore = m_missiles.size();
+    const uint64_t launches = m_scenario.launchCount();
+    size_t sinceDrain = 0;
+    while (m_missilesLaunched < m_maxMissiles && m_scenarioNext < launches) {
+        scenario::ScenarioLaunch launch = m_scenario.launch(m_scenarioNext);
+        if (launch.timeNs > m_clockNs) break;
+        ++m_scenarioNext;
+        if (launch.launcher >= m_launchers.size()) {
+            --m_maxMissiles; // Запись с несуществующей пусковой пропускается: налет без нее
+            continue;
         }
+        launchMissile(static_cast<int>(launch.launcher), clockToSeconds(launch.timeNs), Point{ launch.targetX, launch.targetY }, launch.speed);
+        drainBurst(sinceDrain);
     }
+    return m_missiles.size() != countBefore;
+}
+
+// Залп за один тик может быть длиннее кольца MissileLog: записи переносятся, пока их не затерли.
+void SimulationState::drainBurst(size_t& sinceDrain) {
+    if (++sinceDrain < m_missileLog.capacity() / 2) return;
+    drainLog();
+    sinceDrain = 0;
+}
+
+int64_t SimulationState::nextLaunchAtNs() const {
+    if (m_scenario.isOpen()) {
+        return m_scenarioNext < m_scenario.launchCount() ? m_scenario.launch(m_scenarioNext).timeNs : std::numeric_limits<int64_t>::max();
+    }
+    return m_launchQueue.empty() ? m_nextLaunchAtNs : m_launchQueue.front().atNs;
+}
+
+int64_t SimulationState::drawLaunchInterval(uint32_t launcher) {
+    const LaunchInterval& interval = m_launchIntervals[launcher];
+    int64_t ns = interval.minNs + static_cast<int64_t>(static_cast<double>(interval.spanNs) * m_rng.uniform01());
+    return ns > 0 ? ns : 1; // Интервал короче наносекунды - запуски на каждой наносекунде
+}
 
-    m_radar.updateMissileSnapshot(activeSnapshot, m_gameTime); // Обновляем снимок в радаре.
 
+// --- Пропуск пустых тиков (EventEngine) ---
+// Все, что меняется на тике без событий, - функции игрового времени: позиции ракет (MissileStore::update),
+// угол луча (Radar::beamAngleAt), момент запуска (nextLaunchAtNs()). Поэтому достаточно сдвинуть часы
+// и луч: следующий update() получит ровно то же состояние, что и после count обычных тиков.
+// Снимок ракет для отрисовки не пересобирается (режим без окна).
+void SimulationState::skipTicks(uint64_t count, float dt) {
+    if (count == 0 || m_isGameOver || m_radarMode != RadarMode::Lockstep) return;
+    m_recorder.tick(dt, count);
+    m_clockNs += secondsToClock(dt) * static_cast<int64_t>(count);
+    m_tick += count;
+    m_gameTime = clockToSeconds(m_clockNs);
+    // Проверка поражения на следующем тике берет сектор последнего шага луча: от угла предпоследнего
+    // пропущенного тика до угла последнего, ровно как после обычных тиков.
+    if (count >= 2) m_radars.sweepTo(clockToSeconds(m_clockNs - secondsToClock(dt)), dt);
+    m_radars.sweepTo(m_gameTime, dt);
 }
 
 
-void SimulationState::launchMissile(int launcherIndex) {
+// --- Кадр для отрисовки ---
+void SimulationState::fillRenderFrame(RenderFrame& frame) const {
+    frame.tick = m_tick;
+    frame.gameTime = m_gameTime;
+    frame.radars.resize(m_radars.size());
+    for (size_t i = 0; i < m_radars.size(); ++i) {
+        frame.radars[i].pos = m_radars.site(i).getPos();
+        frame.radars[i].state = m_radars.site(i).getState();
+        frame.radars[i].previousBeamAngle = frame.radars[i].state.currentAngle; // Начало интервала задает SimulationThread
+        if (m_radarMode == RadarMode::Pipelined) {
+            frame.radars[i].trackIds = m_frameTrackIds[i]; // Таблицы может писать стадия радара
+        }
+        else {
+            const TrackTable& tracks = m_radars.site(i).tracks();
+            frame.radars[i].trackIds.assign(tracks.missileIdData(), tracks.missileIdData() + tracks.size());
+        }
+    }
+    frame.launchers.assign(m_launchers.begin(), m_launchers.end());
+    m_missiles.copyActiveTo(frame.missiles); // Только при показе кадра: update() массив Missile не собирает
+    frame.isGameOver = m_isGameOver;
+    frame.playerWon = m_playerWon;
+    frame.missilesLaunched = m_missilesLaunched;
+    frame.maxMissiles = m_maxMissiles;
+    frame.missilesDestroyed = m_missilesDestroyed;
+
+    // Последнее событие каждой из последних запущенных ракет (одно атомарное чтение индекса MissileLog на ракету).
+    int count = m_missilesLaunched < RenderFrame::RECENT_MISSILES ? m_missilesLaunched : static_cast<int>(RenderFrame::RECENT_MISSILES);
+    frame.recentEvents.resize(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        frame.recentEvents[static_cast<size_t>(i)] = m_pMissileLog->getLastEntryForMissile(m_missilesLaunched - 1 - i);
+    }
+}
+
+
+// --- Перенос событий из кольца MissileLog: контрольная сумма и бинарный журнал ---
+// Стоимость пропорциональна числу новых записей; в файл они уходят пакетами (см. JournalWriter).
+void SimulationState::drainLog() {
+    m_missileLog.consume(m_logCursor, [this](const MissileLogEntry& entry) {
+        m_eventDigest = missileLogDigest(m_eventDigest, entry);
+        ++m_eventCount;
+        if (m_journal.isOpen()) m_journal.append(entry);
+    });
+}
+
+void SimulationState::finishGame() {
+    m_radars.park();
+    drainLog();
+    if (m_gameRunning) {
+        m_recorder.gameEnd(m_eventCount, m_eventDigest); // Итог игры для сверки при повторе.
+        m_gameRunning = false;
+    }
+    m_journal.close();
+}
+
+
+void SimulationState::launchMissile(int launcherIndex, float launchTime, Point target, float speed) {
 
     if (launcherIndex < 0 || static_cast<size_t>(launcherIndex) >= m_launchers.size()) {
         // Если индекс некорректный, выходим из метода без запуска.
@@ -137,9 +415,8 @@ void SimulationState::launchMissile(int launcherIndex) {
     Launcher& launcher = m_launchers[launcherIndex];
 
     int newMissileId = m_missilesLaunched++; 
-    Point targetPosition = { 0.0f, 0.0f };
-    // Получаем скорость полета ракеты из глобального объекта конфигурации.
-    float missileSpeed = g_config.missile_speed;
+    Point targetPosition = target;  // База (0,0) или цель из сценария
+    float missileSpeed = speed;     // missile_speed конфигурации или скорость из сценария
 
     // Создаем новый объект Missile в локальной переменной.
     // Конструктор по умолчанию инициализирует ракету как неактивную.
@@ -147,136 +424,345 @@ void SimulationState::launchMissile(int launcherIndex) {
     // Вызываем метод launch() объекта newMissile для ее полной инициализации для полета.
     // Передаем ID ракеты, ID пусковой, стартовую позицию (позиция выбранной пусковой установки),
     // целевую позицию и скорость.
-    newMissile.launch(newMissileId, launcher.launcherId, launcher.pos, targetPosition, missileSpeed);
+    newMissile.launch(newMissileId, launcher.launcherId, launcher.pos, targetPosition, missileSpeed, launchTime);
 
-    // --- Добавляем новую активированную ракету в список активных ракет ---
-    // m_activeMissiles - это std::vector<Missile>. push_back создает КОПИЮ объекта newMissile в векторе.
-    m_activeMissiles.push_back(newMissile);
+    // --- Добавляем новую активированную ракету в хранилище ---
+    // add() раскладывает поля newMissile по массивам MissileStore.
+    m_missiles.add(newMissile);
+    m_missileLog.indexMissile(newMissileId); // До записи "Запущена": индекс растет только в потоке симуляции
 
     // --- Логируем событие запуска ракеты ---
     // Проверяем, что указатель на объект журнала событий (MissileLog) действителен.
     if (m_pMissileLog) {
         // Добавляем запись в лог, используя метод addEntry() MissileLog.
-        // addEntry() является потокобезопасным внутри, используя g_cs.
-        // Передаем ID ракеты, ID запустившей пусковой, игровое время запуска и строку статуса.
-        m_pMissileLog->addEntry(newMissileId, launcher.launcherId, m_gameTime, L"Запущена"); // L"..." для wchar_t строк (в Unicode сборке).
-    }
-    if (m_pMissileLog) { // Проверяем указатель на лог.
-          std::wstringstream ss; // Создаем поток для форматирования строки лога.
-          // Форматируем детали: стартовая позиция, целевая позиция, скорость.
-          ss << L"Start=(" << launcher.pos.x << L"," << launcher.pos.y << L"), Target=(" << targetPosition.x << L"," << targetPosition.y << L"), Speed=" << missileSpeed;
-          // Добавляем форматированную строку в лог как статус.
-          m_pMissileLog->addEntry(newMissileId, launcher.launcherId, m_gameTime, ss.str()); 
-     }
+        // addEntry() потокобезопасен и не берет блокировок (кольцо MissileLog).
+        // Параметры запуска (старт, цель, скорость) идут числами; текст "Start=..., Target=..." строится только при показе.
+        MissileLogEntry entry = {};
+        entry.missileId = newMissileId;
+        entry.launcherId = launcher.launcherId;
+        entry.timestamp = m_gameTime;
+        entry.event = MissileEvent::Launched;
+        entry.data[0] = launcher.pos.x;
+        entry.data[1] = launcher.pos.y;
+        entry.data[2] = targetPosition.x;
+        entry.data[3] = targetPosition.y;
+        entry.data[4] = missileSpeed;
+        m_pMissileLog->addEntry(entry);
+    }
 
 } 
 
 
 
-void SimulationState::updateMissiles(float dt) {
-    
-    for (auto& missile : m_activeMissiles) {
-        // Проверяем флаг активности ракеты.
-        if (missile.isActive) {
-            missile.update(dt);
-        }
-        
-    }
+void SimulationState::updateMissiles() {
+    // Один векторизованный проход по массивам координат: позиции на текущее игровое время
+    // (неактивные ракеты имеют нулевую скорость и стоят на месте).
+    m_missiles.update(m_gameTime);
 } 
 
-void SimulationState::checkCollisionsAndIntercepts(const GameConfig& config) {
-    if (!m_radar.isOperational() || m_isGameOver) {
-        return;
+// Первая (по индексу хранилища, начиная с first) активная ракета в мертвой зоне: сравнение квадратов
+// расстояний по массивам x/y, без sqrt. Только чтение - в конвейере идет параллельно со стадией радара.
+long SimulationState::findDeadZoneHit(float deadZoneRadius, size_t first) const {
+    const float deadZoneRadiusSq = deadZoneRadius * deadZoneRadius;
+    const size_t missileCount = m_missiles.size();
+    for (size_t i = first; i < missileCount; ++i) {
+        if (m_missiles.isActive(i) && m_missiles.distanceSqToCenter(i) <= deadZoneRadiusSq) return static_cast<long>(i);
     }
-    int detectedMissileId = m_radar.getDetectedMissileId();
-    float engagementRadius = m_radar.getEngagementRadius(); // Радиус среднего ЖЕЛТОГО круга (Граница ЗОНЫ ПОРАЖЕНИЯ ПО ДИСТАНЦИИ).
-    float deadZoneRadius = m_radar.getDeadZoneRadius();     // Радиус внутреннего КРАСНОГО круга (Граница МЕРТВОЙ ЗОНЫ ПО ДИСТАНЦИИ).
+    return -1;
+}
 
+// deadZoneHit - findDeadZoneHit() на позициях этого тика. Его можно искать до проверки отслеживаемых целей:
+// основной радар выключает только ракету за пределами своей мертвой зоны; если первую ракету в зоне сбил
+// другой радар, следующая ищется после нее (до нее ракет в зоне не было).
+void SimulationState::checkCollisionsAndIntercepts(const GameConfig& config, long deadZoneHit, float dt) {
+    if (m_isGameOver) {
+        return;
+    }
+    // Цели радаров - по порядку позиций; одну ракету ведет не больше одного радара (см. RadarNetwork).
+    // Без огневых каналов каждый радар сразу решает по своим трекам; с каналами сначала измеряют все радары,
+    // затем одно назначение по всем целям и радарам.
+    m_siteStates.resize(m_radars.size());
+    for (size_t s = 0; s < m_radars.size(); ++s) {
+        Radar& radar = m_radars.site(s);
+        // Одна согласованная копия состояния радара (seqlock) вместо пяти отдельных чтений.
+        RadarState& radarState = m_siteStates[s];
+        radarState = radar.getState();
+        if (!radarState.isOperational) {
+            if (s == 0) return;
+            continue;
+        }
+        measureTracks(radar, radarState, dt);
+        if (m_fireChannels > 0) continue;
+        engageTracks(radar, radarState);
+        releaseTracks(radar, radarState);
+    }
+    if (m_fireChannels > 0) {
+        assignEngagements(config, dt);
+        for (size_t s = 0; s < m_radars.size(); ++s) {
+            if (m_siteStates[s].isOperational) releaseTracks(m_radars.site(s), m_siteStates[s]);
+        }
+    }
+    if (deadZoneHit >= 0 && !m_missiles.isActive(static_cast<size_t>(deadZoneHit))) {
+        deadZoneHit = findDeadZoneHit(m_radars.primary().getDeadZoneRadius(), static_cast<size_t>(deadZoneHit) + 1);
+    }
+    // Ракета в мертвой зоне - поражение базы.
+    if (deadZoneHit >= 0) {
+        size_t i = static_cast<size_t>(deadZoneHit);
 
-    float currentScanAngle = m_radar.getCurrentAngle();     // Текущий угол центра сканирующего луча (в радианах).
-    float beamWidth = m_radar.getBeamWidth();
-    if (detectedMissileId != -1) {
+        m_isGameOver = true;    // Устанавливаем флаг: игра окончена. (член класса SimulationState).
+        m_playerWon = false;
 
-        Missile* pTrackedMissile = nullptr;
-        for (auto& missile : m_activeMissiles) {
-            // Проверяем два условия: 1. Совпадает ли ID этой ракеты с ID отслеживаемой целью detectedMissileId. 2. Активна ли эта ракета ( isActive == true).
-            if (missile.id == detectedMissileId && missile.isActive) {
-                pTrackedMissile = &missile;  // Если оба условия истинны, мы нашли нужную ракету. Сохраняем указатель на этот объект в векторе.
-                break;
-            }
+        m_radars.setOperational(false);
+        if (m_pMissileLog) {
+            m_pMissileLog->addEntry(m_missiles.id(i), m_missiles.launcherId(i), m_gameTime, MissileEvent::RadarHit);
         }
-        if (pTrackedMissile) {
 
-            float missileDist = pTrackedMissile->getDistanceToCenter();
-            if (missileDist <= deadZoneRadius) {
+        m_missiles.deactivateAll(); // Все ракеты (активные и неактивные) становятся неактивными.
+    }
+}
 
-                if (m_pMissileLog) { 
-                    m_pMissileLog->addEntry(pTrackedMissile->id, pTrackedMissile->launcherId, m_gameTime, L"Потеряна (мертв.зона)"); // Русский текст L"..."
-                }
-                m_radar.clearDetectedMissile();  
-            }
 
-            else if (missileDist <= engagementRadius &&
-                Radar::isMissileInBeam(pTrackedMissile->pos, currentScanAngle, beamWidth))
-            {
 
-                pTrackedMissile->isActive = false;  // <<< ИСПРАВЛЕНИЕ: Используем оператор '->'. Устанавливаем флаг активности ракеты в false. Она больше не двигается и не рисуется как активная.
-                m_missilesDestroyed++;
-                if (m_pMissileLog) {
-                    m_pMissileLog->addEntry(pTrackedMissile->id, pTrackedMissile->launcherId, m_gameTime, L"Уничтожена"); // Русский текст L"..."
-                }
+// --- Треки одного радара: поражение в желтой зоне под лучом, потеря в мертвой зоне, обновление или сброс ---
+// Три прохода по таблице треков в порядке завязки:
+//   1) ракета трека и мертвая зона; проход луча через цель - измерение ее позиции (measureTracks);
+//   2) фильтр сопровождения по всем измеренным трекам одним пакетным проходом (TrackFilter.h, measureTracks);
+//   3) решения по оценкам фильтра (engageTracks или, с огневыми каналами, assignEngagements): цель под лучом,
+//      чья оценка в зоне поражения, сбивается; цель, которая по оценке скорости в зону поражения не войдет,
+//      отпускается; давно не виденная - сбрасывается.
+// Сброшенные треки удаляются одним уплотнением в конце (releaseTracks).
+// Мертвая зона дополнительной позиции - только ее слепое кольцо: цель теряется, база не поражается.
+
+// Прошел ли луч за свой последний шаг (от sweepStartAngle на sweepArc) через ракету, пока она была в кольце
+// обнаружения. Накрытый сектор проверяется против движения ракеты за тик (relative - конец тика, как
+// в Radar::findTargets), поэтому при крупном dt цель, пересекшая край луча или границу кольца за тик, не теряется.
+static bool beamPassed(const RadarState& radarState, Point relative, Point velocity, float dt) {
+    return sweptBeamHit(relative.x - velocity.x * dt, relative.y - velocity.y * dt, relative.x, relative.y,
+                        radarState.sweepStartAngle, radarState.sweepArc, radarState.beamWidth,
+                        radarState.deadZoneRadius, radarState.radar_range);
+}
 
-                m_radar.clearDetectedMissile();
-            }
+// Трек без прохода луча дольше COAST_REVOLUTIONS оборотов - цель вне кольца обнаружения, сбрасываем.
+static float coastTimeOf(const RadarState& radarState) {
+    return radarState.sweepSpeed > 0.0f
+        ? TrackTable::COAST_REVOLUTIONS * 2.0f * M_PI_F / radarState.sweepSpeed
+        : std::numeric_limits<float>::infinity();
+}
 
+void SimulationState::measureTracks(Radar& radar, const RadarState& radarState, float dt) {
+    float deadZoneRadius = radarState.deadZoneRadius;     // Радиус внутреннего КРАСНОГО круга (Граница МЕРТВОЙ ЗОНЫ ПО ДИСТАНЦИИ).
+    TrackTable& tracks = radar.tracks();
+
+    // Threaded: цель назначает поток радара (почтовый ящик detectedMissileId) - переносим ее в таблицу.
+    if (radarState.detectedMissileId != -1 && tracks.empty()) {
+        long index = m_missiles.findById(radarState.detectedMissileId);
+        if (index >= 0) {
+            Point relative = m_missiles.pos(static_cast<size_t>(index)) - radar.getPos();
+            tracks.add(radarState.detectedMissileId, m_missiles.launcherId(static_cast<size_t>(index)),
+                       radarState.detectionTime, relative.x, relative.y);
         }
         else {
+            radar.clearDetectedMissile();
+        }
+    }
+    if (tracks.empty()) return;
+
+    // 1) Измерения.
+    tracks.beginMeasurements();
+    for (size_t k = 0; k < tracks.size(); ++k) {
+        // Ищем ракету трека по ID (бинарный поиск в MissileStore) и проверяем, что она активна.
+        long trackedIndex = m_missiles.findById(tracks.missileId(k));
+        if (trackedIndex < 0 || !m_missiles.isActive(static_cast<size_t>(trackedIndex))) {
+            tracks.drop(k); // Место освобождается для поиска новой цели на следующем шаге.
+            continue;
+        }
+        size_t t = static_cast<size_t>(trackedIndex);
+        Point relative = m_missiles.pos(t) - radar.getPos(); // Координаты относительно этого радара
+        if (relative.length() <= deadZoneRadius) {
+            if (m_pMissileLog) {
+                m_pMissileLog->addEntry(m_missiles.id(t), m_missiles.launcherId(t), m_gameTime, MissileEvent::LostDeadZone);
+            }
+            tracks.drop(k);
+        }
+        else if (beamPassed(radarState, relative, m_missiles.velocity(t), dt)) {
+            tracks.measure(k, relative.x, relative.y);
+        }
+    }
+
+    // 2) Фильтр.
+    tracks.applyMeasurements(m_gameTime);
+}
 
-            m_radar.clearDetectedMissile(); // Радар становится свободен для поиска новой цели в следующем цикле Radar::run().
+// 3) Решения. Только на проходе луча (и сброс по времени без него): между проходами радар цель не видит.
+void SimulationState::engageTracks(Radar& radar, const RadarState& radarState) {
+    float engagementRadius = radarState.engagementRadius; // Радиус среднего ЖЕЛТОГО круга (Граница ЗОНЫ ПОРАЖЕНИЯ ПО ДИСТАНЦИИ).
+    TrackTable& tracks = radar.tracks();
+    const float coastTime = coastTimeOf(radarState);
+    const float engagementRadiusSq = engagementRadius * engagementRadius;
+
+    for (size_t k = 0; k < tracks.size(); ++k) {
+        if (tracks.isDropped(k)) continue;
+        if (!tracks.isMeasured(k)) {
+            if (m_gameTime - tracks.lastSeenTime(k) > coastTime) tracks.drop(k);
+            continue;
+        }
+        Point estimate = tracks.estimatedPos(k);
+        Point velocity = tracks.estimatedVelocity(k);
+        if (estimate.x * estimate.x + estimate.y * estimate.y <= engagementRadiusSq) {
+            destroyTrack(tracks, k);
+        }
+        else if (tracks.updates(k) > 0 && !Radar::canEngage(estimate.x, estimate.y, velocity.x, velocity.y, engagementRadius)) {
+            // Цель в зону поражения этого радара, по оценке скорости, не войдет (при обнаружении это проверено
+            // по снимку): радар отпускает ее без события, ее может взять другой.
+            tracks.drop(k);
         }
     }
-    for (auto& missile : m_activeMissiles) {
-        float missileDist = missile.getDistanceToCenter();
-        if (missile.isActive && missileDist <= deadZoneRadius) {
+}
 
-            m_isGameOver = true;    // Устанавливаем флаг: игра окончена. (член класса SimulationState).
-            m_playerWon = false;
+void SimulationState::releaseTracks(Radar& radar, const RadarState& radarState) {
+    TrackTable& tracks = radar.tracks();
+    size_t removed = tracks.removeDropped();
+    // Threaded: трек сброшен - поток радара снова ищет цель.
+    if (removed > 0 && tracks.empty() && radarState.detectedMissileId != -1) radar.clearDetectedMissile();
+}
 
-            m_radar.setOperational(false);
-            if (m_pMissileLog) {
-                m_pMissileLog->addEntry(missile.id, missile.launcherId, m_gameTime, L"Поражение радара!");
-            }
+void SimulationState::destroyTrack(TrackTable& tracks, size_t k) {
+    long t = m_missiles.findById(tracks.missileId(k));
+    m_missiles.deactivate(static_cast<size_t>(t)); // Ракета больше не двигается и не рисуется как активная.
+    m_missilesDestroyed++;
+    if (m_pMissileLog) {
+        m_pMissileLog->addEntry(tracks.missileId(k), tracks.launcherId(k), m_gameTime, MissileEvent::Destroyed);
+    }
+    tracks.drop(k);
+}
 
-            for (auto& other_missile : m_activeMissiles) { // Итерируем по ВСЕМ ракетам в списке (active и inactive).
-                other_missile.isActive = false;
-            }
 
+// --- Назначение огневых каналов (radar_fire_channels > 0) ---
+// Каждый тик - один цикл решения. Цели - живые треки всех радаров; у каждого радара m_fireChannels каналов,
+// канал ведет одну цель в цикле. Выигрыш пары (цель, радар s) - срочность цели минус время до ее входа
+// в зону поражения s по оценке трека (прямолинейный полет, Radar::timeToEngage); срочность - запас времени
+// до базы, ближняя к базе цель важнее. Пара недопустима, если s не работает или цель в его зону не войдет.
+// Назначенная цель сбивается, когда через нее проходит луч ее радара s (у ведущего радара - измерение трека,
+// у другого - проход его луча по истинному движению цели за тик) и оценка ее позиции в зоне поражения s. Цель без
+// допустимого радара отпускается, как в engageTracks(); без канала - ждет следующего цикла.
+static const float ASSIGNMENT_EPSILON = 1.0e-3f; // с: сумма выигрышей - не дальше целей * epsilon от оптимума
+
+void SimulationState::assignEngagements(const GameConfig& config, float dt) {
+    const size_t sites = m_radars.size();
+    m_threats.clear();
+    for (size_t s = 0; s < sites; ++s) {
+        if (!m_siteStates[s].isOperational) continue;
+        const TrackTable& tracks = m_radars.site(s).tracks();
+        for (size_t k = 0; k < tracks.size(); ++k) {
+            if (!tracks.isDropped(k)) m_threats.push_back({ tracks.missileId(k), static_cast<uint32_t>(s), static_cast<uint32_t>(k) });
+        }
+    }
+    std::sort(m_threats.begin(), m_threats.end(),
+              [](const EngagementThreat& a, const EngagementThreat& b) { return a.missileId < b.missileId; });
+
+    // Выигрыши. Срочность - от наибольшего времени полета (из угла поля), поэтому не зависит от набора целей
+    // и цены прошлого цикла остаются близки к равновесию.
+    const float horizon = 1.0f + config.distance_corner_center * std::sqrt(2.0f) / config.missile_speed;
+    const size_t threats = m_threats.size();
+    m_threatIds.resize(threats);
+    m_threatBenefit.resize(threats * sites);
+    for (size_t i = 0; i < threats; ++i) {
+        const EngagementThreat& threat = m_threats[i];
+        const TrackTable& tracks = m_radars.site(threat.site).tracks();
+        Point world = m_radars.site(threat.site).getPos() + tracks.predictedPos(threat.track, m_gameTime);
+        Point velocity = tracks.estimatedVelocity(threat.track);
+        bool velocityKnown = tracks.updates(threat.track) > 0; // До второго прохода луча скорость - только априорная
+        float urgency = horizon - world.length() / config.missile_speed;
+        m_threatIds[i] = threat.missileId;
+        for (size_t s = 0; s < sites; ++s) {
+            float& benefit = m_threatBenefit[i * sites + s];
+            benefit = -1.0f;
+            if (!m_siteStates[s].isOperational) continue;
+            Point relative = world - m_radars.site(s).getPos();
+            float radius = m_siteStates[s].engagementRadius;
+            float t = relative.x * relative.x + relative.y * relative.y <= radius * radius ? 0.0f
+                    : velocityKnown ? Radar::timeToEngage(relative.x, relative.y, velocity.x, velocity.y, radius)
+                    : std::numeric_limits<float>::infinity();
+            if (t < std::numeric_limits<float>::infinity()) benefit = std::max(urgency - t, 0.0f);
+        }
+    }
 
-            break;
+    if (threats == 0) return; // Решение прошлого цикла остается теплым стартом следующего
+    auto t0 = std::chrono::steady_clock::now();
+    m_engagements.solve(m_threatIds.data(), threats, m_threatBenefit.data(), ASSIGNMENT_EPSILON);
+    int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+    ++m_assignmentSolves;
+    m_assignmentNsTotal += ns;
+    if (ns > m_assignmentNsMax) m_assignmentNsMax = ns;
+
+    // Решения - по возрастанию ID цели.
+    for (size_t i = 0; i < threats; ++i) {
+        const EngagementThreat& threat = m_threats[i];
+        TrackTable& tracks = m_radars.site(threat.site).tracks();
+        const size_t k = threat.track;
+        const RadarState& trackerState = m_siteStates[threat.site];
+        int g = m_engagements.assignedGroup(i);
+        if (g >= 0) {
+            const size_t s = static_cast<size_t>(g);
+            Point world = m_radars.site(threat.site).getPos() + tracks.predictedPos(k, m_gameTime); // Измерен - оценка этого тика
+            Point relative = world - m_radars.site(s).getPos();
+            float radius = m_siteStates[s].engagementRadius;
+            bool illuminated;
+            if (s == threat.site) {
+                illuminated = tracks.isMeasured(k);
+            }
+            else {
+                long t = m_missiles.findById(threat.missileId);
+                illuminated = beamPassed(m_siteStates[s], m_missiles.pos(static_cast<size_t>(t)) - m_radars.site(s).getPos(),
+                                         m_missiles.velocity(static_cast<size_t>(t)), dt);
+            }
+            if (illuminated && relative.x * relative.x + relative.y * relative.y <= radius * radius) {
+                destroyTrack(tracks, k);
+                continue;
+            }
+        }
+        if (!tracks.isMeasured(k)) {
+            if (m_gameTime - tracks.lastSeenTime(k) > coastTimeOf(trackerState)) tracks.drop(k);
+        }
+        else if (tracks.updates(k) > 0) {
+            bool reachable = false;
+            for (size_t s = 0; s < sites && !reachable; ++s) reachable = m_threatBenefit[i * sites + s] >= 0.0f;
+            if (!reachable) tracks.drop(k); // Ни один радар цель не поразит - отпускаем без события
         }
     }
 }
 
 
 
-void SimulationState::checkGameOverConditions(const GameConfig& config) {
+// --- Промах ---
+// Цель сценария может лежать в стороне от базы: ракета на такой прямой не входит в мертвую зону и без этой
+// проверки летела бы вечно, а игра не кончалась бы победой. Пройдя точку цели, ракета выходит из игры.
+// Ракета к базе (0,0) проходит мертвую зону раньше своей точки цели, поэтому сюда не попадает.
+// Проверка после поражений и мертвой зоны: на одном тике они важнее промаха.
+void SimulationState::expireMissiles() {
+    if (m_isGameOver) return;
+    const size_t missileCount = m_missiles.size();
+    for (size_t i = 0; i < missileCount; ++i) {
+        if (!m_missiles.isActive(i) || m_gameTime < m_missiles.arrivalTime(i)) continue;
+        m_missiles.deactivate(i);
+        if (m_pMissileLog) {
+            m_pMissileLog->addEntry(m_missiles.id(i), m_missiles.launcherId(i), m_gameTime, MissileEvent::Missed);
+        }
+    }
+}
+
+void SimulationState::checkGameOverConditions(const GameConfig& /*config*/) {
     if (m_isGameOver) return; 
     if (m_missilesLaunched >= m_maxMissiles) { // Условие 1: Общее количество запущенных ракет достигло или превысило максимальное количество.
-        bool anyActiveMissilesLeft = false;
-        for (const auto& missile : m_activeMissiles) { // Итерируем по всем ракетам в списке. Используем const& т.к. не меняем ракеты при проверке.
-            if (missile.isActive) { // Проверяем флаг активности.
-                anyActiveMissilesLeft = true; // Найдена хотя бы одна активная ракета.
-                break;
-            }
-        }
+        bool anyActiveMissilesLeft = m_missiles.anyActive(); // Счетчик активных ведет MissileStore.
 
         if (!anyActiveMissilesLeft) {
            
             m_isGameOver = true;
             m_playerWon = true; 
-            m_radar.setOperational(false);
+            m_radars.setOperational(false);
             if (m_pMissileLog) { 
-                m_pMissileLog->addEntry(-1, -1, m_gameTime, L"ПОБЕДА!"); 
+                m_pMissileLog->addEntry(-1, -1, m_gameTime, MissileEvent::Victory);
             }
 
             
@@ -286,119 +772,5 @@ void SimulationState::checkGameOverConditions(const GameConfig& config) {
 
 }
 void SimulationState::cleanupInactiveMissiles() {
-    m_activeMissiles.erase( // Метод erase удаляет элементы вектора в заданном диапазоне.
-        std::remove_if(m_activeMissiles.begin(), m_activeMissiles.end(),
-           
-            [](const Missile& missile) { return !missile.isActive; } 
-        ),
-        m_activeMissiles.end()
-    );
-    
-}
-void SimulationState::draw(HDC hdc, const RECT* clientRect, const GameConfig& config) const {
-    int width = clientRect->right - clientRect->left;
-    int height = clientRect->bottom - clientRect->top;
-    int centerX = width / 2;
-    int centerY = height / 2;
-
-    // Для вывода (стаистики можно менять)
-    int detailStatsX = 10;
-    int detailStatsY = 300; 
-    int lineHeight = 18;    
-
-    SetTextColor(hdc, RGB(255, 255, 255)); 
-    SetBkMode(hdc, TRANSPARENT);
-    for (const auto& launcher : m_launchers) {
-        launcher.draw(hdc, centerX, centerY);
-    }
-    for (const auto& missile : m_activeMissiles) {
-        if (missile.isActive) {
-            missile.draw(hdc, centerX, centerY);
-        }
-    }
-
-    m_radar.draw(hdc, centerX, centerY);
-    SetTextColor(hdc, RGB(255, 255, 255)); // Белый цвет текста.
-    SetBkMode(hdc, TRANSPARENT); // Прозрачный фон.
-
-    // Форматируем и выводим строку статистики
-    std::wstringstream ss_stats;
-    ss_stats << L"Время: " << std::fixed << std::setprecision(1) << m_gameTime << L" c | ";
-    size_t activeMissileCount = m_activeMissiles.size();
-    ss_stats << L"Активно: " << activeMissileCount << L" | ";
-    ss_stats << L"Запущено: " << m_missilesLaunched << L"/" << m_maxMissiles << L" | ";
-    ss_stats << L"Уничтожено: " << m_missilesDestroyed;
-    TextOut(hdc, 10, 10, ss_stats.str().c_str(), static_cast<int>(ss_stats.str().length()));
-
-
-    size_t countToDisplay = 15;
-    if (countToDisplay > m_missilesLaunched) countToDisplay = m_missilesLaunched; // Не больше, чем запущено.
-
-    // Итерируем с конца по количеству последних ракет, которые хотим отобразить.
-    // Ракеты нумеруются от 0 до m_missilesLaunched - 1. ID = порядку запуска.
-    for (int i = 0; i < countToDisplay; ++i) {
-        // ID текущей ракеты в этой итерации: m_missilesLaunched - 1 - i
-        int currentMissileId = m_missilesLaunched - 1 - i;
-
-        // Получаем последнюю запись лога для этой ракеты (используем MissileLog метод).
-        // Этот метод должен быть потокобезопасен (он внутри захватывает CS).
-        MissileLogEntry lastEntry = m_pMissileLog->getLastEntryForMissile(currentMissileId); // Предполагает, что getLastEntryForMissile реализован в MissileLog.
-
-
-        // Форматируем строку статистики для текущей ракеты.
-        std::wstringstream ss_detail;
-        ss_detail << L"Ракета " << currentMissileId; // ID ракеты.
-        if (lastEntry.missileId != -1) { // Проверяем, что запись в логе была найдена для этого ID.
-            ss_detail << L" (П" << lastEntry.launcherId << L"): "; // ID пусковой.
-            ss_detail << lastEntry.status; // Статус ("Запущена", "Уничтожена", "Потеряна", etc.).
-            // Можно добавить время последнего события:
-            ss_detail << L" [" << std::fixed << std::setprecision(1) << lastEntry.timestamp << L"с]";
-        }
-        else {
-            ss_detail << L": Лог пуст или не найден."; 
-        }
-        std::wstring detailString = ss_detail.str(); // Получаем std::wstring.
-
-
-        // Выводим строку статистики для текущей ракеты.
-        TextOut(hdc, detailStatsX, detailStatsY, detailString.c_str(), static_cast<int>(detailString.length()));
-
-        detailStatsY += lineHeight; // Увеличиваем координату Y для следующей строки детализации.
-    }
-
-
-    if (m_isGameOver) {
-        HFONT hFont = CreateFont(48, 0, 0, 0, FW_BOLD, FALSE, FALSE, FALSE, DEFAULT_CHARSET, OUT_OUTLINE_PRECIS, CLIP_DEFAULT_PRECIS, CLEARTYPE_QUALITY, VARIABLE_PITCH, TEXT("Arial"));
-        
-        HFONT hOldFont_main; // Для восстановления после основного сообщения
-        HFONT hOldFont_restart;
-        std::wstring endMessage = m_playerWon ? L"ПОБЕДА!" : L"ПОРАЖЕНИЕ!";
-        std::wstring restartMsg = L"Нажмите 'Начать заново'";
-        SIZE textSize;
-        int textX; // Будут переиспользоваться для обоих сообщений
-        int textY;
-
-        hOldFont_main = (HFONT)SelectObject(hdc, hFont);
-
-        GetTextExtentPoint32(hdc, endMessage.c_str(), static_cast<int>(endMessage.length()), &textSize);
-        textX = centerX - textSize.cx / 2; 
-        textY = centerY - textSize.cy / 2 - 50; 
-
-        SetTextColor(hdc, m_playerWon ? RGB(0, 255, 0) : RGB(255, 0, 0));
-        TextOut(hdc, textX, textY, endMessage.c_str(), static_cast<int>(endMessage.length()));
-        SelectObject(hdc, hOldFont_main); // Восстанавливаем
-        DeleteObject(hFont);
-        HFONT hFontSmall = CreateFont(24, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE, DEFAULT_CHARSET, OUT_OUTLINE_PRECIS, CLIP_DEFAULT_PRECIS, CLEARTYPE_QUALITY, VARIABLE_PITCH, TEXT("Arial"));
-
-        hOldFont_restart = (HFONT)SelectObject(hdc, hFontSmall);
-        GetTextExtentPoint32(hdc, restartMsg.c_str(), static_cast<int>(restartMsg.length()), &textSize);
-        textX = centerX - textSize.cx / 2; 
-        textY = centerY + textSize.cy / 2; 
-
-        SetTextColor(hdc, RGB(200, 200, 200)); // Серый цвет.
-        TextOut(hdc, textX, textY, restartMsg.c_str(), static_cast<int>(restartMsg.length()));
-        SelectObject(hdc, hOldFont_restart); // Восстанавливаем шрифт, который был активен ДО выбора hFontSmall.
-        DeleteObject(hFontSmall);  
-    }
-
+    m_missiles.removeInactive(); // Стабильное уплотнение массивов: порядок (и сортировка по ID) сохраняется.
 }
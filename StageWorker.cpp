@@ -0,0 +1,125 @@
+#include "StageWorker.h"
+#include <system_error>
+#include <utility>
+
+StageWorker::StageWorker() :
+    m_posted(0),
+    m_done(0),
+    m_workerSleeping(false),
+    m_ownerSleeping(false),
+    m_stopThread(false)
+{
+}
+
+StageWorker::~StageWorker() {
+    stop();
+}
+
+void StageWorker::start(std::function<void()> job) {
+    stop();
+    m_job = std::move(job);
+    m_posted = 0;
+    m_done = 0;
+    m_stopThread = false;
+    m_thread = std::thread(&StageWorker::run, this);
+}
+
+void StageWorker::stop() {
+    if (!m_thread.joinable()) return;
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopThread = true;
+    }
+    m_wakeWorker.notify_one();
+    m_thread.join();
+}
+
+// Флаги "спит" и счетчики - seq_cst: сторона, которая засыпает, либо увидит новый счетчик в условии
+// ожидания, либо другая сторона увидит флаг и разбудит ее под мьютексом (пробуждение не теряется).
+void StageWorker::post() {
+    m_posted.fetch_add(1);
+    if (m_workerSleeping.load()) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_wakeWorker.notify_one();
+    }
+}
+
+void StageWorker::wait() {
+    const uint64_t target = m_posted.load(std::memory_order_relaxed);
+    for (int i = 0; i < SPIN_YIELDS; ++i) {
+        if (m_done.load(std::memory_order_acquire) == target) return;
+        std::this_thread::yield();
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_ownerSleeping = true;
+    m_wakeOwner.wait(lock, [&] { return m_done.load() == target; });
+    m_ownerSleeping = false;
+}
+
+void StageWorker::run() {
+    uint64_t seen = 0;
+    for (;;) {
+        bool ready = false;
+        for (int i = 0; i < SPIN_YIELDS && !ready; ++i) {
+            ready = m_posted.load(std::memory_order_acquire) != seen;
+            if (!ready) std::this_thread::yield();
+        }
+        if (!ready) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_workerSleeping = true;
+            m_wakeWorker.wait(lock, [&] { return m_stopThread.load() || m_posted.load() != seen; });
+            m_workerSleeping = false;
+            if (m_posted.load() == seen) return; // Остановка (вся отданная работа выполнена)
+        }
+
+        m_job();
+        ++seen;
+        m_done.store(seen);
+        if (m_ownerSleeping.load()) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_wakeOwner.notify_one();
+        }
+    }
+}
+
+
+StagePool::StagePool() :
+    m_invoke(nullptr),
+    m_context(nullptr),
+    m_count(0),
+    m_next(0)
+{
+}
+
+StagePool::~StagePool() {
+    stop();
+}
+
+void StagePool::start(int threads) {
+    size_t workers = threads > 1 ? static_cast<size_t>(threads - 1) : 0;
+    if (workers == m_workers.size()) return;
+    stop();
+    for (size_t w = 0; w < workers; ++w) {
+        std::unique_ptr<StageWorker> worker(new StageWorker());
+        try {
+            worker->start([this]() { drain(); });
+        }
+        catch (const std::system_error&) {
+            break; // Сколько потоков создалось, столькими и работаем (остальное делает вызывающий поток).
+        }
+        m_workers.push_back(std::move(worker));
+    }
+}
+
+void StagePool::stop() {
+    m_workers.clear(); // ~StageWorker останавливает поток
+}
+
+void StagePool::drain() {
+    for (;;) {
+        size_t i = m_next.fetch_add(1, std::memory_order_relaxed);
+        if (i >= m_count) return;
+        m_invoke(m_context, i);
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// --- Постоянный рабочий поток одной стадии конвейера ---
+// Владелец отдает работу post() и забирает результат wait(); между ними стадия выполняется
+// на другом ядре. Поток создается один раз и переиспользуется: на тик - два атомарных счетчика,
+// без создания потоков и без выделения памяти.
+//
+// Ожидание с обеих сторон сначала короткое (несколько уступок планировщику), затем - на условной
+// переменной: на частых тиках передача идет без системных вызовов, а простаивающий поток не грузит ядро.
+// Один владелец, один рабочий поток; post() снова - только после wait().
+class StageWorker {
+private:
+    enum { SPIN_YIELDS = 64 };
+
+    std::function<void()> m_job;
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeWorker;
+    std::condition_variable m_wakeOwner;
+    std::atomic<uint64_t> m_posted;
+    std::atomic<uint64_t> m_done;
+    std::atomic<bool> m_workerSleeping;
+    std::atomic<bool> m_ownerSleeping;
+    std::atomic<bool> m_stopThread;
+
+    void run();
+
+public:
+    StageWorker();
+    ~StageWorker();
+
+    StageWorker(const StageWorker&) = delete;
+    StageWorker& operator=(const StageWorker&) = delete;
+
+    // Запускает поток с заданной работой (если уже запущен - останавливает прежний).
+    void start(std::function<void()> job);
+    void stop();
+    bool isRunning() const { return m_thread.joinable(); }
+
+    void post();            // Выполнить работу один раз
+    void wait();            // Дождаться окончания последней отданной работы (сразу, если ее нет)
+    bool isPending() const { return m_done.load(std::memory_order_acquire) != m_posted.load(std::memory_order_relaxed); }
+};
+
+
+// --- Пул постоянных рабочих потоков для одного параллельного цикла на тик ---
+// run(count, task) вызывает task(i) для всех i из [0, count) на рабочих потоках и на вызывающем потоке
+// и возвращается, когда все вызовы закончены. Задания раздаются атомарным счетчиком; потоки создаются
+// один раз (start) и между вызовами ждут на StageWorker. Порядок вызовов не определен: task(i)
+// должен писать только в свои данные.
+class StagePool {
+private:
+    std::vector<std::unique_ptr<StageWorker>> m_workers;
+    void (*m_invoke)(void* context, size_t index);
+    void* m_context;
+    size_t m_count;
+    std::atomic<size_t> m_next;
+
+    void drain();
+
+public:
+    StagePool();
+    ~StagePool();
+
+    StagePool(const StagePool&) = delete;
+    StagePool& operator=(const StagePool&) = delete;
+
+    // threads - всего потоков вместе с вызывающим (рабочих создается threads - 1). Тот же размер - ничего не делает.
+    void start(int threads);
+    void stop();
+    int threadCount() const { return static_cast<int>(m_workers.size()) + 1; }
+
+    template <typename Task>
+    void run(size_t count, Task& task) {
+        if (m_workers.empty() || count < 2) {
+            for (size_t i = 0; i < count; ++i) task(i);
+            return;
+        }
+        m_invoke = [](void* context, size_t index) { (*static_cast<Task*>(context))(index); };
+        m_context = &task;
+        m_count = count;
+        m_next.store(0, std::memory_order_relaxed);
+        size_t helpers = count - 1 < m_workers.size() ? count - 1 : m_workers.size();
+        for (size_t w = 0; w < helpers; ++w) m_workers[w]->post();
+        drain();
+        for (size_t w = 0; w < helpers; ++w) m_workers[w]->wait();
+    }
+};
@@ -0,0 +1,234 @@
+// --- Перебор параметров GameConfig (безоконный, на всех ядрах) ---
+// Берет базовую конфигурацию из файла, строит декартово произведение значений перебираемых ключей
+// и для каждой точки прогоняет --games игр Монте-Карло (MonteCarlo.h). Все игры всех точек идут
+// в одну очередь одного пула потоков; файл конфигурации читается один раз, потоки радара не создаются.
+// Точки, не прошедшие GameConfig::validate() (например, radar_engagement_radius >= radar_range)
+// или с целым ключом вне пределов (GameConfig::setValue()), попадают в таблицу с valid=0 и не прогоняются.
+//
+// Использование:
+//   SweepRunner <radar_config.txt> --param ключ=значения [--param ...] [--games N] [--threads N] [--seed N]
+//               [--dt сек] [--max-time сек] [--out results.csv] [--engine tick|event]
+// Значения: "от:до:шаг" (включая "до"), список "a,b,c" или одно число; единицы как в файле (углы в градусах),
+// целые ключи (radar_track_capacity, radar_fire_channels, max_missiles) округляются.
+// Таблица (CSV) пишется в --out или в stdout; сводка прогона - в stderr (ключ=значение).
+#include "GameConfig.h"
+#include "MonteCarlo.h"
+#include "ScenarioFile.h"
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Больше точек перебора не строится: каждая точка - это --games игр и конфигурация в памяти.
+static const size_t MAX_SWEEP_POINTS = 1000000;
+
+struct SweepParam {
+    std::string key;
+    std::vector<float> values;
+};
+
+static void usage() {
+    std::fprintf(stderr,
+        "usage: SweepRunner <radar_config.txt> --param key=values [--param ...] [--games N] [--threads N] [--seed N]\n"
+        "                   [--dt sec] [--max-time sec] [--out results.csv] [--engine tick|event]\n"
+        "values: from:to:step | a,b,c | value (file units, angles in degrees)\n"
+        "keys:");
+    for (int i = 0; i < GameConfig::NUMERIC_KEY_COUNT; ++i) std::fprintf(stderr, " %s", GameConfig::NUMERIC_KEYS[i]);
+    std::fprintf(stderr, "\n");
+}
+
+static bool isNumericKey(const std::string& key) {
+    for (int i = 0; i < GameConfig::NUMERIC_KEY_COUNT; ++i) {
+        if (key == GameConfig::NUMERIC_KEYS[i]) return true;
+    }
+    return false;
+}
+
+// Число целиком, без хвоста ("abc", "1x" и пустая строка отвергаются); inf и nan - тоже.
+static bool parseNumber(const std::string& text, double& value) {
+    if (text.empty()) return false;
+    char* end = nullptr;
+    value = std::strtod(text.c_str(), &end);
+    return end == text.c_str() + text.size() && std::isfinite(value);
+}
+
+// "ключ=от:до:шаг" | "ключ=a,b,c" | "ключ=значение"
+static bool parseParam(const std::string& text, SweepParam& param) {
+    size_t eq = text.find('=');
+    if (eq == std::string::npos) return false;
+    param.key = text.substr(0, eq);
+    if (!isNumericKey(param.key)) return false;
+    std::string spec = text.substr(eq + 1);
+    param.values.clear();
+
+    size_t c1 = spec.find(':');
+    if (c1 != std::string::npos) {
+        size_t c2 = spec.find(':', c1 + 1);
+        if (c2 == std::string::npos) return false;
+        double from, to, step;
+        if (!parseNumber(spec.substr(0, c1), from) || !parseNumber(spec.substr(c1 + 1, c2 - c1 - 1), to) ||
+            !parseNumber(spec.substr(c2 + 1), step)) return false;
+        if (step <= 0.0 || to < from) return false;
+        // Число шагов считается заранее, чтобы накопленная ошибка не потеряла последнее значение.
+        double steps = std::floor((to - from) / step + 1e-6);
+        if (steps >= static_cast<double>(MAX_SWEEP_POINTS)) return false;
+        long long n = static_cast<long long>(steps) + 1;
+        for (long long i = 0; i < n; ++i) param.values.push_back(static_cast<float>(from + step * static_cast<double>(i)));
+    }
+    else {
+        size_t start = 0;
+        while (start <= spec.size()) {
+            size_t comma = spec.find(',', start);
+            std::string item = spec.substr(start, comma == std::string::npos ? std::string::npos : comma - start);
+            double value;
+            if (!parseNumber(item, value)) return false;
+            param.values.push_back(static_cast<float>(value));
+            if (comma == std::string::npos) break;
+            start = comma + 1;
+        }
+    }
+    return !param.values.empty();
+}
+
+int main(int argc, char* argv[]) {
+    std::setlocale(LC_ALL, ""); // Для вывода русских сообщений об ошибках конфигурации.
+
+    if (argc < 2) {
+        usage();
+        return 2;
+    }
+    std::string configPath = argv[1];
+    std::vector<SweepParam> params;
+    MonteCarloOptions options;
+    options.games = 200;
+    bool hasSeed = false;
+    const char* outPath = nullptr;
+
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--param") == 0 && i + 1 < argc) {
+            SweepParam param;
+            if (!parseParam(argv[++i], param)) {
+                std::fprintf(stderr, "bad --param '%s'\n", argv[i]);
+                usage();
+                return 2;
+            }
+            params.push_back(param);
+        }
+        else if (std::strcmp(argv[i], "--games") == 0 && i + 1 < argc) options.games = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) options.threads = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) { hasSeed = true; options.seed = std::strtoull(argv[++i], nullptr, 10); }
+        else if (std::strcmp(argv[i], "--dt") == 0 && i + 1 < argc) options.dt = static_cast<float>(std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--max-time") == 0 && i + 1 < argc) options.maxGameTime = static_cast<float>(std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) outPath = argv[++i];
+        else if (std::strcmp(argv[i], "--engine") == 0 && i + 1 < argc) {
+            const char* engine = argv[++i];
+            if (std::strcmp(engine, "event") != 0 && std::strcmp(engine, "tick") != 0) { usage(); return 2; }
+            options.eventDriven = std::strcmp(engine, "event") == 0;
+        }
+        else { usage(); return 2; }
+    }
+    if (params.empty() || options.games <= 0 || options.dt <= 0.0f) {
+        usage();
+        return 2;
+    }
+
+    GameConfig base;
+    if (!base.loadFromFile(configPath)) {
+        std::fwprintf(stderr, L"%ls\n", base.lastError.c_str());
+        return 1;
+    }
+    if (!base.scenario.empty()) {
+        ScenarioReader probe; // Неоткрывшийся сценарий SimulationState молча заменил бы расписанием
+        if (!probe.open(base.scenario)) {
+            std::fprintf(stderr, "%s\n", probe.lastError().c_str());
+            return 1;
+        }
+    }
+    if (!hasSeed) options.seed = Xoshiro256::entropySeed();
+
+    // --- Точки перебора: первый --param меняется медленнее всех ---
+    size_t pointCount = 1;
+    for (const SweepParam& p : params) {
+        if (p.values.size() > MAX_SWEEP_POINTS / pointCount) { // Проверка до умножения: size_t не переполнится
+            std::fprintf(stderr, "too many sweep points (max %zu)\n", MAX_SWEEP_POINTS);
+            return 2;
+        }
+        pointCount *= p.values.size();
+    }
+
+    std::vector<std::vector<float>> points(pointCount, std::vector<float>(params.size()));
+    std::vector<int> runIndex(pointCount, -1); // Номер конфигурации в прогоне, -1 - точка некорректна
+    std::vector<GameConfig> configs;
+    configs.reserve(pointCount);
+    for (size_t pt = 0; pt < pointCount; ++pt) {
+        GameConfig config = base;
+        bool accepted = true;
+        size_t rest = pt;
+        for (size_t k = params.size(); k-- > 0;) {
+            float value = params[k].values[rest % params[k].values.size()];
+            rest /= params[k].values.size();
+            points[pt][k] = value;
+            accepted = config.setValue(params[k].key, value) && accepted; // Целый ключ вне пределов - точка некорректна
+        }
+        if (accepted && config.validate()) {
+            runIndex[pt] = static_cast<int>(configs.size());
+            configs.push_back(config);
+        }
+    }
+
+    std::vector<MonteCarloSummary> summaries = runMonteCarloBatch(configs, options);
+
+    // --- Таблица результатов ---
+    std::FILE* out = stdout;
+    if (outPath) {
+        out = std::fopen(outPath, "w");
+        if (!out) {
+            std::fprintf(stderr, "cannot create '%s'\n", outPath);
+            return 1;
+        }
+    }
+    std::fprintf(out, "point");
+    for (const SweepParam& p : params) std::fprintf(out, ",%s", p.key.c_str());
+    std::fprintf(out, ",valid,games,wins,losses,timeouts,win_rate,win_rate_ci95,kill_ratio,"
+                      "time_to_loss_mean,time_to_loss_p05,time_to_loss_p50,time_to_loss_p95,time_to_win_p50\n");
+    int bestPoint = -1;
+    double bestWinRate = -1.0;
+    for (size_t pt = 0; pt < pointCount; ++pt) {
+        std::fprintf(out, "%llu", static_cast<unsigned long long>(pt));
+        for (float v : points[pt]) std::fprintf(out, ",%g", v);
+        if (runIndex[pt] < 0) {
+            std::fprintf(out, ",0,0,0,0,0,,,,,,,,\n");
+            continue;
+        }
+        const MonteCarloSummary& s = summaries[static_cast<size_t>(runIndex[pt])];
+        std::fprintf(out, ",1,%d,%d,%d,%d,%.4f,%.4f,%.4f,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+            s.games, s.wins, s.losses, s.timeouts, s.winRate, s.winRateCi95, s.killRatio,
+            s.timeToLoss.mean, s.timeToLoss.p05, s.timeToLoss.p50, s.timeToLoss.p95, s.timeToWin.p50);
+        if (s.winRate > bestWinRate) { bestWinRate = s.winRate; bestPoint = static_cast<int>(pt); }
+    }
+    if (out != stdout) std::fclose(out);
+
+    // --- Сводка прогона ---
+    long long games = 0, ticks = 0;
+    for (const MonteCarloSummary& s : summaries) { games += s.games; ticks += s.ticks; }
+    double wallSec = summaries.empty() ? 0.0 : summaries.front().wallSec;
+    std::fprintf(stderr, "config=%s\n", configPath.c_str());
+    std::fprintf(stderr, "seed=%llu\n", static_cast<unsigned long long>(options.seed));
+    std::fprintf(stderr, "points=%llu\n", static_cast<unsigned long long>(pointCount));
+    std::fprintf(stderr, "valid_points=%llu\n", static_cast<unsigned long long>(configs.size()));
+    std::fprintf(stderr, "games_per_point=%d\n", options.games);
+    std::fprintf(stderr, "engine=%s\n", options.eventDriven ? "event" : "tick");
+    std::fprintf(stderr, "threads=%d\n", summaries.empty() ? 0 : summaries.front().threads);
+    std::fprintf(stderr, "games=%lld\n", games);
+    std::fprintf(stderr, "wall_sec=%.3f\n", wallSec);
+    std::fprintf(stderr, "games_per_sec=%.1f\n", wallSec > 0.0 ? games / wallSec : 0.0);
+    std::fprintf(stderr, "ticks_per_sec=%.1f\n", wallSec > 0.0 ? ticks / wallSec : 0.0);
+    if (bestPoint >= 0) {
+        std::fprintf(stderr, "best_point=%d\n", bestPoint);
+        std::fprintf(stderr, "best_win_rate=%.4f\n", bestWinRate);
+    }
+    return 0;
+}
@@ -0,0 +1,146 @@
+// --- Бенчмарк фильтра сопровождения ---
+// Много целей летят прямо к радару в (0,0); радар с шагом 10 мс (100 Гц) вращает луч, цели под лучом
+// измеряются с шумом, и TrackTable уточняет их треки одним пакетным проходом trackFilterUpdate() за шаг.
+// Печатает время на шаг (обычный луч и худший случай - измерены все треки), сколько треков укладывается
+// в шаг 100 Гц на одном ядре, точность оценок против сырых измерений и расхождения SIMD-пути со скалярным.
+//
+// Использование: TrackBench [число треков] [число шагов] [СКО шума измерения, px]
+#include "TrackTable.h"
+#include "TrackFilter.h"
+#include "BeamKernel.h"
+#include "AlignedAllocator.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 50000;
+    int steps = argc > 2 ? std::atoi(argv[2]) : 1000;
+    float sigma = argc > 3 ? static_cast<float>(std::atof(argv[3])) : 2.0f;
+    if (n == 0 || steps <= 0 || !(sigma >= 0.0f)) {
+        std::fprintf(stderr, "usage: TrackBench [tracks] [steps] [noise sigma]\n");
+        return 2;
+    }
+
+    const float dt = 0.01f;                      // 100 Гц
+    const float sweepSpeed = DEG_TO_RAD(360.0f); // Параметры луча по умолчанию (GameConfig)
+    const float beamWidth = DEG_TO_RAD(10.0f);
+    const float range = 1.0e6f;                  // Кольцо не ограничивает: цели разбросаны далеко
+    TrackFilterParams params;
+    params.measurementVar = sigma * sigma;
+    params.processNoise = 1.0f;
+    params.initialVelocityVar = 160.0f * 160.0f;
+
+    // Цели: старт на кольце 2000..6000 px, скорость 20..80 px/s к центру.
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * M_PI_F);
+    std::uniform_real_distribution<float> radiusDist(2000.0f, 6000.0f);
+    std::uniform_real_distribution<float> speedDist(20.0f, 80.0f);
+    std::normal_distribution<float> noise(0.0f, sigma > 0.0f ? sigma : 1.0f);
+    AlignedVector<float> x0(n), y0(n), vx(n), vy(n), x(n), y(n);
+    for (size_t i = 0; i < n; ++i) {
+        float a = angleDist(rng), r = radiusDist(rng), v = speedDist(rng);
+        x0[i] = r * std::cos(a);
+        y0[i] = r * std::sin(a);
+        vx[i] = -v * std::cos(a);
+        vy[i] = -v * std::sin(a);
+    }
+
+    // Треки завязаны по первому (шумному) измерению в момент 0.
+    TrackTable tracks;
+    tracks.reset(n, params);
+    for (size_t i = 0; i < n; ++i) {
+        float nx = sigma > 0.0f ? noise(rng) : 0.0f;
+        float ny = sigma > 0.0f ? noise(rng) : 0.0f;
+        tracks.add(static_cast<int>(i), 0, 0.0f, x0[i] + nx, y0[i] + ny);
+    }
+    // Эталон - тот же фильтр по одному треку за вызов (скалярный путь).
+    AlignedVector<float> rx(n), ry(n), rvx(n, 0.0f), rvy(n, 0.0f), rp00(n, params.measurementVar), rp01(n, 0.0f),
+                         rp11(n, params.initialVelocityVar), rtime(n, 0.0f), zx(n), zy(n);
+    for (size_t i = 0; i < n; ++i) {
+        Point p = tracks.estimatedPos(i);
+        rx[i] = p.x;
+        ry[i] = p.y;
+    }
+    std::vector<uint32_t> one(1, ~0u);
+    std::vector<uint32_t> selected(n);
+
+    double tBeam = 0.0, tAll = 0.0;
+    uint64_t measuredBeam = 0;
+    double errFiltered = 0.0, errRaw = 0.0;
+    uint64_t errCount = 0;
+
+    using clock = std::chrono::steady_clock;
+    for (int step = 1; step <= steps; ++step) {
+        float t = step * dt;
+        for (size_t i = 0; i < n; ++i) {
+            x[i] = x0[i] + vx[i] * t;
+            y[i] = y0[i] + vy[i] * t;
+        }
+        // Цели под лучом за шаг - тем же ядром, что у радара.
+        BeamSector beam = BeamSector::makeSwept(sweepSpeed * (t - dt), sweepSpeed * dt, beamWidth, 0.0f, range);
+        size_t count = beamSelect(beam, x.data(), y.data(), n, selected.data());
+        for (size_t k = 0; k < count; ++k) {
+            size_t i = selected[k];
+            zx[i] = x[i] + (sigma > 0.0f ? noise(rng) : 0.0f);
+            zy[i] = y[i] + (sigma > 0.0f ? noise(rng) : 0.0f);
+        }
+
+        auto t0 = clock::now();
+        tracks.beginMeasurements();
+        for (size_t k = 0; k < count; ++k) tracks.measure(selected[k], zx[selected[k]], zy[selected[k]]);
+        tracks.applyMeasurements(t);
+        auto t1 = clock::now();
+        tBeam += std::chrono::duration<double>(t1 - t0).count();
+        measuredBeam += count;
+
+        for (size_t k = 0; k < count; ++k) {
+            size_t i = selected[k];
+            TrackFilterArrays ref = { &rx[i], &ry[i], &rvx[i], &rvy[i], &rp00[i], &rp01[i], &rp11[i], &rtime[i] };
+            trackFilterUpdate(params, ref, &zx[i], &zy[i], one.data(), 1, t);
+            if (tracks.updates(i) >= 5) {
+                Point e = tracks.estimatedPos(i);
+                errFiltered += (e.x - x[i]) * (e.x - x[i]) + (e.y - y[i]) * (e.y - y[i]);
+                errRaw += (zx[i] - x[i]) * (zx[i] - x[i]) + (zy[i] - y[i]) * (zy[i] - y[i]);
+                ++errCount;
+            }
+        }
+    }
+
+    // Худший случай: все треки измерены на каждом шаге (копия таблицы, чтобы не сбить сравнение с эталоном).
+    TrackTable worst = tracks;
+    const int worstSteps = steps < 100 ? steps : 100;
+    for (int step = 1; step <= worstSteps; ++step) {
+        float t = (steps + step) * dt;
+        auto t0 = clock::now();
+        worst.beginMeasurements();
+        for (size_t i = 0; i < n; ++i) worst.measure(i, x[i], y[i]);
+        worst.applyMeasurements(t);
+        auto t1 = clock::now();
+        tAll += std::chrono::duration<double>(t1 - t0).count();
+    }
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < n; ++i) {
+        Point e = tracks.estimatedPos(i);
+        Point v = tracks.estimatedVelocity(i);
+        if (std::memcmp(&e.x, &rx[i], sizeof(float)) || std::memcmp(&e.y, &ry[i], sizeof(float)) ||
+            std::memcmp(&v.x, &rvx[i], sizeof(float)) || std::memcmp(&v.y, &rvy[i], sizeof(float))) ++mismatches;
+    }
+
+    double beamStepNs = tBeam * 1e9 / steps;
+    double allStepNs = tAll * 1e9 / worstSteps;
+    std::printf("tracks=%zu steps=%d step_ms=%.0f noise_sigma=%.2f\n", n, steps, dt * 1000.0f, sigma);
+    std::printf("beam_step  us_per_step=%.2f measured_per_step=%.1f\n", beamStepNs * 1e-3, static_cast<double>(measuredBeam) / steps);
+    std::printf("all_step   us_per_step=%.2f ns_per_track=%.3f\n", allStepNs * 1e-3, allStepNs / n);
+    std::printf("tracks_per_100hz_step_all_measured=%.0f\n", 10.0e6 / (allStepNs / n));
+    if (errCount > 0) {
+        std::printf("rms_error_raw=%.3f rms_error_filtered=%.3f\n", std::sqrt(errRaw / errCount), std::sqrt(errFiltered / errCount));
+    }
+    std::printf("mismatches_vs_scalar=%zu\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
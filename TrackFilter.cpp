@@ -0,0 +1,115 @@
+#include "TrackFilter.h" // Включаем заголовок фильтра сопровождения
+
+// --- Выбор SIMD-набора на этапе компиляции (как в BeamKernel.cpp) ---
+#if defined(__AVX__)
+#include <immintrin.h>
+#define TRACK_FILTER_AVX 1
+#define TRACK_LANES 8
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TRACK_FILTER_SSE2 1
+#define TRACK_LANES 4
+#endif
+
+static const float THIRD = 1.0f / 3.0f;
+
+// --- Один трек (скалярный хвост и эталон для SIMD-пути) ---
+// Прогноз на dt = t - time:
+//     a00 = p00 + dt * (2 p01 + dt p11) + q dt^3 / 3,  a01 = p01 + dt p11 + q dt^2 / 2,  a11 = p11 + q dt;
+// уточнение: k0 = a00 / (a00 + r), k1 = a01 / (a00 + r), невязка - измерение минус прогноз позиции.
+static inline void updateOne(float q, float r, const TrackFilterArrays& s, size_t i, float zx, float zy, float t) {
+    float dt = t - s.time[i];
+    float dt2 = dt * dt;
+    float a00 = s.p00[i] + dt * (s.p01[i] + s.p01[i] + dt * s.p11[i]) + q * dt2 * dt * THIRD;
+    float a01 = s.p01[i] + dt * s.p11[i] + q * dt2 * 0.5f;
+    float a11 = s.p11[i] + q * dt;
+    float px = s.x[i] + s.vx[i] * dt;
+    float py = s.y[i] + s.vy[i] * dt;
+    float inv = 1.0f / (a00 + r);
+    float k0 = a00 * inv;
+    float k1 = a01 * inv;
+    float ix = zx - px;
+    float iy = zy - py;
+    float rInv = r * inv;
+    s.x[i] = px + k0 * ix;
+    s.y[i] = py + k0 * iy;
+    s.vx[i] = s.vx[i] + k1 * ix;
+    s.vy[i] = s.vy[i] + k1 * iy;
+    s.p00[i] = a00 * rInv;
+    s.p01[i] = a01 * rInv;
+    s.p11[i] = a11 - k1 * a01;
+    s.time[i] = t;
+}
+
+#if defined(TRACK_FILTER_AVX)
+typedef __m256 Lane;
+static inline Lane load(const float* p) { return _mm256_loadu_ps(p); }
+static inline void store(float* p, Lane v) { _mm256_storeu_ps(p, v); }
+static inline Lane set1(float v) { return _mm256_set1_ps(v); }
+static inline Lane add(Lane a, Lane b) { return _mm256_add_ps(a, b); }
+static inline Lane sub(Lane a, Lane b) { return _mm256_sub_ps(a, b); }
+static inline Lane mul(Lane a, Lane b) { return _mm256_mul_ps(a, b); }
+static inline Lane div(Lane a, Lane b) { return _mm256_div_ps(a, b); }
+static inline Lane loadMask(const uint32_t* p) { return _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))); }
+static inline int anyLane(Lane m) { return _mm256_movemask_ps(m); }
+static inline Lane select(Lane m, Lane yes, Lane no) { return _mm256_blendv_ps(no, yes, m); }
+#elif defined(TRACK_FILTER_SSE2)
+typedef __m128 Lane;
+static inline Lane load(const float* p) { return _mm_loadu_ps(p); }
+static inline void store(float* p, Lane v) { _mm_storeu_ps(p, v); }
+static inline Lane set1(float v) { return _mm_set1_ps(v); }
+static inline Lane add(Lane a, Lane b) { return _mm_add_ps(a, b); }
+static inline Lane sub(Lane a, Lane b) { return _mm_sub_ps(a, b); }
+static inline Lane mul(Lane a, Lane b) { return _mm_mul_ps(a, b); }
+static inline Lane div(Lane a, Lane b) { return _mm_div_ps(a, b); }
+static inline Lane loadMask(const uint32_t* p) { return _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+static inline int anyLane(Lane m) { return _mm_movemask_ps(m); }
+static inline Lane select(Lane m, Lane yes, Lane no) { return _mm_or_ps(_mm_and_ps(m, yes), _mm_andnot_ps(m, no)); }
+#endif
+
+// --- Пакетное обновление ---
+// SIMD-путь ждет в measured маски 0 / ~0u (так их пишет TrackTable::measure); скалярный - любое ненулевое.
+void trackFilterUpdate(const TrackFilterParams& params, const TrackFilterArrays& s,
+                       const float* zx, const float* zy, const uint32_t* measured, size_t n, float t) {
+    const float q = params.processNoise;
+    const float r = params.measurementVar;
+    size_t i = 0;
+#if defined(TRACK_LANES)
+    const Lane vq = set1(q), vr = set1(r), vt = set1(t), one = set1(1.0f), half = set1(0.5f), third = set1(THIRD);
+    for (; i + TRACK_LANES <= n; i += TRACK_LANES) {
+        Lane m = loadMask(measured + i);
+        if (!anyLane(m)) continue; // Луч прошел через малую долю треков: большинство групп пропускается целиком
+
+        Lane time = load(s.time + i);
+        Lane p00 = load(s.p00 + i), p01 = load(s.p01 + i), p11 = load(s.p11 + i);
+        Lane x = load(s.x + i), y = load(s.y + i), vx = load(s.vx + i), vy = load(s.vy + i);
+
+        Lane dt = sub(vt, time);
+        Lane dt2 = mul(dt, dt);
+        Lane a00 = add(add(p00, mul(dt, add(add(p01, p01), mul(dt, p11)))), mul(mul(mul(vq, dt2), dt), third));
+        Lane a01 = add(add(p01, mul(dt, p11)), mul(mul(vq, dt2), half));
+        Lane a11 = add(p11, mul(vq, dt));
+        Lane px = add(x, mul(vx, dt));
+        Lane py = add(y, mul(vy, dt));
+        Lane inv = div(one, add(a00, vr));
+        Lane k0 = mul(a00, inv);
+        Lane k1 = mul(a01, inv);
+        Lane ix = sub(load(zx + i), px);
+        Lane iy = sub(load(zy + i), py);
+        Lane rInv = mul(vr, inv);
+
+        store(s.x + i, select(m, add(px, mul(k0, ix)), x));
+        store(s.y + i, select(m, add(py, mul(k0, iy)), y));
+        store(s.vx + i, select(m, add(vx, mul(k1, ix)), vx));
+        store(s.vy + i, select(m, add(vy, mul(k1, iy)), vy));
+        store(s.p00 + i, select(m, mul(a00, rInv), p00));
+        store(s.p01 + i, select(m, mul(a01, rInv), p01));
+        store(s.p11 + i, select(m, sub(a11, mul(k1, a01)), p11));
+        store(s.time + i, select(m, vt, time));
+    }
+#endif
+    // Скалярный хвост (или весь массив без SIMD).
+    for (; i < n; ++i) {
+        if (measured[i]) updateOne(q, r, s, i, zx[i], zy[i], t);
+    }
+}
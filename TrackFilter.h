@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// --- Фильтр сопровождения: фильтр Калмана с постоянной скоростью по каждой оси ---
+// Состояние трека - оценка позиции (x, y) и скорости (vx, vy) на момент time. Модель по каждой оси:
+//     x(t + dt) = x(t) + v * dt,  ускорение - белый шум спектральной плотности processNoise;
+//     измерение - позиция с дисперсией measurementVar.
+// Оси независимы, а модель, шум и моменты измерений у них общие, поэтому ковариация у обеих осей одна и та же:
+// на трек хранится одна симметричная матрица 2x2 (p00 - позиция, p01, p11 - скорость), три числа вместо восьми.
+// Прогноз на момент t между измерениями - x + vx * (t - time) (см. TrackTable::predictedPos); сама оценка
+// меняется только при измерении, поэтому пропуск тиков (EventEngine) на нее не влияет.
+// При постоянных параметрах коэффициенты усиления сходятся к установившимся - это фильтр альфа-бета.
+struct TrackFilterParams {
+    float measurementVar;     // Дисперсия измерения позиции, px^2 (track_measurement_sigma^2)
+    float processNoise;       // Спектральная плотность шума ускорения, px^2/s^3 (track_process_noise)
+    float initialVelocityVar; // Дисперсия скорости при завязке трека, (px/s)^2
+};
+
+// Массивы состояния треков (структура массивов, см. TrackTable). Для SIMD-пути желательно выравнивание на 32.
+struct TrackFilterArrays {
+    float* x;
+    float* y;
+    float* vx;
+    float* vy;
+    float* p00;
+    float* p01;
+    float* p11;
+    float* time;
+};
+
+// --- Пакетное обновление: один проход по n трекам (AVX / SSE2 / скалярно) ---
+// Треки с measured[i] != 0 прогнозируются на момент t и уточняются измерением (zx[i], zy[i]); остальные
+// не меняются (вычисляются, но не записываются - без ветвлений внутри группы). SIMD-путь совпадает
+// со скалярным побитно: те же операции в том же порядке, деление - точное.
+void trackFilterUpdate(const TrackFilterParams& params, const TrackFilterArrays& tracks,
+                       const float* zx, const float* zy, const uint32_t* measured, size_t n, float t);
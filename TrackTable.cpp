@@ -0,0 +1,143 @@
+#include "TrackTable.h"
+
+TrackTable::TrackTable() :
+    m_filter(),
+    m_count(0),
+    m_droppedCount(0),
+    m_measuredCount(0)
+{
+}
+
+// Перезапуск игры с той же емкостью массивы не перевыделяет: места за m_count add() заполняет целиком.
+void TrackTable::reset(size_t capacity, const TrackFilterParams& filter) {
+    m_filter = filter;
+    if (capacity == this->capacity()) {
+        clear();
+        return;
+    }
+    m_missileId.assign(capacity, -1);
+    m_launcherId.assign(capacity, -1);
+    m_initTime.assign(capacity, 0.0f);
+    m_lastSeenTime.assign(capacity, 0.0f);
+    m_x.assign(capacity, 0.0f);
+    m_y.assign(capacity, 0.0f);
+    m_vx.assign(capacity, 0.0f);
+    m_vy.assign(capacity, 0.0f);
+    m_p00.assign(capacity, 0.0f);
+    m_p01.assign(capacity, 0.0f);
+    m_p11.assign(capacity, 0.0f);
+    m_zx.assign(capacity, 0.0f);
+    m_zy.assign(capacity, 0.0f);
+    m_measured.assign(capacity, 0);
+    m_updates.assign(capacity, 0);
+    m_dropped.assign(capacity, 0);
+    m_count = 0;
+    m_droppedCount = 0;
+    m_measuredCount = 0;
+}
+
+void TrackTable::clear() {
+    for (size_t i = 0; i < m_count; ++i) {
+        m_dropped[i] = 0;
+        m_measured[i] = 0;
+    }
+    m_count = 0;
+    m_droppedCount = 0;
+    m_measuredCount = 0;
+}
+
+// Первое измерение: позиция известна с точностью измерения, скорость - только априорно (нулевая оценка
+// с большой дисперсией), поэтому второй проход луча почти целиком определяет скорость.
+bool TrackTable::add(int missileId, int launcherId, float time, float x, float y) {
+    if (m_count == capacity()) return false;
+    size_t i = m_count++;
+    m_missileId[i] = missileId;
+    m_launcherId[i] = launcherId;
+    m_initTime[i] = time;
+    m_lastSeenTime[i] = time;
+    m_x[i] = x;
+    m_y[i] = y;
+    m_vx[i] = 0.0f;
+    m_vy[i] = 0.0f;
+    m_p00[i] = m_filter.measurementVar;
+    m_p01[i] = 0.0f;
+    m_p11[i] = m_filter.initialVelocityVar;
+    m_measured[i] = 0;
+    m_updates[i] = 0;
+    m_dropped[i] = 0;
+    return true;
+}
+
+void TrackTable::beginMeasurements() {
+    if (m_measuredCount == 0) return;
+    for (size_t i = 0; i < m_count; ++i) m_measured[i] = 0;
+    m_measuredCount = 0;
+}
+
+void TrackTable::measure(size_t i, float x, float y) {
+    m_zx[i] = x;
+    m_zy[i] = y;
+    if (!m_measured[i]) ++m_measuredCount;
+    m_measured[i] = ~0u;
+}
+
+void TrackTable::applyMeasurements(float time) {
+    if (m_measuredCount == 0) return;
+    TrackFilterArrays arrays = { m_x.data(), m_y.data(), m_vx.data(), m_vy.data(),
+                                 m_p00.data(), m_p01.data(), m_p11.data(), m_lastSeenTime.data() };
+    trackFilterUpdate(m_filter, arrays, m_zx.data(), m_zy.data(), m_measured.data(), m_count, time);
+    for (size_t i = 0; i < m_count; ++i) m_updates[i] += m_measured[i] & 1u;
+}
+
+void TrackTable::drop(size_t i) {
+    if (m_dropped[i]) return;
+    m_dropped[i] = 1;
+    ++m_droppedCount;
+}
+
+// Стабильное уплотнение: порядок оставшихся треков (порядок завязки) сохраняется.
+// Отметки измерений переносятся вместе с треками - их читают до следующего beginMeasurements().
+size_t TrackTable::removeDropped() {
+    if (m_droppedCount == 0) return 0;
+    size_t w = 0;
+    size_t measuredCount = 0;
+    for (size_t r = 0; r < m_count; ++r) {
+        if (m_dropped[r]) continue;
+        if (w != r) {
+            m_missileId[w] = m_missileId[r];
+            m_launcherId[w] = m_launcherId[r];
+            m_initTime[w] = m_initTime[r];
+            m_lastSeenTime[w] = m_lastSeenTime[r];
+            m_x[w] = m_x[r];
+            m_y[w] = m_y[r];
+            m_vx[w] = m_vx[r];
+            m_vy[w] = m_vy[r];
+            m_p00[w] = m_p00[r];
+            m_p01[w] = m_p01[r];
+            m_p11[w] = m_p11[r];
+            m_zx[w] = m_zx[r];
+            m_zy[w] = m_zy[r];
+            m_measured[w] = m_measured[r];
+            m_updates[w] = m_updates[r];
+            m_dropped[w] = 0;
+        }
+        if (m_measured[w]) ++measuredCount;
+        ++w;
+    }
+    for (size_t i = w; i < m_count; ++i) {
+        m_dropped[i] = 0;
+        m_measured[i] = 0;
+    }
+    size_t removed = m_count - w;
+    m_count = w;
+    m_droppedCount = 0;
+    m_measuredCount = measuredCount;
+    return removed;
+}
+
+long TrackTable::find(int missileId) const {
+    for (size_t i = 0; i < m_count; ++i) {
+        if (m_missileId[i] == missileId) return static_cast<long>(i);
+    }
+    return -1;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "Point.h"
+#include "AlignedAllocator.h"
+#include "TrackFilter.h"
+
+// --- Таблица сопровождаемых целей одного радара (track-while-scan) ---
+// Радар ведет одновременно до capacity() целей, не прекращая обзор: пока есть свободные места, луч
+// берет новые цели (завязка трека), каждый проход луча через цель обновляет ее трек, а трек сбрасывается,
+// когда цель сбита, потеряна в мертвой зоне, в зону поражения уже не войдет или давно не видна.
+//
+// Хранение - "структура массивов" фиксированной емкости: массивы выделяются один раз в reset(),
+// за игру память не выделяется. Проверки всех треков за шаг (SimulationState) идут одним проходом
+// по массивам; сброшенные треки помечаются drop() и удаляются одним стабильным уплотнением
+// removeDropped(), поэтому порядок треков - порядок завязки, и события пишутся в одном и том же порядке.
+//
+// Каждый трек несет оценку фильтра сопровождения (TrackFilter.h): позицию и скорость на момент последнего
+// прохода луча и их ковариацию. Проход луча - это измерение: measure() запоминает его, applyMeasurements()
+// уточняет все измеренные треки одним пакетным проходом trackFilterUpdate().
+//
+// Таблицу меняют только шаг радара (завязка, RadarNetwork) и проверки SimulationState (обновление и сброс);
+// они никогда не идут одновременно (в конвейере проверки ждут стадию радара). Координаты - относительно радара.
+class TrackTable {
+private:
+    std::vector<int> m_missileId;
+    std::vector<int> m_launcherId;
+    std::vector<float> m_initTime;     // Игровое время завязки
+    AlignedVector<float> m_lastSeenTime; // Последний проход луча через цель (момент оценки фильтра)
+    AlignedVector<float> m_x;          // Оценка позиции на m_lastSeenTime
+    AlignedVector<float> m_y;
+    AlignedVector<float> m_vx;         // Оценка скорости
+    AlignedVector<float> m_vy;
+    AlignedVector<float> m_p00;        // Ковариация (общая для осей x и y)
+    AlignedVector<float> m_p01;
+    AlignedVector<float> m_p11;
+    AlignedVector<float> m_zx;         // Измерение этого шага (действительно, если m_measured)
+    AlignedVector<float> m_zy;
+    std::vector<uint32_t> m_measured;  // ~0u - луч прошел через цель на этом шаге (маска для SIMD)
+    std::vector<uint32_t> m_updates;   // Проходов луча после завязки
+    std::vector<uint8_t> m_dropped;
+    TrackFilterParams m_filter;
+    size_t m_count;
+    size_t m_droppedCount;
+    size_t m_measuredCount;
+
+public:
+    // Трек без прохода луча дольше стольких оборотов сбрасывается (цель вне кольца обнаружения).
+    enum { COAST_REVOLUTIONS = 2 };
+
+    TrackTable();
+
+    // Пустая таблица на capacity треков (массивы выделяются здесь) с параметрами фильтра.
+    void reset(size_t capacity, const TrackFilterParams& filter);
+    void clear();                 // Пустая таблица той же емкости
+    size_t size() const { return m_count; }
+    size_t capacity() const { return m_missileId.size(); }
+    size_t freeSlots() const { return capacity() - m_count; }
+    bool empty() const { return m_count == 0; }
+
+    // Завязка трека по первому измерению (скорость неизвестна); false - таблица полна.
+    bool add(int missileId, int launcherId, float time, float x, float y);
+
+    // --- Измерения одного шага ---
+    void beginMeasurements();                  // Сброс отметок прошлого шага
+    void measure(size_t i, float x, float y);  // Проход луча через цель трека i
+    void applyMeasurements(float time);        // Фильтр по всем измеренным трекам - один проход
+    bool isMeasured(size_t i) const { return m_measured[i] != 0; }
+
+    void drop(size_t i);                                 // Пометка; удаление - removeDropped()
+    size_t removeDropped();                              // Возвращает число удаленных
+    long find(int missileId) const;                      // Индекс трека или -1
+
+    // --- Доступ к треку по индексу ---
+    int missileId(size_t i) const { return m_missileId[i]; }
+    int launcherId(size_t i) const { return m_launcherId[i]; }
+    float initTime(size_t i) const { return m_initTime[i]; }
+    float lastSeenTime(size_t i) const { return m_lastSeenTime[i]; }
+    Point estimatedPos(size_t i) const { return { m_x[i], m_y[i] }; }   // Оценка на lastSeenTime()
+    Point estimatedVelocity(size_t i) const { return { m_vx[i], m_vy[i] }; }
+    // Прогноз позиции на момент time (прямолинейно от последней оценки).
+    Point predictedPos(size_t i, float time) const {
+        float dt = time - m_lastSeenTime[i];
+        return { m_x[i] + m_vx[i] * dt, m_y[i] + m_vy[i] * dt };
+    }
+    float positionVariance(size_t i) const { return m_p00[i]; }
+    uint32_t updates(size_t i) const { return m_updates[i]; }
+    bool isDropped(size_t i) const { return m_dropped[i] != 0; }
+    const int* missileIdData() const { return m_missileId.data(); }
+};
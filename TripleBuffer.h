@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// --- Тройной буфер без блокировок (один писатель, один читатель) ---
+// Писатель заполняет back() и публикует его publish() - одна атомарная операция exchange:
+// back() меняется местами со "средним" буфером. Читатель вызывает acquire(): если средний
+// буфер свежий, он меняется местами с front(). Ни одна сторона не ждет другую и ничего не копирует:
+// писатель никогда не трогает front(), читатель - back().
+//
+// В m_middle хранится индекс среднего буфера и бит FRESH ("опубликован и еще не прочитан").
+// Если писатель публикует быстрее, чем читатель забирает, непрочитанный кадр просто заменяется новым.
+template <typename T>
+class TripleBuffer {
+private:
+    enum : uint8_t { INDEX_MASK = 0x3, FRESH = 0x4 };
+
+    T m_slots[3];
+    std::atomic<uint8_t> m_middle; // Индекс среднего буфера | FRESH
+    uint8_t m_back;  // Только писатель
+    uint8_t m_front; // Только читатель
+
+public:
+    TripleBuffer() : m_middle(1), m_back(0), m_front(2) {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // --- Сторона писателя ---
+    T& back() { return m_slots[m_back]; }
+
+    // Публикует back(). Возвращает true, если предыдущий опубликованный кадр так и не был прочитан.
+    bool publish() {
+        uint8_t prev = m_middle.exchange(static_cast<uint8_t>(m_back | FRESH), std::memory_order_acq_rel);
+        m_back = prev & INDEX_MASK;
+        return (prev & FRESH) != 0;
+    }
+
+    // --- Сторона читателя ---
+    // Забирает последний опубликованный кадр, если он новее front(). Возвращает true, если кадр новый.
+    bool acquire() {
+        if ((m_middle.load(std::memory_order_relaxed) & FRESH) == 0) return false;
+        uint8_t prev = m_middle.exchange(m_front, std::memory_order_acq_rel);
+        m_front = prev & INDEX_MASK;
+        return true;
+    }
+    const T& front() const { return m_slots[m_front]; }
+
+    // Сброс в начальное состояние. Только когда ни писатель, ни читатель не работают (например, до старта потока).
+    template <typename F>
+    void resetEach(F&& f) {
+        for (T& slot : m_slots) f(slot);
+        m_middle.store(1, std::memory_order_relaxed);
+        m_back = 0;
+        m_front = 2;
+    }
+};
@@ -8,6 +8,7 @@
 #include <sstream>
 #include <iomanip>
 #include <cstdlib> 
+#include <chrono>
 
 #include "Point.h"
 #include "GameConfig.h"
@@ -15,20 +16,24 @@
 #include "Launcher.h"
 #include "Radar.h"
 #include "SimulationState.h"
+#include "SimulationThread.h"
+#include "RenderFrame.h"
 #include "MissileLog.h"
 
 // Глобальные константы и переменные
 const wchar_t CLASS_NAME[] = L"RadarSimWindowClass";
 const wchar_t WINDOW_TITLE[] = L"Radar Simulation";
-const UINT_PTR IDT_SIMULATION_TIMER = 1;
-const UINT TIMER_INTERVAL_MS = 30;
+const UINT_PTR IDT_RENDER_TIMER = 1;
+const UINT RENDER_INTERVAL_MS = 15;          // Частота перерисовки окна (не влияет на симуляцию)
+const float SIMULATION_STEP = 0.03f;         // Постоянный шаг симуляции, с (поток SimulationThread)
+const int SIMULATION_MAX_CATCH_UP_STEPS = 5; // Не больше стольких шагов подряд при догоне
 #define IDC_BUTTON_RESTART 101
 #define IDC_BUTTON_EXIT 102
 
 // Глобальные объекты
-CRITICAL_SECTION g_cs;
 SimulationState g_simulationState; // Определение глобального объекта
-// GameConfig g_config; // Определяется в GameConfig.cpp
+SimulationThread g_simulationThread(g_simulationState); // Шаги симуляции - в своем потоке, окно только рисует кадры
+GameConfig g_config;               // Конфигурация окна (radar_config.txt загружается в WM_CREATE)
 
 RECT g_windowedRect = { 0 }; // Сохраняем размеры и положение окна в оконном режиме
 bool g_isFullscreen = false;
@@ -39,10 +44,6 @@ ULONG_PTR gdiplusToken = 0;
 Gdiplus::Image* g_pImageBackground = nullptr;
 
 
-void GlobalCriticalSectionCleanup() {
-    DeleteCriticalSection(&g_cs);
-}
-
 LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam);
 void ToggleFullscreen(HWND hWnd)
 {
@@ -117,6 +118,7 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
     {
         // Загрузка конфигурации
         if (!g_config.loadFromFile("radar_config.txt")) {
+            MessageBox(hWnd, g_config.lastError.c_str(), L"Ошибка конфигурации", MB_OK | MB_ICONERROR);
             PostQuitMessage(1);
             return -1;
         }
@@ -128,12 +130,12 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
             delete g_pImageBackground; g_pImageBackground = nullptr;
         }
 
-        // Инициализация симуляции
-        g_simulationState.initialize(g_config, hWnd);
+        // Инициализация симуляции и запуск ее потока
+        g_simulationThread.start(g_config, SIMULATION_STEP, SIMULATION_MAX_CATCH_UP_STEPS);
 
-        // Установка таймера
-        if (SetTimer(hWnd, IDT_SIMULATION_TIMER, TIMER_INTERVAL_MS, NULL) == 0) {
-            MessageBox(hWnd, L"Не удалось создать таймер симуляции!", L"Ошибка", MB_OK | MB_ICONERROR);
+        // Установка таймера перерисовки
+        if (SetTimer(hWnd, IDT_RENDER_TIMER, RENDER_INTERVAL_MS, NULL) == 0) {
+            MessageBox(hWnd, L"Не удалось создать таймер отрисовки!", L"Ошибка", MB_OK | MB_ICONERROR);
             PostQuitMessage(1);
             return -1;
         }
@@ -175,9 +177,8 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
     break;
 
     case WM_TIMER:
-        if (wParam == IDT_SIMULATION_TIMER) {
-            float dt = TIMER_INTERVAL_MS / 1000.0f;
-            g_simulationState.update(dt, g_config);
+        // Симуляция идет в своем потоке; таймер только перерисовывает окно.
+        if (wParam == IDT_RENDER_TIMER) {
             InvalidateRect(hWnd, NULL, FALSE);
         }
         break;
@@ -188,7 +189,7 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
 
     case WM_COMMAND:
         if (LOWORD(wParam) == IDC_BUTTON_RESTART && HIWORD(wParam) == BN_CLICKED) {
-            g_simulationState.reset(g_config);
+            g_simulationThread.requestReset(); // Перезапуск выполнит поток симуляции
             EnableWindow(GetDlgItem(hWnd, IDC_BUTTON_RESTART), TRUE);
             InvalidateRect(hWnd, NULL, TRUE);
         }
@@ -225,9 +226,11 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
             }
         }
 
-        // Рисование симуляции
+        // Рисование симуляции: последний опубликованный кадр, интерполированный на текущий момент
         SetBkMode(hdcMem, TRANSPARENT);
-        g_simulationState.draw(hdcMem, &rcClient, g_config);
+        g_simulationThread.acquireFrame();
+        const RenderFrame& frame = g_simulationThread.frame();
+        frame.draw(hdcMem, &rcClient, frame.interpolationAlpha(std::chrono::steady_clock::now()));
 
         // Копирование буфера на экран
         BitBlt(hdc, 0, 0, winWidth, winHeight, hdcMem, 0, 0, SRCCOPY);
@@ -254,8 +257,9 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
     break;
 
     case WM_DESTROY:
-        KillTimer(hWnd, IDT_SIMULATION_TIMER);
-        g_simulationState.shutdown(); // Важно вызвать перед удалением g_cs
+        KillTimer(hWnd, IDT_RENDER_TIMER);
+        g_simulationThread.stop();    // Сначала поток симуляции, затем ее состояние
+        g_simulationState.shutdown(); // Останавливаем поток радара до выхода из цикла сообщений
         if (g_pImageBackground) {
             delete g_pImageBackground; g_pImageBackground = nullptr;
         }
@@ -272,11 +276,8 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
 int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     _In_ LPSTR lpCmdLine, _In_ int nShowCmd)
 {
-    InitializeCriticalSection(&g_cs);
-
     HRESULT hr = CoInitializeEx(NULL, COINIT_APARTMENTTHREADED);
     if (FAILED(hr)) {
-        // При сбое COM init, очистка CS все равно произойдет через atexit.
         MessageBox(NULL, L"Не удалось инициализировать COM!", L"Ошибка", MB_OK | MB_ICONERROR);
         return 1;
     }
@@ -288,7 +289,6 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         return 1;
     }
     gdiplusToken = gdiplusToken_local;
-    std::srand(static_cast<unsigned int>(std::time(0)));
     WNDCLASSEX wc = { };
     wc.cbSize = sizeof(WNDCLASSEX);       // Обязательно: размер структуры.
     wc.lpfnWndProc = WndProc;             // Указываем на НАШУ оконную процедуру обработчика сообщений.
@@ -306,13 +306,12 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         MessageBox(NULL, L"Не удалось создать окно!", L"Ошибка", MB_ICONERROR | MB_OK);
         return 1;
     }
-    g_simulationState.initialize(g_config, hWnd);
     ShowWindow(hWnd, nShowCmd);
     UpdateWindow(hWnd);
     ToggleFullscreen(hWnd);
 
-    if (SetTimer(hWnd, IDT_SIMULATION_TIMER, TIMER_INTERVAL_MS, NULL) == 0) {
-        MessageBox(NULL, L"Не удалось установить таймер симуляции!", L"Fatal Error", MB_OK | MB_ICONERROR);
+    if (SetTimer(hWnd, IDT_RENDER_TIMER, RENDER_INTERVAL_MS, NULL) == 0) {
+        MessageBox(NULL, L"Не удалось установить таймер отрисовки!", L"Fatal Error", MB_OK | MB_ICONERROR);
         DestroyWindow(hWnd); // Закрыть окно (вызовет WM_DESTROY).
         return 1; // Выход.
     }
@@ -326,7 +325,6 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
 
     Gdiplus::GdiplusShutdown(gdiplusToken); 
     CoUninitialize();                       
-    DeleteCriticalSection(&g_cs);
 
     return return_code;
 